@@ -0,0 +1,154 @@
+#ifndef REGISTER_BENCHMARK_H
+#define REGISTER_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace Farb
+{
+
+namespace Benchmarks
+{
+
+// keeps the optimizer from discarding a result we only computed to time it
+// this is a gcc extension that is also present in clang but not msvc
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// runs func iterations times and returns the average nanoseconds per call
+template<typename TFunc>
+double MeasureNanoseconds(int iterations, TFunc&& func)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+	{
+		func();
+	}
+	auto end = std::chrono::steady_clock::now();
+	std::chrono::duration<double, std::nano> elapsed = end - start;
+	return elapsed.count() / iterations;
+}
+
+static inline void farb_report(std::string sBenchmarkName, double nanoseconds)
+{
+	std::cout << "    " << std::setw(12) << std::fixed << std::setprecision(2)
+		<< nanoseconds << " ns -- " << sBenchmarkName << std::endl;
+}
+
+// for benchmarks that consume input, bytes is the size of one call's input
+static inline void farb_report_throughput(std::string sBenchmarkName, double nanoseconds, std::size_t bytes)
+{
+	double megabytesPerSecond = (bytes / (1024.0 * 1024.0)) / (nanoseconds / 1e9);
+	std::cout << "    " << std::setw(12) << std::fixed << std::setprecision(2)
+		<< nanoseconds << " ns -- " << std::setw(8) << megabytesPerSecond
+		<< " MB/s -- " << sBenchmarkName << std::endl;
+}
+
+// the time of every run on its own, so a slow tail shows up instead of being averaged away
+struct Samples
+{
+	std::vector<double> nanoseconds;
+
+	// nearest rank, fraction is in [0, 1]
+	double Percentile(double fraction) const
+	{
+		if (nanoseconds.empty()) return 0.0;
+		std::vector<double> sorted = nanoseconds;
+		std::sort(sorted.begin(), sorted.end());
+		std::size_t rank = static_cast<std::size_t>(std::ceil(fraction * sorted.size()));
+		return sorted[rank == 0 ? 0 : rank - 1];
+	}
+
+	double Median() const { return Percentile(0.5); }
+};
+
+// runs func once to warm caches and allocators, then times each of runs calls
+template<typename TFunc>
+Samples MeasureSamples(int runs, TFunc&& func)
+{
+	func();
+	Samples samples;
+	samples.nanoseconds.reserve(runs);
+	for (int i = 0; i < runs; ++i)
+	{
+		auto start = std::chrono::steady_clock::now();
+		func();
+		auto end = std::chrono::steady_clock::now();
+		samples.nanoseconds.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+	}
+	return samples;
+}
+
+// where farb_report_samples writes its rows, see OpenBenchmarkOutput
+inline std::ofstream& BenchmarkOutput()
+{
+	static std::ofstream output;
+	return output;
+}
+
+// tab separated with a header row, so scripts can compare runs from before and after a change
+// rates are computed from the median, and are 0 when a benchmark has no bytes or objects
+inline bool OpenBenchmarkOutput(const std::string& filePath)
+{
+	std::ofstream& output = BenchmarkOutput();
+	output.open(filePath, std::ios::trunc);
+	if (output.fail()) return false;
+	output << "benchmark\truns\tmedian_ns\tp99_ns\tmb_per_s\tobjects_per_s\n";
+	return true;
+}
+
+// bytes and objects are how many one run consumes or produces
+static inline void farb_report_samples(
+	std::string sBenchmarkName,
+	const Samples& samples,
+	std::size_t bytes,
+	std::size_t objects)
+{
+	double median = samples.Median();
+	double p99 = samples.Percentile(0.99);
+	double seconds = median / 1e9;
+	double megabytesPerSecond = seconds > 0.0 ? (bytes / (1024.0 * 1024.0)) / seconds : 0.0;
+	double objectsPerSecond = seconds > 0.0 ? objects / seconds : 0.0;
+	std::cout << "    " << std::setw(12) << std::fixed << std::setprecision(2)
+		<< median << " ns median -- " << std::setw(12) << p99 << " ns p99 -- "
+		<< std::setw(8) << megabytesPerSecond << " MB/s -- "
+		<< std::setw(12) << std::setprecision(0) << objectsPerSecond << " objects/s -- "
+		<< sBenchmarkName << std::endl;
+
+	std::ofstream& output = BenchmarkOutput();
+	if (!output.is_open()) return;
+	output << sBenchmarkName << '\t' << samples.nanoseconds.size()
+		<< std::fixed << std::setprecision(2)
+		<< '\t' << median << '\t' << p99
+		<< '\t' << megabytesPerSecond << '\t' << objectsPerSecond << '\n';
+}
+
+class IBenchmark
+{
+public:
+	virtual bool RunBenchmarks() const = 0;
+};
+
+template<typename ... TBenchmarks>
+bool Run()
+{
+	bool success = true;
+	((success &= TBenchmarks().RunBenchmarks()),...);
+	return success;
+}
+
+} // namespace Benchmarks
+
+} // namespace Farb
+
+#endif // REGISTER_BENCHMARK_H
@@ -0,0 +1,45 @@
+
+#include <iostream>
+#include <string>
+
+#include "./core/BenchmarkErrorOr.hpp"
+#include "./reflection/BenchmarkStructKeyLookup.hpp"
+#include "./reflection/BenchmarkReflectionWalk.hpp"
+#include "./reflection/BenchmarkReflectionPath.hpp"
+#include "./serialization/BenchmarkSerialize.hpp"
+#include "./serialization/BenchmarkBinary.hpp"
+#include "./serialization/BenchmarkDeserializeFile.hpp"
+#include "./serialization/BenchmarkDataFormats.hpp"
+#include "./serialization/BenchmarkDeserializationPlan.hpp"
+#include "./serialization/BenchmarkDeserializeThroughput.hpp"
+
+using namespace Farb::Benchmarks;
+
+// the first argument replaces the path of the results file
+int main(int argc, char** argv)
+{
+	std::cout << "Beginning Benchmarks" << std::endl;
+
+	const std::string outputPath = argc > 1 ? argv[1] : "./bench_output.txt";
+	if (!OpenBenchmarkOutput(outputPath))
+	{
+		std::cout << "Couldn't open " << outputPath << std::endl;
+		return 1;
+	}
+
+	bool success = Run<
+		BenchmarkErrorOr,
+		BenchmarkStructKeyLookup,
+		BenchmarkReflectionWalk,
+		BenchmarkReflectionPath,
+		BenchmarkSerialize,
+		BenchmarkBinary,
+		BenchmarkDeserializeFile,
+		BenchmarkDataFormats,
+		BenchmarkDeserializationPlan,
+		BenchmarkDeserializeThroughput>();
+
+	std::cout << "Results written to " << outputPath << std::endl;
+	if (success) return 0;
+	return 1;
+}
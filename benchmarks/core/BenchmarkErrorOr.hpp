@@ -0,0 +1,119 @@
+#ifndef BENCHMARK_ERROR_OR_HPP
+#define BENCHMARK_ERROR_OR_HPP
+
+#include <string>
+#include <utility>
+
+#include "../RegisterBenchmark.hpp"
+#include "../../src/core/Containers.hpp"
+#include "../../src/core/ErrorOr.hpp"
+#include "../../src/interface/TigrExtensions.h"
+#include "../../src/utils/CountAllocations.hpp"
+
+namespace Farb
+{
+
+namespace Benchmarks
+{
+
+// UIWindow::ComputeDimensions builds a Tree<Dimensions> like this, but needs a window
+struct CountedDimensions
+{
+	static inline std::size_t copies = 0;
+
+	UI::Dimensions dimensions;
+
+	CountedDimensions() = default;
+
+	CountedDimensions(const CountedDimensions& other)
+		: dimensions(other.dimensions)
+	{
+		++copies;
+	}
+
+	CountedDimensions(CountedDimensions&& other) = default;
+	CountedDimensions& operator=(CountedDimensions&& other) = default;
+
+	CountedDimensions& operator=(const CountedDimensions& other)
+	{
+		dimensions = other.dimensions;
+		++copies;
+		return *this;
+	}
+};
+
+// copyChildren pushes each child's tree into its parent by copy,
+// the way ComputeDimensions did before ErrorOr could be moved from
+template<bool copyChildren>
+ErrorOr<Tree<CountedDimensions> > ComputeCountedTree(int branching, int depth)
+{
+	Tree<CountedDimensions> tree;
+	tree.value.dimensions.width = depth;
+	if (depth == 0) return tree;
+	tree.children.reserve(branching);
+	for (int i = 0; i < branching; ++i)
+	{
+		auto child = CHECK_RETURN(ComputeCountedTree<copyChildren>(branching, depth - 1));
+		if constexpr (copyChildren)
+		{
+			tree.children.push_back(child);
+		}
+		else
+		{
+			tree.children.push_back(std::move(child));
+		}
+	}
+	return tree;
+}
+
+class BenchmarkErrorOr : public IBenchmark
+{
+public:
+	virtual bool RunBenchmarks() const override
+	{
+		std::cout << "ErrorOr" << std::endl;
+
+		constexpr int iterations = 20;
+		constexpr int branching = 4;
+		// 5461 nodes
+		constexpr int depth = 6;
+		bool success = true;
+
+		auto measure = [&](const std::string& name, auto compute)
+		{
+			CountedDimensions::copies = 0;
+			std::size_t allocations = CountAllocations([&]()
+			{
+				success &= !compute().IsError();
+			});
+			std::cout << "    " << name << ": " << CountedDimensions::copies << " copies, "
+				<< allocations << " allocations" << std::endl;
+
+			double nanoseconds = MeasureNanoseconds(iterations, [&]()
+			{
+				auto result = compute();
+				success &= !result.IsError();
+				DoNotOptimize(result.GetValue().children.data());
+			});
+			farb_report(name, nanoseconds);
+		};
+
+		measure("Tree 4 wide 6 deep, children copied", []()
+		{
+			return ComputeCountedTree<true>(branching, depth);
+		});
+		measure("Tree 4 wide 6 deep, children moved", []()
+		{
+			return ComputeCountedTree<false>(branching, depth);
+		});
+
+		std::cout << "    a tree of 5461 nodes and 1365 parents needs 1365 allocations" << std::endl;
+		return success;
+	}
+};
+
+} // namespace Benchmarks
+
+} // namespace Farb
+
+#endif // BENCHMARK_ERROR_OR_HPP
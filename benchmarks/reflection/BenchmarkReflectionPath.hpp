@@ -0,0 +1,91 @@
+#ifndef BENCHMARK_REFLECTION_PATH_HPP
+#define BENCHMARK_REFLECTION_PATH_HPP
+
+#include <string>
+
+#include "../RegisterBenchmark.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionPath.h"
+#include "../../src/interface/UINode.h"
+#include "../serialization/BenchmarkSerialize.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Benchmarks
+{
+
+class BenchmarkReflectionPath : public IBenchmark
+{
+public:
+	virtual bool RunBenchmarks() const override
+	{
+		std::cout << "Reflection Path" << std::endl;
+
+		constexpr int iterations = 200000;
+		UI::Node root;
+		MakeTextTree(root, 4, 3);
+
+		// the way tools reach a field today, one GetAtKey or GetAtIndex per step
+		// with keys written as literals, so every name is hashed again
+		bool success = true;
+		double chained = MeasureNanoseconds(iterations, [&]()
+		{
+			auto result = Reflect(root).GetAtKey("children");
+			if (!result.IsError()) result = result.GetValue().GetAtIndex(3);
+			if (!result.IsError()) result = result.GetValue().GetAtKey("children");
+			if (!result.IsError()) result = result.GetValue().GetAtIndex(2);
+			if (!result.IsError()) result = result.GetValue().GetAtKey("text");
+			if (!result.IsError()) result = result.GetValue().GetAtKey("size");
+			success &= !result.IsError();
+			DoNotOptimize(result.GetValue().location);
+		});
+		farb_report("children[3].children[2].text.size, chained GetAtKey", chained);
+
+		Path path;
+		success &= !Path::Compile<UI::Node>("children[3].children[2].text.size", path).IsError();
+		double compiled = MeasureNanoseconds(iterations, [&]()
+		{
+			UI::Scalar* size = path.Get<UI::Scalar>(root);
+			success &= size != nullptr;
+			DoNotOptimize(size);
+		});
+		farb_report("children[3].children[2].text.size, compiled Path", compiled);
+
+		double direct = MeasureNanoseconds(iterations, [&]()
+		{
+			UI::Scalar* size = &root.children[3].children[2].text.size;
+			DoNotOptimize(size);
+		});
+		farb_report("children[3].children[2].text.size, direct access", direct);
+
+		Path missing;
+		success &= !Path::Compile<UI::Node>("children[3].children[9].text.size", missing).IsError();
+		double chainedMissing = MeasureNanoseconds(iterations, [&]()
+		{
+			auto result = Reflect(root).GetAtKey("children");
+			if (!result.IsError()) result = result.GetValue().GetAtIndex(3);
+			if (!result.IsError()) result = result.GetValue().GetAtKey("children");
+			if (!result.IsError()) result = result.GetValue().GetAtIndex(9);
+			DoNotOptimize(result.IsError());
+		});
+		farb_report("missing index, chained GetAtKey", chainedMissing);
+
+		double compiledMissing = MeasureNanoseconds(iterations, [&]()
+		{
+			UI::Scalar* size = missing.Get<UI::Scalar>(root);
+			success &= size == nullptr;
+			DoNotOptimize(size);
+		});
+		farb_report("missing index, compiled Path", compiledMissing);
+
+		return success;
+	}
+};
+
+} // namespace Benchmarks
+
+} // namespace Farb
+
+#endif // BENCHMARK_REFLECTION_PATH_HPP
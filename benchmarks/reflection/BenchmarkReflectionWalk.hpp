@@ -0,0 +1,94 @@
+#ifndef BENCHMARK_REFLECTION_WALK_HPP
+#define BENCHMARK_REFLECTION_WALK_HPP
+
+#include <string>
+
+#include "../RegisterBenchmark.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionBasics.h"
+#include "../../src/reflection/ReflectionWrappers.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/Deserialization.h"
+#include "../../src/serialization/Serialization.h"
+#include "../serialization/BenchmarkSerialize.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Benchmarks
+{
+
+// discards everything, so only the cost of walking the reflected tree is measured
+class CountingWriter : public Writer
+{
+public:
+	std::size_t values = 0;
+
+	virtual void BeginObject() override { }
+	virtual void Key(std::string_view key) override { }
+	virtual void Key(const HString& key) override { }
+	virtual void EndObject() override { }
+	virtual void BeginArray(std::size_t size) override { }
+	virtual void EndArray() override { }
+	virtual void Bool(bool value) override { ++values; }
+	virtual void UInt(uint value) override { ++values; }
+	virtual void Int(int value) override { ++values; }
+	virtual void Float(float value) override { ++values; }
+	virtual void String(std::string_view value) override { ++values; }
+	virtual void Enum(const HString& name, int value) override { ++values; }
+
+	using Writer::Key;
+	using Writer::String;
+};
+
+class BenchmarkReflectionWalk : public IBenchmark
+{
+public:
+	virtual bool RunBenchmarks() const override
+	{
+		std::cout << "Reflection Walk" << std::endl;
+
+		constexpr int iterations = 50;
+		UI::Node root;
+		// 1 + 4 + 16 + 64 + 256 + 1024 nodes
+		MakeTextTree(root, 4, 5);
+
+		CountingWriter counter;
+		bool success = !Reflect(root).Serialize(counter).IsError();
+		std::cout << "    UI::Node tree of 1365 nodes has " << counter.values << " values" << std::endl;
+
+		double walk = MeasureNanoseconds(iterations, [&]()
+		{
+			CountingWriter writer;
+			success &= !Reflect(root).Serialize(writer).IsError();
+			DoNotOptimize(writer.values);
+		});
+		farb_report("UI::Node tree walk, no output", walk);
+
+		double toString = MeasureNanoseconds(iterations, [&]()
+		{
+			std::string result = ToString(root);
+			DoNotOptimize(result.data());
+		});
+		farb_report("UI::Node tree ToString", toString);
+
+		std::string json;
+		success &= SerializeString(Reflect(root), json);
+		double deserialize = MeasureNanoseconds(iterations, [&]()
+		{
+			UI::Node loaded;
+			success &= DeserializeString(json, Reflect(loaded));
+			DoNotOptimize(loaded.children.data());
+		});
+		farb_report("UI::Node tree DeserializeString", deserialize);
+
+		return success;
+	}
+};
+
+} // namespace Benchmarks
+
+} // namespace Farb
+
+#endif // BENCHMARK_REFLECTION_WALK_HPP
@@ -0,0 +1,98 @@
+#ifndef BENCHMARK_STRUCT_KEY_LOOKUP_HPP
+#define BENCHMARK_STRUCT_KEY_LOOKUP_HPP
+
+#include <vector>
+
+#include "../RegisterBenchmark.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionDefine.hpp"
+#include "../../src/interface/UINode.h"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Benchmarks
+{
+
+// the lookup TypeInfoStruct used before member tables, kept here as a baseline
+template<typename T>
+ErrorOr<ReflectionObject> LinearGetAtKey(const TypeInfoStruct<T>* typeInfo, byte* obj, HString name)
+{
+	for (const auto & member : typeInfo->Members())
+	{
+		if (member.name == name)
+		{
+			return member.Get(obj);
+		}
+	}
+	if (typeInfo->parentType != nullptr)
+	{
+		return typeInfo->parentType->GetAtKey(obj, name, DeserializationContext::ThreadDefault());
+	}
+	return Error(typeInfo->GetName() + " struct GetAtKey " + name + " failed.");
+}
+
+class BenchmarkStructKeyLookup : public IBenchmark
+{
+public:
+	virtual bool RunBenchmarks() const override
+	{
+		std::cout << "Struct Key Lookup" << std::endl;
+
+		constexpr int iterations = 200000;
+		UI::Node node;
+		auto reflect = Reflect(node);
+		auto typeInfo = static_cast<const TypeInfoStruct<UI::Node>*>(reflect.typeInfo);
+
+		// keys arrive interned from the parser
+		std::vector<HString> keys;
+		for (const auto & member : typeInfo->Members())
+		{
+			keys.push_back(HString(member.name.ToStdString()));
+		}
+
+		double linear = MeasureNanoseconds(iterations, [&]()
+		{
+			for (const auto & key : keys)
+			{
+				auto result = LinearGetAtKey(typeInfo, reflect.location, key);
+				DoNotOptimize(result.GetValue().location);
+			}
+		});
+		farb_report("UI::Node linear scan, all members", linear / keys.size());
+
+		double table = MeasureNanoseconds(iterations, [&]()
+		{
+			for (const auto & key : keys)
+			{
+				auto result = reflect.GetAtKey(key);
+				DoNotOptimize(result.GetValue().location);
+			}
+		});
+		farb_report("UI::Node member table, all members", table / keys.size());
+
+		HString last = keys.back();
+		linear = MeasureNanoseconds(iterations, [&]()
+		{
+			auto result = LinearGetAtKey(typeInfo, reflect.location, last);
+			DoNotOptimize(result.GetValue().location);
+		});
+		farb_report("UI::Node linear scan, last member", linear);
+
+		table = MeasureNanoseconds(iterations, [&]()
+		{
+			auto result = reflect.GetAtKey(last);
+			DoNotOptimize(result.GetValue().location);
+		});
+		farb_report("UI::Node member table, last member", table);
+
+		return true;
+	}
+};
+
+} // namespace Benchmarks
+
+} // namespace Farb
+
+#endif // BENCHMARK_STRUCT_KEY_LOOKUP_HPP
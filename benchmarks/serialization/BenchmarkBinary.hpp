@@ -0,0 +1,85 @@
+#ifndef BENCHMARK_BINARY_HPP
+#define BENCHMARK_BINARY_HPP
+
+#include <cstdio>
+#include <string>
+
+#include "../RegisterBenchmark.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionBasics.h"
+#include "../../src/reflection/ReflectionWrappers.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/BinarySerialization.h"
+#include "../../src/serialization/Deserialization.h"
+#include "../../src/serialization/Serialization.h"
+#include "BenchmarkSerialize.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Benchmarks
+{
+
+class BenchmarkBinary : public IBenchmark
+{
+public:
+	virtual bool RunBenchmarks() const override
+	{
+		std::cout << "Binary" << std::endl;
+
+		constexpr int iterations = 20;
+		const std::string jsonPath = "./bench_tree.json";
+		const std::string binaryPath = "./bench_tree.fbin";
+
+		UI::Node root;
+		MakeTextTree(root, 4, 5);
+
+		bool success = SerializeFile(Reflect(root), jsonPath);
+		success &= SerializeBinaryFile(Reflect(root), binaryPath);
+
+		std::string json;
+		std::string binary;
+		success &= SerializeString(Reflect(root), json);
+		success &= SerializeBinary(Reflect(root), binary);
+		std::cout << "    UI::Node tree of 1365 nodes is " << json.size()
+			<< " bytes of json, " << binary.size() << " bytes of binary" << std::endl;
+
+		double fromJson = MeasureNanoseconds(iterations, [&]()
+		{
+			UI::Node loaded;
+			success &= DeserializeFile(jsonPath, Reflect(loaded));
+			DoNotOptimize(loaded.children.data());
+		});
+		farb_report("UI::Node tree DeserializeFile", fromJson);
+
+		double fromBinary = MeasureNanoseconds(iterations, [&]()
+		{
+			UI::Node loaded;
+			success &= DeserializeBinaryFile(binaryPath, Reflect(loaded));
+			DoNotOptimize(loaded.children.data());
+		});
+		farb_report("UI::Node tree DeserializeBinaryFile", fromBinary);
+
+		double serializeBinary = MeasureNanoseconds(iterations, [&]()
+		{
+			binary.clear();
+			success &= SerializeBinary(Reflect(root), binary);
+			DoNotOptimize(binary.data());
+		});
+		farb_report("UI::Node tree SerializeBinary, reused buffer", serializeBinary);
+
+		std::cout << "    binary loads " << std::setprecision(2) << fromJson / fromBinary
+			<< "x faster" << std::endl;
+
+		std::remove(jsonPath.c_str());
+		std::remove(binaryPath.c_str());
+		return success;
+	}
+};
+
+} // namespace Benchmarks
+
+} // namespace Farb
+
+#endif // BENCHMARK_BINARY_HPP
@@ -0,0 +1,84 @@
+#ifndef BENCHMARK_DATA_FORMATS_HPP
+#define BENCHMARK_DATA_FORMATS_HPP
+
+#include <string>
+
+#include "../RegisterBenchmark.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionBasics.h"
+#include "../../src/reflection/ReflectionWrappers.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/DataFormats.h"
+#include "../../src/serialization/Deserialization.h"
+#include "BenchmarkSerialize.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Benchmarks
+{
+
+class BenchmarkDataFormats : public IBenchmark
+{
+public:
+	virtual bool RunBenchmarks() const override
+	{
+		std::cout << "Data Formats" << std::endl;
+
+		bool success = true;
+		// about the size of TestUITree.json, then a few MB
+		success &= RunTree(5, 20);
+		success &= RunTree(7, 3);
+		return success;
+	}
+
+private:
+	static bool RunTree(int depth, int iterations)
+	{
+		UI::Node root;
+		MakeTextTree(root, 4, depth);
+		bool success = true;
+		double jsonLoad = 0.0;
+
+		for (DataFormat format : {DataFormat::Json, DataFormat::Cbor, DataFormat::MessagePack, DataFormat::Ubjson})
+		{
+			std::string output;
+			success &= SerializeFormat(Reflect(root), format, output);
+			std::cout << "    depth " << depth << " tree is " << output.size()
+				<< " bytes of " << DataFormatName(format) << std::endl;
+
+			double serialize = MeasureNanoseconds(iterations, [&]()
+			{
+				output.clear();
+				success &= SerializeFormat(Reflect(root), format, output);
+				DoNotOptimize(output.data());
+			});
+			farb_report_throughput(std::string("SerializeFormat ") + DataFormatName(format), serialize, output.size());
+
+			double load = MeasureNanoseconds(iterations, [&]()
+			{
+				UI::Node loaded;
+				success &= DeserializeFormat(output, Reflect(loaded), format);
+				DoNotOptimize(loaded.children.data());
+			});
+			farb_report_throughput(std::string("DeserializeFormat ") + DataFormatName(format), load, output.size());
+			if (format == DataFormat::Json)
+			{
+				jsonLoad = load;
+			}
+			else
+			{
+				std::cout << "    " << DataFormatName(format) << " loads " << std::setprecision(2)
+					<< jsonLoad / load << "x as fast as json" << std::endl;
+			}
+		}
+		return success;
+	}
+};
+
+} // namespace Benchmarks
+
+} // namespace Farb
+
+#endif // BENCHMARK_DATA_FORMATS_HPP
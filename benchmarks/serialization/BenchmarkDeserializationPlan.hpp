@@ -0,0 +1,82 @@
+#ifndef BENCHMARK_DESERIALIZATION_PLAN_HPP
+#define BENCHMARK_DESERIALIZATION_PLAN_HPP
+
+#include <iomanip>
+#include <string>
+
+#include "../RegisterBenchmark.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionBasics.h"
+#include "../../src/reflection/ReflectionWrappers.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/Deserialization.h"
+#include "../../src/serialization/DeserializationPlan.h"
+#include "../../src/serialization/Serialization.h"
+#include "BenchmarkSerialize.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Benchmarks
+{
+
+class BenchmarkDeserializationPlan : public IBenchmark
+{
+public:
+	virtual bool RunBenchmarks() const override
+	{
+		std::cout << "Deserialization Plan" << std::endl;
+
+		constexpr int iterations = 20;
+		// a UI screen is small, so the cost is mostly per object rather than per byte
+		constexpr int screens = 100;
+
+		UI::Node screen;
+		MakeTextTree(screen, 3, 4);
+		std::string screenJson;
+		bool success = SerializeString(Reflect(screen), screenJson);
+
+		double compile = MeasureNanoseconds(1, [&]()
+		{
+			DeserializationPlan plan(GetTypeInfo<UI::Node>());
+			DoNotOptimize(&plan);
+		});
+		farb_report("UI::Node plan compile", compile);
+		const DeserializationPlan& plan = CompilePlan<UI::Node>();
+		std::cout << "    UI::Node plan has " << plan.NodeCount() << " nodes" << std::endl;
+
+		double dynamic = MeasureNanoseconds(iterations, [&]()
+		{
+			for (int i = 0; i < screens; ++i)
+			{
+				UI::Node loaded;
+				success &= DeserializeString(screenJson, Reflect(loaded));
+				DoNotOptimize(loaded.children.data());
+			}
+		});
+		farb_report_throughput("100 UI screens, dynamic", dynamic, screenJson.size() * screens);
+
+		double planned = MeasureNanoseconds(iterations, [&]()
+		{
+			for (int i = 0; i < screens; ++i)
+			{
+				UI::Node loaded;
+				success &= DeserializeString(screenJson, Reflect(loaded), CompilePlan<UI::Node>());
+				DoNotOptimize(loaded.children.data());
+			}
+		});
+		farb_report_throughput("100 UI screens, plan", planned, screenJson.size() * screens);
+
+		std::cout << "    plan is " << std::setprecision(2) << dynamic / planned
+			<< "x as fast for UI screens" << std::endl;
+
+		return success;
+	}
+};
+
+} // namespace Benchmarks
+
+} // namespace Farb
+
+#endif // BENCHMARK_DESERIALIZATION_PLAN_HPP
@@ -0,0 +1,110 @@
+#ifndef BENCHMARK_DESERIALIZE_FILE_HPP
+#define BENCHMARK_DESERIALIZE_FILE_HPP
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "../RegisterBenchmark.hpp"
+#include "../../lib/json/json.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionBasics.h"
+#include "../../src/reflection/ReflectionWrappers.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/Deserialization.h"
+#include "../../src/serialization/DeserializationPlan.h"
+#include "../../src/serialization/Serialization.h"
+#include "../../src/utils/MappedFile.h"
+#include "BenchmarkSerialize.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Benchmarks
+{
+
+class BenchmarkDeserializeFile : public IBenchmark
+{
+public:
+	virtual bool RunBenchmarks() const override
+	{
+		std::cout << "Deserialize File" << std::endl;
+
+		using json = nlohmann::json;
+		constexpr int iterations = 10;
+		const std::string jsonPath = "./bench_large_tree.json";
+
+		UI::Node root;
+		// 21845 nodes, about 12MB of pretty printed json
+		MakeTextTree(root, 4, 7);
+		bool success = SerializeFile(Reflect(root), jsonPath);
+
+		MappedFile sizeCheck;
+		success &= sizeCheck.Open(jsonPath);
+		const std::size_t bytes = sizeCheck.Size();
+		sizeCheck.Close();
+		std::cout << "    UI::Node tree of 21845 nodes is " << bytes << " bytes" << std::endl;
+
+		// the cost of getting characters to the parser, with nothing built from them
+		double streamed = MeasureNanoseconds(iterations, [&]()
+		{
+			std::ifstream inputFile(jsonPath);
+			success &= json::accept(inputFile);
+		});
+		farb_report_throughput("json accept, ifstream", streamed, bytes);
+
+		double mapped = MeasureNanoseconds(iterations, [&]()
+		{
+			MappedFile file;
+			success &= file.Open(jsonPath);
+			success &= json::accept(nlohmann::detail::input_adapter(file.Data(), file.Size()));
+		});
+		farb_report_throughput("json accept, MappedFile", mapped, bytes);
+
+		double deserialize = MeasureNanoseconds(iterations, [&]()
+		{
+			UI::Node loaded;
+			success &= DeserializeFile(jsonPath, Reflect(loaded));
+			DoNotOptimize(loaded.children.data());
+		});
+		farb_report_throughput("UI::Node tree DeserializeFile", deserialize, bytes);
+
+		double planned = MeasureNanoseconds(iterations, [&]()
+		{
+			UI::Node loaded;
+			success &= DeserializeFile(jsonPath, Reflect(loaded), CompilePlan<UI::Node>());
+			DoNotOptimize(loaded.children.data());
+		});
+		farb_report_throughput("UI::Node tree DeserializeFile with plan", planned, bytes);
+
+		// what a frame loop would do, a slice of the file per call
+		double session = MeasureNanoseconds(iterations, [&]()
+		{
+			MappedFile file;
+			success &= file.Open(jsonPath);
+			UI::Node loaded;
+			DeserializationSession loading(Reflect(loaded));
+			constexpr std::size_t chunkSize = 64 * 1024;
+			for (std::size_t i = 0; i < file.Size(); i += chunkSize)
+			{
+				success &= loading.Feed(file.View().substr(i, chunkSize));
+			}
+			success &= loading.Finish();
+			DoNotOptimize(loaded.children.data());
+		});
+		farb_report_throughput("UI::Node tree DeserializationSession, 64KB chunks", session, bytes);
+
+		std::cout << "    mapped input is " << std::setprecision(2) << streamed / mapped
+			<< "x faster to scan" << std::endl;
+
+		std::remove(jsonPath.c_str());
+		return success;
+	}
+};
+
+} // namespace Benchmarks
+
+} // namespace Farb
+
+#endif // BENCHMARK_DESERIALIZE_FILE_HPP
@@ -0,0 +1,172 @@
+#ifndef BENCHMARK_DESERIALIZE_THROUGHPUT_HPP
+#define BENCHMARK_DESERIALIZE_THROUGHPUT_HPP
+
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../RegisterBenchmark.hpp"
+#include "../../src/core/Containers.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionBasics.h"
+#include "../../src/reflection/ReflectionContainers.hpp"
+#include "../../src/reflection/ReflectionStatic.hpp"
+#include "../../src/reflection/ReflectionWrappers.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/Deserialization.h"
+#include "../../src/serialization/Serialization.h"
+#include "BenchmarkSerialize.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Benchmarks
+{
+
+// the value type of a wide table, a few members of each kind the parser handles
+struct BenchmarkItem
+{
+	std::string label;
+	int count;
+	float weight;
+	std::vector<int> ids;
+
+	BenchmarkItem()
+		: label()
+		, count(0)
+		, weight(0.0f)
+		, ids()
+	{ }
+
+	static constexpr auto GetStaticMembers()
+	{
+		return std::make_tuple(
+			MakeStaticMember("label", &BenchmarkItem::label),
+			MakeStaticMember("count", &BenchmarkItem::count),
+			MakeStaticMember("weight", &BenchmarkItem::weight),
+			MakeStaticMember("ids", &BenchmarkItem::ids));
+	}
+
+	static TypeInfo* GetStaticTypeInfo()
+	{
+		static auto typeInfo = MakeStaticTypeInfoStruct<BenchmarkItem>("BenchmarkItem");
+		return &typeInfo;
+	}
+};
+
+inline std::size_t MakeIntTree(Tree<int>& tree, int branching, int depth)
+{
+	tree.value = depth * 1000 + branching;
+	if (depth == 0) return 1;
+	std::size_t count = 1;
+	tree.children.resize(branching);
+	for (auto & child : tree.children)
+	{
+		count += MakeIntTree(child, branching, depth - 1);
+	}
+	return count;
+}
+
+// deserializes value's json from a string and from a file, and converts it with ToString
+// objects is how many structs, elements or entries value holds, for objects/s
+template<typename T>
+bool BenchmarkInput(const std::string& name, const T& value, std::size_t objects)
+{
+	constexpr int runs = 30;
+	const std::string filePath = "./bench_throughput.json";
+
+	std::string json;
+	bool success = SerializeString(Reflect(const_cast<T&>(value)), json);
+	// compact like the string, so both read the same bytes
+	success &= SerializeFile(Reflect(const_cast<T&>(value)), filePath, JsonWriter::Mode::Compact);
+	std::cout << "    " << name << " is " << json.size() << " bytes, "
+		<< objects << " objects" << std::endl;
+
+	// a round trip has to reproduce the input, or the numbers mean nothing
+	T check;
+	success &= DeserializeString(json, Reflect(check));
+	success &= Equal(check, value);
+
+	Samples fromString = MeasureSamples(runs, [&]()
+	{
+		T loaded;
+		success &= DeserializeString(json, Reflect(loaded));
+		DoNotOptimize(&loaded);
+	});
+	farb_report_samples(name + " DeserializeString", fromString, json.size(), objects);
+
+	Samples fromFile = MeasureSamples(runs, [&]()
+	{
+		T loaded;
+		success &= DeserializeFile(filePath, Reflect(loaded));
+		DoNotOptimize(&loaded);
+	});
+	farb_report_samples(name + " DeserializeFile", fromFile, json.size(), objects);
+
+	std::size_t textSize = 0;
+	Samples toString = MeasureSamples(runs, [&]()
+	{
+		std::string text = ToString(value);
+		textSize = text.size();
+		DoNotOptimize(text.data());
+	});
+	farb_report_samples(name + " ToString", toString, textSize, objects);
+
+	std::remove(filePath.c_str());
+	return success;
+}
+
+// synthetic inputs shaped like what the engine loads, every parser or reflection change
+// should show up here, compare bench_output.txt from before and after
+class BenchmarkDeserializeThroughput : public IBenchmark
+{
+public:
+	virtual bool RunBenchmarks() const override
+	{
+		std::cout << "Deserialize Throughput" << std::endl;
+
+		UI::Node wideTree;
+		// 5461 nodes
+		MakeTextTree(wideTree, 4, 6);
+		bool success = BenchmarkInput("UI::Node tree 4 wide 6 deep", wideTree, 5461);
+
+		// deeper than the parser keeps its stack inline, and than any screen we ship
+		UI::Node deepTree;
+		MakeTextTree(deepTree, 1, 500);
+		success &= BenchmarkInput("UI::Node chain 500 deep", deepTree, 501);
+
+		std::vector<int> ints(1000000);
+		for (int i = 0; i < static_cast<int>(ints.size()); ++i)
+		{
+			// a spread of magnitudes and signs, so number lengths vary like real data
+			int magnitude = static_cast<int>((static_cast<long long>(i) * 7919) % (1 << (i % 24 + 1)));
+			ints[i] = i % 2 == 0 ? magnitude : -magnitude;
+		}
+		success &= BenchmarkInput("std::vector<int> of 1000000", ints, ints.size());
+
+		std::unordered_map<HString, BenchmarkItem> table;
+		for (int i = 0; i < 20000; ++i)
+		{
+			BenchmarkItem& item = table[HString("item_" + std::to_string(i))];
+			item.label = "an item with index " + std::to_string(i);
+			item.count = i;
+			item.weight = i * 0.25f;
+			item.ids = {i, i + 1, i + 2};
+		}
+		success &= BenchmarkInput("std::unordered_map<HString, BenchmarkItem> of 20000", table, table.size());
+
+		Tree<int> tree;
+		std::size_t treeNodes = MakeIntTree(tree, 6, 6);
+		success &= BenchmarkInput("Tree<int> 6 wide 6 deep", tree, treeNodes);
+
+		return success;
+	}
+};
+
+} // namespace Benchmarks
+
+} // namespace Farb
+
+#endif // BENCHMARK_DESERIALIZE_THROUGHPUT_HPP
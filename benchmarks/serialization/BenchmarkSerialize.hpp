@@ -0,0 +1,93 @@
+#ifndef BENCHMARK_SERIALIZE_HPP
+#define BENCHMARK_SERIALIZE_HPP
+
+#include <string>
+
+#include "../RegisterBenchmark.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionBasics.h"
+#include "../../src/reflection/ReflectionStatic.hpp"
+#include "../../src/reflection/ReflectionWrappers.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/Serialization.h"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Benchmarks
+{
+
+// a tree with branching children per node, depth levels deep
+inline void MakeTextTree(UI::Node& node, int branching, int depth)
+{
+	node.text.unparsedText = "node at depth " + std::to_string(depth);
+	node.width.type = UI::SizeType::FitContents;
+	node.height.type = UI::SizeType::FitContents;
+	node.top.amount = 10.0f;
+	node.top.units = UI::Units::Pixels;
+	if (depth == 0) return;
+	node.children.resize(branching);
+	for (auto & child : node.children)
+	{
+		MakeTextTree(child, branching, depth - 1);
+	}
+}
+
+class BenchmarkSerialize : public IBenchmark
+{
+public:
+	virtual bool RunBenchmarks() const override
+	{
+		std::cout << "Serialize" << std::endl;
+
+		constexpr int iterations = 50;
+		UI::Node root;
+		// 1 + 4 + 16 + 64 + 256 + 1024 nodes
+		MakeTextTree(root, 4, 5);
+
+		std::string buffer;
+		bool success = SerializeString(Reflect(root), buffer);
+		std::cout << "    UI::Node tree of 1365 nodes is " << buffer.size() << " bytes" << std::endl;
+
+		double compact = MeasureNanoseconds(iterations, [&]()
+		{
+			buffer.clear();
+			success &= SerializeString(Reflect(root), buffer);
+			DoNotOptimize(buffer.data());
+		});
+		farb_report("UI::Node tree compact, reused buffer", compact);
+
+		double pretty = MeasureNanoseconds(iterations, [&]()
+		{
+			buffer.clear();
+			success &= SerializeString(Reflect(root), buffer, JsonWriter::Mode::Pretty);
+			DoNotOptimize(buffer.data());
+		});
+		farb_report("UI::Node tree pretty, reused buffer", pretty);
+
+		double staticCompact = MeasureNanoseconds(iterations, [&]()
+		{
+			buffer.clear();
+			JsonWriter writer(buffer);
+			success &= !SerializeStatic(root, writer).IsError();
+			DoNotOptimize(buffer.data());
+		});
+		farb_report("UI::Node tree compact, static members", staticCompact);
+
+		double toString = MeasureNanoseconds(iterations, [&]()
+		{
+			std::string result = ToString(root);
+			DoNotOptimize(result.data());
+		});
+		farb_report("UI::Node tree ToString", toString);
+
+		return success;
+	}
+};
+
+} // namespace Benchmarks
+
+} // namespace Farb
+
+#endif // BENCHMARK_SERIALIZE_HPP
@@ -5,19 +5,11 @@
 #include <unordered_set>
 #include <unordered_map>
 
+#include "HString.h"
+
 namespace Farb
 {
 
-// rmf todo: @Implement HString or another pooled string option
-// ideally one that allows for a constexpr constructor
-// and move it out of BuiltinTypedefs
-// we could maybe implement this as a pointer to char array with a length,
-// then compile time constants could just be pointed at as normal
-// and then registered in the hashmap at run time
-// and runtime strings would be stored in memory owned by the hashmap
-// but not the hashmap itself
-// and comparisons are just about whether the location (and size) are the same
-using HString = std::string;
 using uint = unsigned int;
 using byte = unsigned char;
 
@@ -1,6 +1,9 @@
 #ifndef FARB_CONTAINERS_HPP
 #define FARB_CONTAINERS_HPP
 
+#include <array>
+#include <cstddef>
+#include <type_traits>
 #include <vector>
 #include "Error.hpp"
 
@@ -36,6 +39,47 @@ struct Tree
 	}
 };
 
+// a stack that keeps its first N elements inside of itself, so pushing and popping
+// never allocates until it is deeper than N, after which the rest spill into a vector
+// that is kept for reuse. elements are overwritten rather than destroyed when popped
+// references to the top are invalidated by Push once the stack has spilled
+template<typename T, std::size_t N>
+class InlineStack
+{
+	static_assert(std::is_trivially_destructible<T>::value, "popped elements are never destroyed");
+
+public:
+	bool Empty() const { return count == 0; }
+	std::size_t Size() const { return count; }
+
+	T& Top() { return count <= N ? inlined[count - 1] : spilled[count - N - 1]; }
+	const T& Top() const { return count <= N ? inlined[count - 1] : spilled[count - N - 1]; }
+
+	void Push(const T& value)
+	{
+		if (count < N)
+		{
+			inlined[count] = value;
+		}
+		else if (count - N < spilled.size())
+		{
+			spilled[count - N] = value;
+		}
+		else
+		{
+			spilled.push_back(value);
+		}
+		++count;
+	}
+
+	void Pop() { --count; }
+
+private:
+	std::array<T, N> inlined;
+	std::vector<T> spilled;
+	std::size_t count = 0;
+};
+
 } // namespace Farb
 
 #endif // FARB_CONTAINERS_HPP
\ No newline at end of file
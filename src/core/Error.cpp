@@ -0,0 +1,70 @@
+#include <iostream>
+
+#include "Error.hpp"
+
+namespace Farb
+{
+
+const char* ErrorFormat(ErrorCode code)
+{
+	switch (code)
+	{
+	case ErrorCode::NotImplemented: return "{} {} not implemented.";
+	case ErrorCode::IndexOutOfBounds: return "{} {} GetAtIndex {} is out of bounds, {}.";
+	case ErrorCode::NoMember: return "{} struct GetAtKey {} failed. No member exists with that name.";
+	case ErrorCode::NoEntry: return "{} table GetAtKey {} failed. No entry exists with that name.";
+	case ErrorCode::NoPendingElement: return "{} set GetAtIndex {} has no pending element.";
+	default: return "{}";
+	}
+}
+
+void ErrorArg::AppendTo(std::string& output) const
+{
+	if (isText)
+	{
+		output.append(text, length);
+		return;
+	}
+	output += std::to_string(integer);
+}
+
+std::string Error::Message() const
+{
+	if (code == ErrorCode::Message) return message;
+
+	std::string result;
+	std::uint8_t arg = 0;
+	for (const char* c = ErrorFormat(code); *c != '\0'; ++c)
+	{
+		if (c[0] == '{' && c[1] == '}')
+		{
+			if (arg < argCount) args[arg].AppendTo(result);
+			++arg;
+			++c;
+			continue;
+		}
+		result += *c;
+	}
+	return result;
+}
+
+Error& Error::SetParent(const Error& cause)
+{
+	parent = std::make_shared<const Error>(cause);
+	return *this;
+}
+
+void Error::Log(uint indentation) const
+{
+	for(uint i = 0; i < indentation; ++i)
+	{
+		std::cout << "	";
+	}
+	std::cout << Message() << std::endl;
+	if (parent != nullptr)
+	{
+		parent->Log(indentation + 1);
+	}
+}
+
+} // namespace Farb
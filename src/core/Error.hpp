@@ -1,51 +1,132 @@
 #ifndef FARB_ERROR_HPP
 #define FARB_ERROR_HPP
 
-#include <string>
+#include <cstdint>
 #include <memory>
-#include <iostream>
+#include <string>
+#include <type_traits>
+
+#include "HString.h"
 
 namespace Farb
 {
 
+// what went wrong, without the values involved
+// every code but Message has a format in ErrorFormat, whose arguments are kept
+// by value and only formatted when the error is logged or its message is read,
+// so code that probes for a value and discards the error never builds a string
+enum class ErrorCode : std::uint8_t
+{
+	// the caller built the whole text, the only code that allocates
+	Message,
+	// type, operation
+	NotImplemented,
+	// type, kind of container, index, size
+	IndexOutOfBounds,
+	// type, key
+	NoMember,
+	// type, key
+	NoEntry,
+	// type, index
+	NoPendingElement
+};
+
+// with a {} for each argument, in order
+const char* ErrorFormat(ErrorCode code);
+
+// kept without copying any characters, so text has to outlive the error,
+// which string literals and HStrings always do
+struct ErrorArg
+{
+	bool isText;
+	std::uint32_t length;
+	union
+	{
+		const char* text;
+		std::int64_t integer;
+	};
+
+	ErrorArg()
+		: isText(false)
+		, length(0)
+		, integer(0)
+	{ }
+
+	template<std::size_t N>
+	ErrorArg(const char (&literal)[N])
+		: isText(true)
+		, length(static_cast<std::uint32_t>(std::char_traits<char>::length(literal)))
+		, text(literal)
+	{ }
+
+	ErrorArg(const HString& name)
+		: isText(true)
+		, length(static_cast<std::uint32_t>(name.Size()))
+		, text(name.Data())
+	{ }
+
+	template<typename TInt, typename = std::enable_if_t<std::is_integral<TInt>::value> >
+	ErrorArg(TInt value)
+		: isText(false)
+		, length(0)
+		, integer(static_cast<std::int64_t>(value))
+	{ }
+
+	void AppendTo(std::string& output) const;
+};
+
 struct Error
 {
-	std::string message;
-	std::shared_ptr<Error> parent;
+	static constexpr std::size_t MaxArgs = 4;
 
 	Error(std::string message, Error* parent = nullptr)
-		: message(message)
-		, parent(parent)
+		: code(ErrorCode::Message)
+		, argCount(0)
+		, args()
+		, message(std::move(message))
+		, parent()
 	{
+		if (parent != nullptr) SetParent(*parent);
 	}
 
-	Error(const Error& error)
-		: message(error.message)
-		, parent(error.parent)
+	template<typename ... TArgs>
+	Error(ErrorCode code, const TArgs& ... values)
+		: code(code)
+		, argCount(sizeof...(TArgs))
+		, args{ErrorArg(values)...}
+		, message()
+		, parent()
 	{
+		static_assert(sizeof...(TArgs) <= MaxArgs, "Error has room for MaxArgs arguments");
 	}
 
-	Error& operator=(const Error& error)
-	{
-		message = error.message;
-		parent = error.parent;
-		return *this;
-	}
+	Error(const Error& error) = default;
+	Error(Error&& error) = default;
+	Error& operator=(const Error& error) = default;
+	Error& operator=(Error&& error) = default;
 
-	void Log(uint indentation = 0)
-	{
-		for(uint i = 0; i < indentation; ++i)
-		{
-			std::cout << "	";
-		}
-		std::cout << message << std::endl;
-		if (parent != nullptr)
-		{
-			parent->Log(indentation + 1);
-		}
-	}
+	ErrorCode Code() const { return code; }
+
+	// formats the arguments into the code's format, or returns the caller's text
+	std::string Message() const;
+
+	// cause is copied and owned by this error and its copies, so chaining allocates
+	// but only on the error path
+	Error& SetParent(const Error& cause);
+	// nullptr if there is no parent
+	const Error* Parent() const { return parent.get(); }
+
+	void Log(uint indentation = 0) const;
+
+private:
+	ErrorCode code;
+	std::uint8_t argCount;
+	ErrorArg args[MaxArgs];
+	// only for ErrorCode::Message
+	std::string message;
+	std::shared_ptr<const Error> parent;
 };
 
 } // namespace Farb
 
-#endif // FARB_ERROR_HPP
\ No newline at end of file
+#endif // FARB_ERROR_HPP
@@ -1,8 +1,11 @@
 #ifndef FARB_ERROR_OR_HPP
 #define FARB_ERROR_OR_HPP
 
+#include <cassert>
 #include <memory>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 #include "../../src/core/Error.hpp"
 
@@ -14,6 +17,8 @@ struct Success
 {
 };
 
+// either a T or the Error explaining why there isn't one
+// T only has to be movable, a value passed in or taken out with std::move is never copied
 template<typename T>
 struct ErrorOr
 {
@@ -25,6 +30,32 @@ private:
 		T value;
 	};
 
+	void Destroy()
+	{
+		if (isError)
+		{
+			error.~Error();
+		}
+		else
+		{
+			value.~T();
+		}
+	}
+
+	// only called when nothing is constructed
+	void ConstructFrom(ErrorOr&& other)
+	{
+		isError = other.isError;
+		if (isError)
+		{
+			new (&error) Error(std::move(other.error));
+		}
+		else
+		{
+			new (&value) T(std::move(other.value));
+		}
+	}
+
 public:
 	ErrorOr(const Error& error)
 		: isError(true)
@@ -43,32 +74,22 @@ public:
 
 	ErrorOr(T&& value)
 		: isError(false)
-		, value(value)
+		, value(std::move(value))
 	{ }
 
-	ErrorOr(ErrorOr&& other)
+	// copies would hide the cost of large values, take them out with GetValue instead
+	ErrorOr(const ErrorOr& other) = delete;
+	ErrorOr& operator=(const ErrorOr& other) = delete;
+
+	ErrorOr(ErrorOr&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
 		: isError(other.isError)
 	{
-		if (isError)
-		{
-			error = std::move(other.error);
-		}
-		else
-		{
-			value = std::move(other.value);
-		}
+		ConstructFrom(std::move(other));
 	}
 
 	~ErrorOr()
 	{
-		if (isError)
-		{
-			(&error)->Error::~Error();
-		}
-		else
-		{
-			(&value)->T::~T();
-		}
+		Destroy();
 	}
 
 	ErrorOr& operator=(ErrorOr&& other)
@@ -77,61 +98,78 @@ public:
 		{
 			return *this;
 		}
-		if (isError != other.isError)
+		if (isError == other.isError)
 		{
 			if (isError)
 			{
-				(&error)->Error::~Error();
+				error = std::move(other.error);
 			}
 			else
 			{
-				(&value)->T::~T();
+				value = std::move(other.value);
 			}
-			isError = other.isError;
-		}
-		if (isError)
-		{
-			// we are calling an in place new
-			// so that we don't try to reassign a garbage error.parent pointer
-			// causing a free on random memory
-			new (&error) Error(other.error);
-		}
-		else
-		{
-			new (&value) T(other.value);
+			return *this;
 		}
+		Destroy();
+		ConstructFrom(std::move(other));
 		return *this;
 	}
 
-	bool IsError()
+	bool IsError() const
 	{
 		return isError;
 	}
 
-	T& GetValue()
+	T& GetValue() &
+	{
+		assert(!isError);
+		return value;
+	}
+
+	const T& GetValue() const &
 	{
 		assert(!isError);
 		return value;
 	}
 
-	Error& GetError()
+	// so std::move(result).GetValue() and CHECK_RETURN move the value out
+	T&& GetValue() &&
+	{
+		assert(!isError);
+		return std::move(value);
+	}
+
+	Error& GetError() &
+	{
+		assert(isError);
+		return error;
+	}
+
+	const Error& GetError() const &
 	{
 		assert(isError);
 		return error;
 	}
+
+	Error&& GetError() &&
+	{
+		assert(isError);
+		return std::move(error);
+	}
 };
 
 // this is a gcc extension that is also present in clang but not msvc
 // it allows for multiple statements in a single expression
 // and evaluates to the last one
+// both the error and the value are moved out of the result, which is discarded
 #define CHECK_RETURN(functionCall) \
 	({ \
 		auto erroror_internal_result = functionCall; \
 		if (erroror_internal_result.IsError()) \
 		{ \
-			return erroror_internal_result.GetError(); \
+			return std::move(erroror_internal_result).GetError(); \
 		} \
-		erroror_internal_result.GetValue(); \
+		std::move(erroror_internal_result).GetValue(); \
 	})
 
 } // namespace Farb
@@ -0,0 +1,116 @@
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "HString.h"
+
+namespace Farb
+{
+
+namespace
+{
+
+struct PrecomputedHash
+{
+	std::size_t operator()(const HString& value) const { return value.GetHash(); }
+};
+
+struct ContentsEqual
+{
+	bool operator()(const HString& a, const HString& b) const { return a.View() == b.View(); }
+};
+
+// all interned characters live in fixed size blocks that are never freed or moved
+// so handles stay valid for the lifetime of the program
+// large strings get their own allocation so they do not waste the rest of a block
+struct HStringPool
+{
+	static constexpr std::size_t BlockSize = 16 * 1024;
+
+	std::shared_mutex mutex;
+	std::unordered_set<HString, PrecomputedHash, ContentsEqual> entries;
+	std::vector<std::unique_ptr<char[]> > blocks;
+	std::vector<std::unique_ptr<char[]> > largeStrings;
+	std::size_t blockUsed = BlockSize;
+
+	const char* Store(std::string_view contents)
+	{
+		std::size_t required = contents.size() + 1;
+		char* destination = nullptr;
+		if (required > BlockSize / 4)
+		{
+			largeStrings.emplace_back(new char[required]);
+			destination = largeStrings.back().get();
+		}
+		else
+		{
+			if (blockUsed + required > BlockSize)
+			{
+				blocks.emplace_back(new char[BlockSize]);
+				blockUsed = 0;
+			}
+			destination = blocks.back().get() + blockUsed;
+			blockUsed += required;
+		}
+		std::memcpy(destination, contents.data(), contents.size());
+		destination[contents.size()] = '\0';
+		return destination;
+	}
+};
+
+HStringPool& GetPool()
+{
+	// intentionally leaked so handles stay valid during static destruction
+	static HStringPool* pool = new HStringPool();
+	return *pool;
+}
+
+} // namespace
+
+HString HString::InternInPool(std::string_view contents, std::size_t hash)
+{
+	HString probe(contents.data(), contents.size(), hash, false);
+	HStringPool& pool = GetPool();
+	{
+		std::shared_lock<std::shared_mutex> lock(pool.mutex);
+		auto iter = pool.entries.find(probe);
+		if (iter != pool.entries.end())
+		{
+			return *iter;
+		}
+	}
+	std::unique_lock<std::shared_mutex> lock(pool.mutex);
+	// another thread may have inserted while we were waiting for the lock
+	auto iter = pool.entries.find(probe);
+	if (iter != pool.entries.end())
+	{
+		return *iter;
+	}
+	HString entry(pool.Store(contents), contents.size(), hash, true);
+	pool.entries.insert(entry);
+	return entry;
+}
+
+HString HString::FindInPool(std::string_view contents, std::size_t hash)
+{
+	HString probe(contents.data(), contents.size(), hash, false);
+	HStringPool& pool = GetPool();
+	std::shared_lock<std::shared_mutex> lock(pool.mutex);
+	auto iter = pool.entries.find(probe);
+	if (iter != pool.entries.end())
+	{
+		return *iter;
+	}
+	return HString();
+}
+
+std::size_t HString::PoolSize()
+{
+	HStringPool& pool = GetPool();
+	std::shared_lock<std::shared_mutex> lock(pool.mutex);
+	return pool.entries.size();
+}
+
+} // namespace Farb
@@ -0,0 +1,186 @@
+#ifndef FARB_HSTRING_H
+#define FARB_HSTRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace Farb
+{
+
+// HString is a handle to an immutable string with a precomputed hash
+// there are two kinds of handles:
+// - literals, which are constexpr constructible and point directly at their
+//   characters. These must have static storage duration (i.e. string literals)
+// - interned, which point at characters owned by the global HString pool
+//   and are unique per string contents, so equality is a pointer comparison
+// comparing a literal to an interned string with the same hash falls back
+// to comparing characters, so metadata that is compared often should be interned
+struct HString
+{
+private:
+	const char* chars;
+	std::size_t length;
+	std::size_t hash;
+	bool interned;
+
+	static constexpr std::size_t Length(const char* chars)
+	{
+		std::size_t length = 0;
+		while (chars[length] != '\0')
+		{
+			++length;
+		}
+		return length;
+	}
+
+	constexpr HString(const char* chars, std::size_t length, std::size_t hash, bool interned)
+		: chars(chars)
+		, length(length)
+		, hash(hash)
+		, interned(interned)
+	{ }
+
+	// looks up contents in the pool, inserting a copy if it is not present
+	static HString InternInPool(std::string_view contents, std::size_t hash);
+	// looks up contents in the pool, returns an empty string if not present
+	static HString FindInPool(std::string_view contents, std::size_t hash);
+
+public:
+	// FNV-1a, computed at compile time for literals
+	static constexpr std::size_t Hash(const char* chars, std::size_t length)
+	{
+		std::uint64_t result = 14695981039346656037ull;
+		for (std::size_t i = 0; i < length; ++i)
+		{
+			result ^= static_cast<unsigned char>(chars[i]);
+			result *= 1099511628211ull;
+		}
+		return static_cast<std::size_t>(result);
+	}
+
+	constexpr HString()
+		: chars("")
+		, length(0)
+		, hash(Hash("", 0))
+		, interned(false)
+	{ }
+
+	// only for literals, which is why it takes an array rather than a pointer
+	// runtime strings should use the std::string constructor so their contents
+	// are copied into the pool, or Find to probe without growing it
+	template<std::size_t N>
+	constexpr HString(const char (&literal)[N])
+		: chars(literal)
+		, length(Length(literal))
+		, hash(Hash(literal, Length(literal)))
+		, interned(false)
+	{ }
+
+	HString(const std::string& value)
+		: HString(InternInPool(value, Hash(value.data(), value.size())))
+	{ }
+
+	constexpr HString(const HString& other) = default;
+	constexpr HString& operator=(const HString& other) = default;
+
+	// returns the pooled handle for these contents, which compares by pointer
+	HString Interned() const
+	{
+		if (interned) return *this;
+		return InternInPool(View(), hash);
+	}
+
+	// returns the pooled handle for contents if any HString with these contents
+	// has been interned, otherwise returns an empty HString
+	// useful for probing names without growing the pool
+	static HString Find(std::string_view contents)
+	{
+		return FindInPool(contents, Hash(contents.data(), contents.size()));
+	}
+
+	static std::size_t PoolSize();
+
+	constexpr bool IsInterned() const { return interned; }
+	constexpr bool Empty() const { return length == 0; }
+	constexpr std::size_t Size() const { return length; }
+	constexpr std::size_t GetHash() const { return hash; }
+	constexpr const char* Data() const { return chars; }
+
+	std::string_view View() const { return std::string_view(chars, length); }
+	std::string ToStdString() const { return std::string(chars, length); }
+	explicit operator std::string() const { return ToStdString(); }
+
+	bool operator==(const HString& other) const
+	{
+		if (chars == other.chars) return length == other.length;
+		if (hash != other.hash || length != other.length) return false;
+		// two different pooled entries never have the same contents
+		if (interned && other.interned) return false;
+		return std::memcmp(chars, other.chars, length) == 0;
+	}
+
+	bool operator!=(const HString& other) const
+	{
+		return !(*this == other);
+	}
+
+	bool operator<(const HString& other) const
+	{
+		return View() < other.View();
+	}
+};
+
+inline std::string operator+(const HString& a, const HString& b)
+{
+	std::string ret;
+	ret.reserve(a.Size() + b.Size());
+	ret.append(a.Data(), a.Size());
+	ret.append(b.Data(), b.Size());
+	return ret;
+}
+
+inline std::string operator+(const HString& a, const std::string& b)
+{
+	return a.ToStdString() + b;
+}
+
+inline std::string operator+(const std::string& a, const HString& b)
+{
+	return std::string(a).append(b.Data(), b.Size());
+}
+
+inline std::string operator+(const HString& a, const char* b)
+{
+	return a.ToStdString() + b;
+}
+
+inline std::string operator+(const char* a, const HString& b)
+{
+	return std::string(a).append(b.Data(), b.Size());
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const HString& value)
+{
+	return stream.write(value.Data(), value.Size());
+}
+
+} // namespace Farb
+
+namespace std
+{
+	template <>
+	struct hash<Farb::HString>
+	{
+		std::size_t operator()(const Farb::HString& value) const
+		{
+			return value.GetHash();
+		}
+	};
+} // namespace std
+
+#endif // FARB_HSTRING_H
@@ -43,7 +43,8 @@ struct NamedType
 
 	// ugly sfinae to allow implicit construction from string literals
 	template<typename U = T>
-	NamedType(const char* value, typename std::enable_if<std::is_same<U, std::string>::value >::type* = nullptr)
+	NamedType(const char* value, typename std::enable_if<
+		std::is_same<U, std::string>::value || std::is_same<U, HString>::value >::type* = nullptr)
 		: value(value)
 	{ }
 
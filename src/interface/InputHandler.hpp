@@ -56,6 +56,8 @@ struct Handler
 	std::string responseFunctionName;
 	Result (*response)(Event);
 
+	inline bool Defined() const { return !responseFunctionName.empty(); }
+
 	static Reflection::TypeInfo* GetStaticTypeInfo();
 };
 
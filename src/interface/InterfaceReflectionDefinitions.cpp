@@ -1,3 +1,4 @@
+#include <cstdio>
 #include <iostream>
 #include <set>
 #include <unordered_map>
@@ -9,6 +10,7 @@
 #include "TigrExtensions.h"
 #include "ReflectionDeclare.h"
 #include "ReflectionDefine.hpp"
+#include "ReflectionStatic.hpp"
 #include "ReflectionBasics.h"
 #include "ReflectionWrappers.hpp"
 #include "ReflectionContainers.hpp"
@@ -41,54 +43,48 @@ TypeInfo* Reflection::GetTypeInfo<TPixel>()
 
 TypeInfo* UI::Dimensions::GetStaticTypeInfo()
 {
-	static TypeInfoStruct<UI::Dimensions> typeInfo {
-		"UI::Dimensions",
-		nullptr,
-		std::vector<MemberInfo<UI::Dimensions>*> {
-			MakeMemberInfoTyped("x", &UI::Dimensions::x),
-			MakeMemberInfoTyped("y", &UI::Dimensions::y),
-			MakeMemberInfoTyped("width", &UI::Dimensions::width),
-			MakeMemberInfoTyped("height", &UI::Dimensions::height)
-		}
-	};
-
+	static auto typeInfo = MakeStaticTypeInfoStruct<UI::Dimensions>("UI::Dimensions");
 	return &typeInfo;
 }
 
-struct NineSliceConverter : public Functor<ErrorOr<std::vector<UI::Dimensions> >, const std::vector<int> & >
+// slices are written as 4 coordinates [x1, x2, y1, y2]
+// the rest x0, x3, y0, y3 are taken from dimensions in Image::PostLoad
+ErrorOr<Success> NineSliceFromCoordinates(const int (&in)[4], std::vector<UI::Dimensions>& out)
 {
-	using TFunctor = Functor<ErrorOr<std::vector<UI::Dimensions> >, const std::vector<int> & >;
-	virtual ErrorOr<std::vector<UI::Dimensions> > operator()(const std::vector<int> & in) override
-	{
-		if (in.size() != 4)
-		{
-			return Error("NineSlice requires 4 coordinates, x1, x2, y1, y2. The rest x0, x3, y0, y3 are taken from dimensions.");
-		}
-
-		std::vector<UI::Dimensions> ret(9);
-		using namespace UI::NineSliceLocations;
-
-		// we can't set all the coordinates here, must wait until Image::PostLoad
-		// for the ones derrived from spriteLocation
-		ret[TC].x = in[0];
-		ret[TR].x = in[1];
-		ret[ML].y = in[2];
-		ret[BL].y = in[3];
-		return ret;
-	}
+	using namespace UI::NineSliceLocations;
+	// reuses the existing slices if there are any
+	out.assign(9, UI::Dimensions());
+
+	// we can't set all the coordinates here, must wait until Image::PostLoad
+	// for the ones derrived from spriteLocation
+	out[TC].x = in[0];
+	out[TR].x = in[1];
+	out[ML].y = in[2];
+	out[BL].y = in[3];
+	return Success();
+}
 
-	virtual TFunctor * clone() const override
+// the inverse of NineSliceFromCoordinates, for slices that have been through Image::PostLoad
+ErrorOr<Success> NineSliceToCoordinates(const std::vector<UI::Dimensions>& in, int (&out)[4])
+{
+	if (in.size() != 9)
 	{
-		return new NineSliceConverter(*this);
+		return Error("NineSlice requires 9 slices to convert back to coordinates.");
 	}
-};
+	using namespace UI::NineSliceLocations;
+	out[0] = in[TC].x;
+	out[1] = in[TR].x;
+	out[2] = in[ML].y;
+	out[3] = in[BL].y;
+	return Success();
+}
 
 TypeInfo* UI::Image::GetStaticTypeInfo()
 {
-	static NineSliceConverter converter;
-	static auto nineSliceTypeInfo = TypeInfoAs<std::vector<UI::Dimensions>, std::vector<int> >(
+	static auto nineSliceTypeInfo = TypeInfoAs<std::vector<UI::Dimensions>, int[4]>(
 		"NineSlice",
-		converter);
+		NineSliceFromCoordinates,
+		NineSliceToCoordinates);
 
 	static TypeInfoStruct<UI::Image> typeInfo {
 		"UI::Image(Table)",
@@ -97,8 +93,7 @@ TypeInfo* UI::Image::GetStaticTypeInfo()
 			MakeMemberInfoTyped("source", &UI::Image::filePath),
 			MakeMemberInfoTyped("tiled", &UI::Image::enableTiling),
 			MakeMemberInfoTyped("dimensions", &UI::Image::spriteLocation),
-			// would like to specify this as a vector of 4 ints [x1, x2, y1, y2]
-			MakeMemberInfoTyped("slices", &UI::Image::nineSlice, &nineSliceTypeInfo)
+			MakeMemberInfoTyped("slices", &UI::Image::nineSlice, SkipIfEmpty, &nineSliceTypeInfo)
 		},
 		&UI::Image::PostLoad
 	};
@@ -112,11 +107,9 @@ bool UI::Image::PostLoad(Image& image)
 
 	if (sharedImages.count(image.filePath))
 	{
-		// rmf todo: what is the weak_ptr interface?
-		// I should probably consider downloading the docs...
 		if (auto tempShared = sharedImages[image.filePath].lock())
 		{
-			image.bitmap.reset(tempShared.get(), TigrDeleter());
+			image.bitmap = tempShared;
 		}
 	}
 	if (image.bitmap == nullptr)
@@ -201,13 +194,25 @@ struct ScalarAssign
 		return true;
 	}
 
-	static std::string ToString(const UI::Scalar& object, std::string indentation = "")
+	static ErrorOr<Success> Serialize(const UI::Scalar& object, Writer& writer)
 	{
-		if (object.units != UI::Units::Pixels)
+		auto unitsTypeInfo = static_cast<TypeInfoEnum<UI::Units>*>(GetTypeInfo<UI::Units>());
+		HString unitsName = unitsTypeInfo->GetValueName(object.units);
+		// Units::None isn't reflected, these are written as pixels
+		// members that may be unspecified should use SkipUnlessDefined
+		if (object.units == UI::Units::Pixels || unitsName.Empty())
 		{
-			return std::to_string(object.amount) + " " + Reflection::ToString(object.units);
+			writer.Float(object.amount);
+			return Success();
 		}
-		return std::to_string(object.amount);
+		// the same format Parse reads, "amount units"
+		char amount[32];
+		int length = std::snprintf(amount, sizeof(amount), "%.9g", object.amount);
+		std::string value(amount, length);
+		value += ' ';
+		value.append(unitsName.Data(), unitsName.Size());
+		writer.String(value);
+		return Success();
 	}
 };
 
@@ -216,7 +221,7 @@ TypeInfo* UI::Scalar::GetStaticTypeInfo()
 
 	static auto typeInfo = TypeInfoCustomLeaf<UI::Scalar>::Construct(
 		"UI::Scalar",
-		ScalarAssign::ToString,
+		ScalarAssign::Serialize,
 		ScalarAssign::Parse,
 		ScalarAssign::Numeric<uint>,
 		ScalarAssign::Numeric<int>,
@@ -238,17 +243,7 @@ TypeInfo* UI::Text::GetStaticTypeInfo()
 	};
 
 	// rmf todo: struct with assign functions
-	static TypeInfoStruct<UI::Text> typeInfo {
-		"UI::Text",
-		nullptr,
-		std::vector<MemberInfo<UI::Text>*> {
-			MakeMemberInfoTyped("contents", &UI::Text::unparsedText),
-			MakeMemberInfoTyped("size", &UI::Text::size),
-			MakeMemberInfoTyped("font", &UI::Text::fontName),
-			MakeMemberInfoTyped("color", &UI::Text::color)
-		},
-		UI::Text::PostLoad
-	};
+	static auto typeInfo = MakeStaticTypeInfoStruct<UI::Text>("UI::Text");
 	return &typeInfo;
 }
 
@@ -280,15 +275,18 @@ struct UISizeAssign
 		return true;
 	}
 
-	static std::string ToString(const UI::Size& object, std::string indentation = "")
+	static ErrorOr<Success> Serialize(const UI::Size& object, Writer& writer)
 	{
 		if (object.type == UI::SizeType::Scalar)
 		{
-			return Reflection::ToString(object.scalar, indentation);
+			return ScalarAssign::Serialize(object.scalar, writer);
 		}
 		else
 		{
-			return Reflection::ToString(object.type, indentation);
+			// always the name, a number would be read back as a scalar
+			auto typeTypeInfo = static_cast<TypeInfoEnum<UI::SizeType>*>(GetTypeInfo<UI::SizeType>());
+			writer.String(typeTypeInfo->GetValueName(object.type));
+			return Success();
 		}
 	}
 };
@@ -297,7 +295,7 @@ TypeInfo* UI::Size::GetStaticTypeInfo()
 {
 	static auto typeInfo = TypeInfoCustomLeaf<UI::Size>::Construct(
 		"UI::Size",
-		UISizeAssign::ToString,
+		UISizeAssign::Serialize,
 		UISizeAssign::Parse,
 		UISizeAssign::Numeric<uint>,
 		UISizeAssign::Numeric<int>,
@@ -308,24 +306,7 @@ TypeInfo* UI::Size::GetStaticTypeInfo()
 
 TypeInfo* UI::Node::GetStaticTypeInfo()
 {
-	static TypeInfoStruct<UI::Node> typeInfo {
-		"UI::Node",
-		nullptr,
-		std::vector<MemberInfo<UI::Node>*> {
-			MakeMemberInfoTyped("background", &UI::Node::backgroundColor),
-			MakeMemberInfoTyped("image", &UI::Node::image),
-			MakeMemberInfoTyped("text", &UI::Node::text),
-			MakeMemberInfoTyped("input", &UI::Node::inputHandler),
-			MakeMemberInfoTyped("top", &UI::Node::top),
-			MakeMemberInfoTyped("left", &UI::Node::left),
-			MakeMemberInfoTyped("right", &UI::Node::right),
-			MakeMemberInfoTyped("bottom", &UI::Node::bottom),
-			MakeMemberInfoTyped("height", &UI::Node::height),
-			MakeMemberInfoTyped("width", &UI::Node::width),
-			MakeMemberInfoTyped("children", &UI::Node::children)
-		},
-		UI::Node::PostLoad
-	};
+	static auto typeInfo = MakeStaticTypeInfoStruct<UI::Node>("UI::Node");
 	return &typeInfo;
 }
 
@@ -538,7 +519,7 @@ TypeInfo* Reflection::GetTypeInfo<UI::Units>()
 {
 	static TypeInfoEnum<UI::Units> typeInfo {
 		"UI::Units",
-		std::vector<std::pair <std::string, int> >{
+		std::vector<std::pair <HString, int> >{
 			// None is not reflected intentionally, because it should not be deserialized
 			// could add for serialization if we need it
 			// but would rather just not serialize none values at all
@@ -555,7 +536,7 @@ TypeInfo* Reflection::GetTypeInfo<UI::SizeType>()
 {
 	static TypeInfoEnum<UI::SizeType> typeInfo {
 		"UI::SizeType",
-		std::vector<std::pair <std::string, int> > {
+		std::vector<std::pair <HString, int> > {
 			// Scalar is not reflected intentionally because UI::Size doesn't need it
 			// could add later
 			{"FitContents", static_cast<int>(UI::SizeType::FitContents)},
@@ -570,7 +551,7 @@ TypeInfo* Reflection::GetTypeInfo<Input::Type>()
 {
 	static TypeInfoEnum<Input::Type> typeInfo {
 		"Input::Type",
-		std::vector<std::pair <std::string, int> > {
+		std::vector<std::pair <HString, int> > {
 			{"MouseDown", static_cast<int>(Input::Type::MouseDown)},
 			{"MouseUp", static_cast<int>(Input::Type::MouseUp)},
 			{"MouseClick", static_cast<int>(Input::Type::MouseClick)},
@@ -76,9 +76,18 @@ struct Dimensions
 		: x(x), y(y), width(width), height(height)
 	{ }
 
-	Dimensions(const Dimensions& other)
-		: x(other.x), y(other.y), width(other.width), height(other.height)
-	{ }
+	// trivially copyable, so arrays of dimensions can be frozen as is
+	Dimensions(const Dimensions& other) = default;
+	Dimensions& operator=(const Dimensions& other) = default;
+
+	static constexpr auto GetStaticMembers()
+	{
+		return std::make_tuple(
+			Reflection::MakeStaticMember("x", &Dimensions::x),
+			Reflection::MakeStaticMember("y", &Dimensions::y),
+			Reflection::MakeStaticMember("width", &Dimensions::width),
+			Reflection::MakeStaticMember("height", &Dimensions::height));
+	}
 
 	static Reflection::TypeInfo* GetStaticTypeInfo();
 };
@@ -112,6 +121,8 @@ struct Scalar
 		, units(Units::None)
 	{ }
 
+	inline bool Defined() const { return units != Units::None; }
+
 	static Reflection::TypeInfo* GetStaticTypeInfo();
 };
 
@@ -241,6 +252,15 @@ struct Text
 		Tigr* destImage,
 		const Dimensions& destDim) const;
 
+	static constexpr auto GetStaticMembers()
+	{
+		return std::make_tuple(
+			Reflection::MakeStaticMember("contents", &Text::unparsedText),
+			Reflection::MakeStaticMember("size", &Text::size, Reflection::SkipUnlessDefined),
+			Reflection::MakeStaticMember("font", &Text::fontName),
+			Reflection::MakeStaticMember("color", &Text::color));
+	}
+
 	static Reflection::TypeInfo* GetStaticTypeInfo();
 
 	static bool PostLoad(Text& text);
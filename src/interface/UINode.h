@@ -36,6 +36,8 @@ struct Size
 		, type(SizeType::Scalar)
 	{ }
 
+	inline bool Defined() const { return type != SizeType::Scalar || scalar.Defined(); }
+
 	static Reflection::TypeInfo* GetStaticTypeInfo();
 };
 
@@ -82,6 +84,22 @@ struct Node
 	NodeSpec spec = NodeSpec::None;
 	DimensionAttribute dependencyOrdering[5];
 
+	static constexpr auto GetStaticMembers()
+	{
+		return std::make_tuple(
+			Reflection::MakeStaticMember("background", &Node::backgroundColor),
+			Reflection::MakeStaticMember("image", &Node::image, Reflection::SkipUnlessDefined),
+			Reflection::MakeStaticMember("text", &Node::text, Reflection::SkipUnlessDefined),
+			Reflection::MakeStaticMember("input", &Node::inputHandler, Reflection::SkipUnlessDefined),
+			Reflection::MakeStaticMember("top", &Node::top, Reflection::SkipUnlessDefined),
+			Reflection::MakeStaticMember("left", &Node::left, Reflection::SkipUnlessDefined),
+			Reflection::MakeStaticMember("right", &Node::right, Reflection::SkipUnlessDefined),
+			Reflection::MakeStaticMember("bottom", &Node::bottom, Reflection::SkipUnlessDefined),
+			Reflection::MakeStaticMember("height", &Node::height, Reflection::SkipUnlessDefined),
+			Reflection::MakeStaticMember("width", &Node::width, Reflection::SkipUnlessDefined),
+			Reflection::MakeStaticMember("children", &Node::children));
+	}
+
 	static Reflection::TypeInfo* GetStaticTypeInfo();
 
 	static bool PostLoad(Node& node);
@@ -29,7 +29,7 @@ bool UIWindow::Render(const Node& tree)
 		result.GetError().Log();
 		return false;
 	}
-	Tree<Dimensions> dimensions = result.GetValue();
+	Tree<Dimensions> dimensions = std::move(result).GetValue();
 	auto renderResult = Render(0, 0, dimensions, tree);
 	if (renderResult.IsError())
 	{
@@ -327,7 +327,7 @@ ErrorOr<Tree<Dimensions> > UIWindow::ComputeDimensions(
 			{
 				auto childTree = CHECK_RETURN(ComputeDimensions(
 					window, dimensions, child));
-				dimensionsTree.children.push_back(childTree);
+				dimensionsTree.children.push_back(std::move(childTree));
 			}
 			break;
 		}
@@ -1,4 +1,6 @@
 #include <limits.h>
+#include <mutex>
+#include <unordered_map>
 
 #include "ReflectionDeclare.h"
 #include "ReflectionDefine.hpp"
@@ -20,7 +22,7 @@ TypeInfo* GetTypeInfo<bool>()
 			object = value;
 			return true;
 		}),
-		HString("uint"), static_cast<bool (*)(bool&, uint)>([](bool& object, uint value)
+		static_cast<bool (*)(bool&, uint)>([](bool& object, uint value)
 		{
 			switch(value)
 			{
@@ -34,7 +36,7 @@ TypeInfo* GetTypeInfo<bool>()
 				return false;
 			}
 		}),
-		HString("int"), static_cast<bool (*)(bool&, int)>([](bool& object, int value)
+		static_cast<bool (*)(bool&, int)>([](bool& object, int value)
 		{
 			switch(value)
 			{
@@ -58,12 +60,12 @@ TypeInfo* GetTypeInfo<char>()
 	static auto charTypeInfo = TypeInfoCustomLeaf<char>::Construct(
 		"char",
 		nullptr,
-		HString("uint"), static_cast<bool (*)(char&, uint)>([](char& object, uint value)
+		static_cast<bool (*)(char&, uint)>([](char& object, uint value)
 		{
 			object = static_cast<char>(value);
 			return true;
 		}),
-		HString("int"), static_cast<bool (*)(char&, int)>([](char& object, int value)
+		static_cast<bool (*)(char&, int)>([](char& object, int value)
 		{
 			object = static_cast<char>(value);
 			return true;
@@ -79,12 +81,12 @@ TypeInfo* GetTypeInfo<unsigned char>()
 	static auto ucharTypeInfo = TypeInfoCustomLeaf<unsigned char>::Construct(
 		"uchar",
 		nullptr,
-		HString("uint"), static_cast<bool (*)(unsigned char&, uint)>([](unsigned char& object, uint value)
+		static_cast<bool (*)(unsigned char&, uint)>([](unsigned char& object, uint value)
 		{
 			object = static_cast<unsigned char>(value);
 			return true;
 		}),
-		HString("int"), static_cast<bool (*)(unsigned char&, int)>([](unsigned char& object, int value)
+		static_cast<bool (*)(unsigned char&, int)>([](unsigned char& object, int value)
 		{
 			if (value < 0) return false;
 			object = static_cast<unsigned char>(value);
@@ -106,7 +108,7 @@ TypeInfo* GetTypeInfo<uint>()
 			object = value;
 			return true;
 		}),
-		HString("int"), static_cast<bool (*)(uint&, int)>([](uint& object, int value)
+		static_cast<bool (*)(uint&, int)>([](uint& object, int value)
 		{
 			if (value < 0 ) { return false; }
 			object = static_cast<uint>(value);
@@ -171,13 +173,50 @@ TypeInfo* GetTypeInfo<std::string>()
 		nullptr,
 		static_cast<bool (*)(std::string&, std::string)>([](std::string& object, std::string value)
 		{
-			object = value;
+			object = std::move(value);
 			return true;
 		})
 	);
 	return &stringTypeInfo;
 }
 
+template <>
+TypeInfo* GetTypeInfo<HString>()
+{
+	static auto hstringTypeInfo = TypeInfoCustomLeaf<HString>::Construct(
+		"HString",
+		nullptr,
+		static_cast<bool (*)(HString&, std::string)>([](HString& object, std::string value)
+		{
+			object = HString(value);
+			return true;
+		})
+	);
+	return &hstringTypeInfo;
+}
+
+DeserializationContext& DeserializationContext::ThreadDefault()
+{
+	thread_local DeserializationContext context;
+	return context;
+}
+
+std::uint64_t GetSchemaHash(const TypeInfo* typeInfo)
+{
+	static std::mutex cacheMutex;
+	static std::unordered_map<const TypeInfo*, std::uint64_t> cache;
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	auto iter = cache.find(typeInfo);
+	if (iter != cache.end())
+	{
+		return iter->second;
+	}
+	SchemaHash hash;
+	hash.Include(typeInfo);
+	cache[typeInfo] = hash.value;
+	return hash.value;
+}
+
 } // namespace Reflection
 
 } // namespace Farb
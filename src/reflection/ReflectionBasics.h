@@ -16,6 +16,7 @@ template <> TypeInfo* GetTypeInfo<uint>();
 template <> TypeInfo* GetTypeInfo<int>();
 template <> TypeInfo* GetTypeInfo<float>();
 template <> TypeInfo* GetTypeInfo<std::string>();
+template <> TypeInfo* GetTypeInfo<HString>();
 
 } // namespace Reflection
 
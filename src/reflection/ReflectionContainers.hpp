@@ -31,28 +31,56 @@ struct TemplatedTypeInfo<std::vector<TVal> >
 	}
 };
 
-// rmf todo: [N] types could be made more efficient if they were done in place
-// rather than reflected as std::vector
-
+// reflected in place, elements are assigned directly into the array
+// the number of elements given so far is kept in the context
+// so that too few elements is an error at ArrayEnd, rather than leaving defaults
 template<typename TVal, size_t NSize>
-struct ArrayConverter : public Functor<ErrorOr<TVal[NSize]>, const std::vector<TVal> & >
+struct TypeInfoFixedArray : public TypeInfoArray<TVal[NSize], TVal>
 {
-	virtual ErrorOr<TVal[NSize]> operator()(const std::vector<TVal> & in) override
+	using TArray = TVal[NSize];
+	using TBase = TypeInfoArray<TArray, TVal>;
+
+	TypeInfoFixedArray(HString name)
+		: TBase(
+			name,
+			static_cast<typename TBase::FBoundsCheck>([](TArray& obj, int index)
+			{
+				return index >= 0 && index < static_cast<int>(NSize);
+			}),
+			static_cast<typename TBase::FAt>([](TArray& obj, int index) -> TVal& { return obj[index]; }),
+			nullptr,
+			nullptr)
+	{ }
+
+	virtual bool PushBackDefault(byte* obj, DeserializationContext& context) const override
 	{
-		if (in.size() != NSize)
+		// the elements are already in place, so their PostLoad can still be deferred
+		std::size_t& count = context.Pending<std::size_t>(obj, this, false);
+		if (count >= NSize)
 		{
-			return Error("Fixed legnth array expects "
-				+ ToString(NSize)
-				+ " but was given "
-				+ ToString(in.size()));
+			Error(this->name + " was given more than " + std::to_string(NSize) + " elements").Log();
+			return false;
 		}
+		count++;
+		return true;
+	}
 
-		TVal ret[NSize];
-		for (int i = 0; i < NSize; ++i)
+	virtual bool ArrayEnd(byte* obj, DeserializationContext& context) const override
+	{
+		std::size_t* count = context.FindPending<std::size_t>(obj, this);
+		std::size_t given = count == nullptr ? 0 : *count;
+		context.ErasePending(obj, this);
+		if (given != NSize)
 		{
-			ret[i] = in[i];
+			Error(this->name + " expects " + std::to_string(NSize) + " elements but was given " + std::to_string(given)).Log();
+			return false;
 		}
-		return ret;
+		return true;
+	}
+
+	virtual bool Reserve(byte* obj, std::size_t size, DeserializationContext& context) const override
+	{
+		return size == NSize;
 	}
 };
 
@@ -61,85 +89,140 @@ struct TemplatedTypeInfo<TVal[NSize]>
 {
 	static TypeInfo* Get()
 	{
-		static ArrayConverter<TVal, NSize> converter;
-		static auto typeInfo = TypeInfoAs<TVal[NSize], std::vector<TVal> >(
-			GetTypeInfo<TVal>()->GetName() + "[" + ToString(NSize) + "]",
-			converter);
+		static TypeInfoFixedArray<TVal, NSize> typeInfo(
+			GetTypeInfo<TVal>()->GetName() + "[" + std::to_string(NSize) + "]");
 		return &typeInfo;
 	}
 };
 
-
 // this is to compensate for the fact that deserialization happens in-place right now
 // but that doesn't work for sets, which need to insert after the object has been constructred
-template <typename TVal>
-struct SetTypeInfoValueBuffer
+// so each element is deserialized into a value pending in the context, and inserted
+// when the next element begins or the array ends
+template<typename TVal>
+struct TypeInfoSet : public TypeInfoArray<std::unordered_set<TVal>, TVal>
 {
-	// one buffer slot per set
-	// rmf todo: @implement this is not threadsafe
-	static std::unordered_map<std::unordered_set<TVal>*, TVal*> current;
+	using TSet = std::unordered_set<TVal>;
+	using TBase = TypeInfoArray<TSet, TVal>;
 
-	static bool BoundsCheck(std::unordered_set<TVal>& obj, int index)
-	{
-		// only the pending item is valid for reflection access at the moment
-		bool isNextIndex = (index >= 0) && (obj.size() == index);
-		bool bufferHasValue = current.count(&obj) && current[&obj] != nullptr;
-		return isNextIndex && bufferHasValue;
-	}
+	TypeInfoSet(HString name)
+		: TBase(
+			name,
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			static_cast<typename TBase::FReserve>([](TSet& obj, std::size_t size)
+			{
+				obj.reserve(obj.size() + size);
+				return true;
+			}))
+	{ }
 
-	static TVal& At(std::unordered_set<TVal>& obj, int index)
+	// only the pending element can be reflected, duplicates don't grow the set
+	// so unlike other arrays the index can't be checked against the size
+	virtual ErrorOr<ReflectionObject> GetAtIndex(
+		byte* obj,
+		int index,
+		DeserializationContext& context) const override
 	{
-		// assume bounds check has already been performed
-		return *(current[&obj]);
+		TVal* pending = context.FindPending<TVal>(obj, this);
+		if (index < 0 || pending == nullptr)
+		{
+			return Error(ErrorCode::NoPendingElement, this->name, index);
+		}
+		return Reflect(*pending);
 	}
 
-	static bool PushBackDefault(std::unordered_set<TVal>& obj)
+	// elements have no stable index outside of deserialization, so paths can't address them
+	virtual TypeInfo* GetElementTypeInfo() const override { return nullptr; }
+	virtual byte* FindAtIndex(byte* obj, int index) const override { return nullptr; }
+
+	virtual bool PushBackDefault(byte* obj, DeserializationContext& context) const override
 	{
-		bool bufferHasValue = current.count(&obj) && current[&obj] != nullptr;
-		if (bufferHasValue)
+		TVal* pending = context.FindPending<TVal>(obj, this);
+		if (pending != nullptr)
 		{
-			obj.insert(*(current[&obj]));
-			*(current[&obj]) = TVal();
+			TSet* t = reinterpret_cast<TSet*>(obj);
+			t->insert(std::move(*pending));
+			*pending = TVal();
 		}
 		else
 		{
-			current[&obj] = new TVal();
+			context.Pending<TVal>(obj, this);
 		}
 		return true;
 	}
 
-	static bool ArrayEnd(std::unordered_set<TVal>& obj)
+	// elements are summed, so the hash doesn't depend on the order of the set
+	virtual std::uint64_t Hash(byte* obj) const override
+	{
+		TSet* t = reinterpret_cast<TSet*>(obj);
+		std::uint64_t sum = 0;
+		TypeInfo* valueTypeInfo = GetTypeInfo<TVal>();
+		for (const auto & value : *t)
+		{
+			sum += valueTypeInfo->Hash(reinterpret_cast<byte*>(const_cast<TVal*>(&value)));
+		}
+		return HashCombine(HashInt(t->size()), sum);
+	}
+
+	// matched by the reflected Hash, then the reflected Equal, so that Equal agrees with Hash
+	// each element of b can only match one of a
+	virtual bool Equal(byte* a, byte* b) const override
 	{
-		bool bufferHasObject = current.count(&obj);
-		bool bufferHasValue = bufferHasObject && current[&obj] != nullptr;
-		if (bufferHasValue)
+		TSet* tA = reinterpret_cast<TSet*>(a);
+		TSet* tB = reinterpret_cast<TSet*>(b);
+		if (tA->size() != tB->size()) return false;
+		TypeInfo* valueTypeInfo = GetTypeInfo<TVal>();
+		std::unordered_multimap<std::uint64_t, byte*> unmatched;
+		unmatched.reserve(tB->size());
+		for (const auto & value : *tB)
 		{
-			obj.insert(*(current[&obj]));
-			delete current[&obj];
+			byte* element = reinterpret_cast<byte*>(const_cast<TVal*>(&value));
+			unmatched.emplace(valueTypeInfo->Hash(element), element);
 		}
-		if (bufferHasObject)
+		for (const auto & value : *tA)
 		{
-			current.erase(&obj);
+			byte* element = reinterpret_cast<byte*>(const_cast<TVal*>(&value));
+			auto range = unmatched.equal_range(valueTypeInfo->Hash(element));
+			auto match = range.first;
+			while (match != range.second && !valueTypeInfo->Equal(element, match->second))
+			{
+				++match;
+			}
+			if (match == range.second) return false;
+			unmatched.erase(match);
 		}
 		return true;
 	}
-};
 
-template<typename TVal>
-std::unordered_map<std::unordered_set<TVal>*, TVal*> SetTypeInfoValueBuffer<TVal>::current;
+	// sets have no order to diff elements by
+	virtual ErrorOr<Success> Diff(byte* a, byte* b, Differ& differ) const override
+	{
+		return differ.Leaf(this, a, b);
+	}
+
+	virtual bool ArrayEnd(byte* obj, DeserializationContext& context) const override
+	{
+		TVal* pending = context.FindPending<TVal>(obj, this);
+		if (pending != nullptr)
+		{
+			TSet* t = reinterpret_cast<TSet*>(obj);
+			t->insert(std::move(*pending));
+			context.ErasePending(obj, this);
+		}
+		return true;
+	}
+};
 
 template<typename TVal>
 struct TemplatedTypeInfo<std::unordered_set<TVal> >
 {
 	static TypeInfo* Get()
 	{
-		static auto setTypeInfo = TypeInfoArray<std::unordered_set<TVal>, TVal>(
-			HString("std::unordered_set<" + Reflection::GetTypeInfo<TVal>()->GetName() + ">"),
-			SetTypeInfoValueBuffer<TVal>::BoundsCheck,
-			SetTypeInfoValueBuffer<TVal>::At,
-			SetTypeInfoValueBuffer<TVal>::PushBackDefault,
-			SetTypeInfoValueBuffer<TVal>::ArrayEnd
-		);
+		static TypeInfoSet<TVal> setTypeInfo(
+			HString("std::unordered_set<" + Reflection::GetTypeInfo<TVal>()->GetName() + ">"));
 
 		return &setTypeInfo;
 	}
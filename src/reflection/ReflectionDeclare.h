@@ -1,13 +1,17 @@
 #ifndef FARB_REFLECTION_DECLARE_H
 #define FARB_REFLECTION_DECLARE_H
 
+#include <cstdint>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 #include <experimental/type_traits>
 
 #include "../core/BuiltinTypedefs.h"
 #include "../core/ErrorOr.hpp"
+#include "../serialization/Writer.h"
+#include "ReflectionStats.h"
 
 namespace Farb
 {
@@ -15,11 +19,36 @@ namespace Farb
 namespace Reflection
 {
 
-// this is not a strict limit
-// we will wrap after reaching 100 characters and finishing the current serialization
-constexpr int SerializationLineLengthTarget = 100;
-
 struct TypeInfo;
+struct MemberLookupTable;
+struct SchemaHash;
+class DeserializationContext;
+class Differ;
+
+// the value types that can be assigned through reflection
+// these are the only value types produced by deserialization
+enum class PrimitiveKind
+{
+	Bool,
+	UInt,
+	Int,
+	Float,
+	String,
+	Count
+};
+
+template<typename TArg>
+struct PrimitiveKindOf
+{
+	static_assert(sizeof(TArg) == 0,
+		"Reflection can only assign values of type bool, uint, int, float, or std::string");
+};
+
+template<> struct PrimitiveKindOf<bool> { static constexpr PrimitiveKind value = PrimitiveKind::Bool; };
+template<> struct PrimitiveKindOf<uint> { static constexpr PrimitiveKind value = PrimitiveKind::UInt; };
+template<> struct PrimitiveKindOf<int> { static constexpr PrimitiveKind value = PrimitiveKind::Int; };
+template<> struct PrimitiveKindOf<float> { static constexpr PrimitiveKind value = PrimitiveKind::Float; };
+template<> struct PrimitiveKindOf<std::string> { static constexpr PrimitiveKind value = PrimitiveKind::String; };
 
 struct ReflectionObject
 {
@@ -27,22 +56,32 @@ struct ReflectionObject
 
 	byte* location;
 	TypeInfo* typeInfo;
+	// where pending values are kept while deserializing, shared with every child
+	// nullptr uses the default context of the calling thread
+	DeserializationContext* context;
 
 	ReflectionObject()
 		: location(nullptr)
 		, typeInfo(nullptr)
+		, context(nullptr)
 	{ }
 
-	ReflectionObject(byte* location, TypeInfo* typeInfo)
+	ReflectionObject(byte* location, TypeInfo* typeInfo, DeserializationContext* context = nullptr)
 		: location(location)
 		, typeInfo(typeInfo)
+		, context(context)
 	{ }
 
 	ReflectionObject(const ReflectionObject& other)
 		: location(other.location)
 		, typeInfo(other.typeInfo)
+		, context(other.context)
 	{ }
 
+	ReflectionObject& operator=(const ReflectionObject& other) = default;
+
+	DeserializationContext& GetContext() const;
+
 	// rmf note: should these be const if they modify the values?
 	// even though it doesn't change the direct member
 	// it does change the value at location
@@ -53,15 +92,25 @@ struct ReflectionObject
 	bool AssignFloat(float value) const;
 	bool AssignString(std::string value) const;
 
+	// calls the Assign function matching the PrimitiveKind of TArg
+	template<typename TArg>
+	bool Assign(TArg value) const;
+
 	ErrorOr<ReflectionObject> GetAtKey(HString name) const;
 	bool InsertKey(HString name) const;
+	// gets and inserts by keys that aren't interned, see TypeInfo::InsertTextKey
+	ErrorOr<ReflectionObject> GetAtTextKey(std::string_view key) const;
+	ErrorOr<ReflectionObject> InsertTextKey(std::string_view key) const;
 	bool ObjectEnd() const;
 
 	ErrorOr<ReflectionObject> GetAtIndex(int index) const;
 	bool PushBackDefault() const;
 	bool ArrayEnd() const;
+	bool Reserve(std::size_t size) const;
 
-	ErrorOr<std::string> ToString(std::string indentation = "") const;
+	ErrorOr<Success> Serialize(Writer& writer) const;
+	// pretty printed JSON
+	ErrorOr<std::string> ToString() const;
 };
 
 struct TypeInfo
@@ -72,44 +121,320 @@ protected:
 
 public:
 	TypeInfo(HString name)
-		: name(name)
+		: name(name.Interned())
 	{ }
 
 	const HString& GetName() const { return name; }
 
-	virtual bool AssignBool(byte* obj, bool value) const { return false; }
-	virtual bool AssignUInt(byte* obj, uint value) const { return false; }
-	virtual bool AssignInt(byte* obj, int value) const { return false; }
-	virtual bool AssignFloat(byte* obj, float value) const { return false; }
-	virtual bool AssignString(byte* obj, std::string value) const { return false; }
+	// every function that modifies obj during deserialization is given the context
+	// of the parse, so types that can't be deserialized in place keep their state there
+	virtual bool AssignBool(byte* obj, bool value, DeserializationContext& context) const { return false; }
+	virtual bool AssignUInt(byte* obj, uint value, DeserializationContext& context) const { return false; }
+	virtual bool AssignInt(byte* obj, int value, DeserializationContext& context) const { return false; }
+	virtual bool AssignFloat(byte* obj, float value, DeserializationContext& context) const { return false; }
+	virtual bool AssignString(byte* obj, std::string value, DeserializationContext& context) const { return false; }
+
+	// arrays of primitives are appended to directly by the parser, rather than reflecting
+	// a default element and assigning it, which takes several virtual calls per value
+	virtual bool AppendsPrimitives() const { return false; }
+	virtual bool AppendBool(byte* obj, bool value) const { return false; }
+	virtual bool AppendUInt(byte* obj, uint value) const { return false; }
+	virtual bool AppendInt(byte* obj, int value) const { return false; }
+	virtual bool AppendFloat(byte* obj, float value) const { return false; }
+	virtual bool AppendString(byte* obj, std::string value) const { return false; }
 
 	virtual ErrorOr<ReflectionObject> GetAtKey(
 		byte* obj,
-		HString name) const
+		HString name,
+		DeserializationContext& context) const
 	{
-		return Error(name + " GetAtKey not impelmented.");
+		return Error(ErrorCode::NotImplemented, name, "GetAtKey");
 	}
 
-	virtual bool InsertKey(byte* obj, HString name) const { return false; }
+	virtual bool InsertKey(byte* obj, HString name, DeserializationContext& context) const { return false; }
+	// inserts a key read from a document as text, and returns its value
+	// keys that aren't in the HString pool are rejected without growing it, which is right
+	// for struct members, since they're interned when they are registered
+	// types that construct their entries from keys override this
+	virtual ErrorOr<ReflectionObject> InsertTextKey(
+		byte* obj,
+		std::string_view key,
+		DeserializationContext& context) const;
+	// looks a key up the same way, without inserting it
+	virtual ErrorOr<ReflectionObject> GetAtTextKey(
+		byte* obj,
+		std::string_view key,
+		DeserializationContext& context) const;
 
 	virtual ErrorOr<ReflectionObject> GetAtIndex(
 		byte* obj,
-		int index) const
+		int index,
+		DeserializationContext& context) const
 	{
-		return Error(name + " GetAtIndex not impelmented.");
+		return Error(ErrorCode::NotImplemented, name, "GetAtIndex");
 	}
 	// rmf todo: why did I want this one to be true?
-	virtual bool ObjectEnd(byte* obj) const { return true; }
+	virtual bool ObjectEnd(byte* obj, DeserializationContext& context) const { return true; }
+	// the hook ObjectEnd runs once a struct is deserialized, unless the context defers it
+	virtual bool PostLoad(byte* obj) const { return true; }
+	// false when ObjectEnd has nothing to run for a struct
+	virtual bool HasPostLoad() const { return false; }
+
+	virtual bool PushBackDefault(byte* obj, DeserializationContext& context) const { return false; }
+	virtual bool ArrayEnd(byte* obj, DeserializationContext& context) const { return false; }
+	// a hint that size elements are about to be pushed back
+	virtual bool Reserve(byte* obj, std::size_t size, DeserializationContext& context) const { return true; }
+	// empties containers, so a value can be deserialized over an existing one
+	// rather than appended to it
+	virtual bool Clear(byte* obj) const { return true; }
+
+	// only types with named members have a lookup table
+	virtual const MemberLookupTable* GetMemberLookupTable() const { return nullptr; }
+
+	// used by Path, which resolves names and types once and then only needs addresses
+	// the offset and type of a member of a struct, including inherited members
+	virtual bool FindMember(const HString& name, std::size_t& offset, TypeInfo*& typeInfo) const { return false; }
+	// the type of every element of an array, or every value of a table
+	virtual TypeInfo* GetElementTypeInfo() const { return nullptr; }
+	virtual TypeInfo* GetValueTypeInfo() const { return nullptr; }
+	// the address of an element or value, nullptr without building an error if there is none
+	virtual byte* FindAtIndex(byte* obj, int index) const { return nullptr; }
+	virtual byte* FindAtKey(byte* obj, const HString& key) const { return nullptr; }
+
+	virtual ErrorOr<Success> Serialize(byte* obj, Writer& writer) const
+	{
+		return Error(ErrorCode::NotImplemented, name, "Serialize");
+	}
+
+	// writes the members of a struct without the enclosing object
+	// so derived structs can include the members of their parent type
+	virtual ErrorOr<Success> SerializeMembers(byte* obj, Writer& writer) const
+	{
+		return Error(name + " is not a struct and has no members to serialize");
+	}
+
+	// structural hash and equality over everything that is serialized
+	// types that don't override these compare their serialized forms
+	virtual std::uint64_t Hash(byte* obj) const;
+	virtual bool Equal(byte* a, byte* b) const;
+
+	// records the changes from a to b, see ReflectionDiff.h
+	// types that don't override this are compared as a whole
+	virtual ErrorOr<Success> Diff(byte* a, byte* b, Differ& differ) const;
+	// diffs the member at index of a struct, which is already pushed onto differ's path
+	// skipped the same way SerializeMembers skips it
+	virtual ErrorOr<Success> DiffMember(byte* a, byte* b, int index, Differ& differ) const
+	{
+		return Error(name + " is not a struct and has no members to diff");
+	}
+
+	// combines everything that affects the serialized form of this type
+	// types that contain other types should Include them
+	virtual void HashSchema(SchemaHash& hash) const;
+};
+
+// a hash of the serialized layout of a type and every type it contains
+// stored with binary data so data written for a different version of a type is rejected
+struct SchemaHash
+{
+	std::uint64_t value = 14695981039346656037ull;
+	// types that have been hashed, so recursive types terminate
+	std::vector<const TypeInfo*> visited;
+
+	void Combine(std::uint64_t part)
+	{
+		// boost::hash_combine, widened to 64 bits
+		value ^= part + 0x9E3779B97F4A7C15ull + (value << 6) + (value >> 2);
+	}
+
+	void Combine(const HString& part)
+	{
+		Combine(static_cast<std::uint64_t>(part.GetHash()));
+	}
+
+	void Include(const TypeInfo* typeInfo)
+	{
+		for (auto pVisited : visited)
+		{
+			if (pVisited == typeInfo)
+			{
+				// only a reference by name, the contents are already hashed
+				Combine(typeInfo->GetName());
+				return;
+			}
+		}
+		visited.push_back(typeInfo);
+		typeInfo->HashSchema(*this);
+	}
+};
+
+inline void TypeInfo::HashSchema(SchemaHash& hash) const
+{
+	hash.Combine(name);
+}
+
+inline ErrorOr<ReflectionObject> TypeInfo::InsertTextKey(
+	byte* obj,
+	std::string_view key,
+	DeserializationContext& context) const
+{
+	HString found = HString::Find(key);
+	if (found.Empty() || !InsertKey(obj, found, context))
+	{
+		return Error(name + " has no member named " + std::string(key));
+	}
+	return GetAtKey(obj, found, context);
+}
 
-	virtual bool PushBackDefault(byte* obj) const { return false; }
-	virtual bool ArrayEnd(byte* obj) const { return false; }
+inline ErrorOr<ReflectionObject> TypeInfo::GetAtTextKey(
+	byte* obj,
+	std::string_view key,
+	DeserializationContext& context) const
+{
+	HString found = HString::Find(key);
+	if (found.Empty())
+	{
+		return Error(name + " has no key " + std::string(key));
+	}
+	return GetAtKey(obj, found, context);
+}
+
+// state for a single deserialization that can't live in the object being deserialized
+// i.e. values that are converted or inserted into their owner once they are complete
+// each parse has its own, so separate parses can run concurrently on different threads
+class DeserializationContext
+{
+public:
+	DeserializationContext()
+		: pending()
+		, recycled()
+		, detachedCount(0)
+		, deferPostLoad(false)
+		, deferredPostLoads()
+	{ }
 
-	virtual ErrorOr<std::string> ToString(byte* obj, std::string indentation = "") const
+	// including values left pending by a parse that failed part way through
+	~DeserializationContext()
 	{
-		return Error(name + " ToString not implemented");
+		for (auto & value : pending)
+		{
+			value.pDelete(value.value);
+		}
+		for (auto & value : recycled)
+		{
+			value.pDelete(value.value);
+		}
 	}
+
+	DeserializationContext(const DeserializationContext& other) = delete;
+	DeserializationContext& operator=(const DeserializationContext& other) = delete;
+
+	// used by ReflectionObjects that weren't given a context
+	static DeserializationContext& ThreadDefault();
+
+	// the value pending for owner, default constructed on first use
+	// storage released by ErasePending is reused, so a parse only allocates
+	// as many pending values of each type as are ever pending at once
+	// detached is false for bookkeeping like a count, that doesn't hold the objects
+	// being deserialized, so it doesn't stop PostLoad being deferred
+	template<typename T>
+	T& Pending(const void* owner, const TypeInfo* typeInfo, bool detached = true)
+	{
+		T* existing = FindPending<T>(owner, typeInfo);
+		if (existing != nullptr) return *existing;
+		for (auto iter = recycled.rbegin(); iter != recycled.rend(); ++iter)
+		{
+			if (iter->typeInfo == typeInfo)
+			{
+				PendingValue value = *iter;
+				recycled.erase(std::next(iter).base());
+				*static_cast<Holder<T>*>(value.value) = Holder<T>();
+				value.owner = owner;
+				value.detached = detached;
+				if (detached) ++detachedCount;
+				pending.push_back(value);
+				return static_cast<Holder<T>*>(value.value)->value;
+			}
+		}
+		Holder<T>* holder = new Holder<T>();
+		if (detached) ++detachedCount;
+		pending.push_back(PendingValue{
+			owner,
+			typeInfo,
+			holder,
+			[](void* value) { delete static_cast<Holder<T>*>(value); },
+			detached
+		});
+		return holder->value;
+	}
+
+	template<typename T>
+	T* FindPending(const void* owner, const TypeInfo* typeInfo)
+	{
+		// pending values nest, so the one we want is almost always the last
+		for (auto iter = pending.rbegin(); iter != pending.rend(); ++iter)
+		{
+			if (iter->owner == owner && iter->typeInfo == typeInfo)
+			{
+				return &static_cast<Holder<T>*>(iter->value)->value;
+			}
+		}
+		return nullptr;
+	}
+
+	void ErasePending(const void* owner, const TypeInfo* typeInfo)
+	{
+		for (auto iter = pending.rbegin(); iter != pending.rend(); ++iter)
+		{
+			if (iter->owner == owner && iter->typeInfo == typeInfo)
+			{
+				if (iter->detached) --detachedCount;
+				recycled.push_back(*iter);
+				pending.erase(std::next(iter).base());
+				return;
+			}
+		}
+	}
+
+	std::size_t PendingCount() const { return pending.size(); }
+
+	// set while a parse queues PostLoad hooks to run later, on another thread
+	void SetDeferPostLoad(bool defer) { deferPostLoad = defer; }
+	// objects inside a detached pending value, like the element of a set,
+	// don't have their final address yet, so they never defer
+	bool DefersPostLoad() const { return deferPostLoad && detachedCount == 0; }
+	void DeferPostLoad(const TypeInfo* typeInfo) { deferredPostLoads.push_back(typeInfo); }
+	// the parser moves these into its queue as each object ends
+	std::vector<const TypeInfo*>& DeferredPostLoads() { return deferredPostLoads; }
+
+private:
+	// so arrays can be pending too
+	template<typename T>
+	struct Holder
+	{
+		T value{};
+	};
+
+	struct PendingValue
+	{
+		const void* owner;
+		const TypeInfo* typeInfo;
+		void* value;
+		void (*pDelete)(void*);
+		bool detached;
+	};
+
+	std::vector<PendingValue> pending;
+	std::vector<PendingValue> recycled;
+	// how many of pending are detached
+	std::size_t detachedCount;
+	bool deferPostLoad;
+	std::vector<const TypeInfo*> deferredPostLoads;
 };
 
+// cached per TypeInfo, types can't change after they are registered
+std::uint64_t GetSchemaHash(const TypeInfo* typeInfo);
+
 /*
 // helper for defining something when template arguments resolve correctly
 // and therefore also being able to use sfinae when they don't
@@ -160,6 +485,58 @@ TypeInfo* GetTypeInfo()
 	}
 }
 
+// the byte offset of a member within T, like offsetof but from a member pointer
+template<typename T, typename TMem>
+std::size_t MemberOffset(TMem T::* location)
+{
+	alignas(T) static const char storage[sizeof(T)] = { };
+	const T* object = reinterpret_cast<const T*>(storage);
+	return reinterpret_cast<const char*>(&(object->*location)) - storage;
+}
+
+// a member declared at compile time, so that it can be visited without TypeInfo
+// types opt in by declaring
+// static constexpr auto GetStaticMembers() { return std::make_tuple(MakeStaticMember(...), ...); }
+// see ReflectionStatic.hpp for the TypeInfo and ToString derived from them
+template<typename T, typename TMem>
+struct StaticMember
+{
+	using Type = TMem;
+
+	HString name;
+	TMem T::* location;
+	bool (*pShouldSkipSerialization)(const TMem&);
+};
+
+template<typename T, typename TMem>
+constexpr StaticMember<T, TMem> MakeStaticMember(
+	HString name,
+	TMem T::* location,
+	bool (*pShouldSkipSerialization)(const TMem&) = nullptr)
+{
+	return StaticMember<T, TMem>{name, location, pShouldSkipSerialization};
+}
+
+// for pShouldSkipSerialization of members that may be left unspecified
+// and can't be deserialized in their default state
+template<typename TMem>
+bool SkipUnlessDefined(const TMem& member)
+{
+	return !member.Defined();
+}
+
+template<typename TMem>
+bool SkipIfEmpty(const TMem& member)
+{
+	return member.empty();
+}
+
+template <class T, typename = void>
+struct has_GetStaticMembers : std::false_type {};
+
+template<typename T>
+struct has_GetStaticMembers<T, void_t<decltype(T::GetStaticMembers())> > : std::true_type {};
+
 template <class T, typename = void>
 struct has_GetInstanceTypeInfo : std::false_type {};
 
@@ -189,78 +566,191 @@ inline ReflectionObject Reflect(T& object)
 }
 
 template<typename T>
-inline std::string ToString(const T& obj, std::string indentation = "")
+inline ReflectionObject Reflect(T& object, DeserializationContext& context)
+{
+	return ReflectionObject(
+		reinterpret_cast<byte*>(&object),
+		GetTypeInfo(object),
+		&context);
+}
+
+template<typename T>
+inline std::string ToString(const T& obj)
 {
 	// casting away const should be fine here because
 	// ToString and GetName both do not modify the underlying value
 	auto reflect = Reflect(const_cast<T&>(obj));
-	auto result = reflect.ToString(indentation);
+	auto result = reflect.ToString();
 	if (result.IsError())
 	{
 		// rmf todo: log error
-		return "Uknown value of type " + reflect.typeInfo->GetName() + " with error " + result.GetError().message;
+		return "Uknown value of type " + reflect.typeInfo->GetName() + " with error " + result.GetError().Message();
 	}
-	return result.GetValue();
+	return std::move(result).GetValue();
+}
+
+// a hash of every serialized member, for cache keys and finding duplicates
+// it isn't stable between versions, so it shouldn't be stored
+template<typename T>
+inline std::uint64_t Hash(const T& obj)
+{
+	auto reflect = Reflect(const_cast<T&>(obj));
+	return reflect.typeInfo->Hash(reflect.location);
+}
+
+// true if every serialized member of a and b is equal
+template<typename T>
+inline bool Equal(const T& a, const T& b)
+{
+	auto reflectA = Reflect(const_cast<T&>(a));
+	auto reflectB = Reflect(const_cast<T&>(b));
+	return reflectA.typeInfo == reflectB.typeInfo
+		&& reflectA.typeInfo->Equal(reflectA.location, reflectB.location);
+}
+
+inline DeserializationContext& ReflectionObject::GetContext() const
+{
+	return context != nullptr ? *context : DeserializationContext::ThreadDefault();
 }
 
 inline bool ReflectionObject::AssignBool(bool value) const
 {
-	return typeInfo->AssignBool(location, value);
+	FARB_STAT(typeInfo, assigns, 1);
+	return typeInfo->AssignBool(location, value, GetContext());
 }
 
 inline bool ReflectionObject::AssignUInt(uint value) const
 {
-	return typeInfo->AssignUInt(location, value);
+	FARB_STAT(typeInfo, assigns, 1);
+	return typeInfo->AssignUInt(location, value, GetContext());
 }
 
 inline bool ReflectionObject::AssignInt(int value) const
 {
-	return typeInfo->AssignInt(location, value);
+	FARB_STAT(typeInfo, assigns, 1);
+	return typeInfo->AssignInt(location, value, GetContext());
 }
 
 inline bool ReflectionObject::AssignFloat(float value) const
 {
-	return typeInfo->AssignFloat(location, value);
+	FARB_STAT(typeInfo, assigns, 1);
+	return typeInfo->AssignFloat(location, value, GetContext());
 }
 
 inline bool ReflectionObject::AssignString(std::string value) const
 {
-	return typeInfo->AssignString(location, value);
+	FARB_STAT(typeInfo, assigns, 1);
+	FARB_STAT(typeInfo, stringBytes, value.size());
+	return typeInfo->AssignString(location, std::move(value), GetContext());
+}
+
+template<typename TArg>
+inline bool ReflectionObject::Assign(TArg value) const
+{
+	constexpr PrimitiveKind kind = PrimitiveKindOf<TArg>::value;
+	if constexpr (kind == PrimitiveKind::Bool) return AssignBool(value);
+	else if constexpr (kind == PrimitiveKind::UInt) return AssignUInt(value);
+	else if constexpr (kind == PrimitiveKind::Int) return AssignInt(value);
+	else if constexpr (kind == PrimitiveKind::Float) return AssignFloat(value);
+	else return AssignString(value);
 }
 
+// children share the context of their parent
 inline ErrorOr<ReflectionObject> ReflectionObject::GetAtKey(HString name) const
 {
-	return typeInfo->GetAtKey(location, name);
+	FARB_STAT(typeInfo, keyLookups, 1);
+	auto result = typeInfo->GetAtKey(location, name, GetContext());
+	if (result.IsError())
+	{
+		FARB_STAT(typeInfo, failedLookups, 1);
+		return result.GetError();
+	}
+	ReflectionObject child = result.GetValue();
+	child.context = context;
+	return child;
 }
 
+// counted as a lookup, since structs look the key up to check that it exists
 inline bool ReflectionObject::InsertKey(HString name) const
 {
-	return typeInfo->InsertKey(location, name);
+	FARB_STAT(typeInfo, keyLookups, 1);
+	bool success = typeInfo->InsertKey(location, name, GetContext());
+	if (!success) FARB_STAT(typeInfo, failedLookups, 1);
+	return success;
+}
+
+inline ErrorOr<ReflectionObject> ReflectionObject::GetAtTextKey(std::string_view key) const
+{
+	FARB_STAT(typeInfo, keyLookups, 1);
+	auto result = typeInfo->GetAtTextKey(location, key, GetContext());
+	if (result.IsError())
+	{
+		FARB_STAT(typeInfo, failedLookups, 1);
+		return result.GetError();
+	}
+	ReflectionObject child = result.GetValue();
+	child.context = context;
+	return child;
+}
+
+inline ErrorOr<ReflectionObject> ReflectionObject::InsertTextKey(std::string_view key) const
+{
+	FARB_STAT(typeInfo, keyLookups, 1);
+	auto result = typeInfo->InsertTextKey(location, key, GetContext());
+	if (result.IsError())
+	{
+		FARB_STAT(typeInfo, failedLookups, 1);
+		return result.GetError();
+	}
+	ReflectionObject child = result.GetValue();
+	child.context = context;
+	return child;
 }
 
 inline ErrorOr<ReflectionObject> ReflectionObject::GetAtIndex(int index) const
 {
-	return typeInfo->GetAtIndex(location, index);
+	auto result = typeInfo->GetAtIndex(location, index, GetContext());
+	if (result.IsError())
+	{
+		FARB_STAT(typeInfo, failedLookups, 1);
+		return result.GetError();
+	}
+	ReflectionObject child = result.GetValue();
+	child.context = context;
+	return child;
 }
 
 inline bool ReflectionObject::ObjectEnd() const
 {
-	 return typeInfo->ObjectEnd(location);
+	 return typeInfo->ObjectEnd(location, GetContext());
 }
 
 inline bool ReflectionObject::PushBackDefault() const
 {
-	return typeInfo->PushBackDefault(location);
+	return typeInfo->PushBackDefault(location, GetContext());
 }
 
 inline bool ReflectionObject::ArrayEnd() const
 {
-	return typeInfo->ArrayEnd(location);
+	return typeInfo->ArrayEnd(location, GetContext());
+}
+
+inline bool ReflectionObject::Reserve(std::size_t size) const
+{
+	return typeInfo->Reserve(location, size, GetContext());
+}
+
+inline ErrorOr<Success> ReflectionObject::Serialize(Writer& writer) const
+{
+	return typeInfo->Serialize(location, writer);
 }
 
-inline ErrorOr<std::string> ReflectionObject::ToString(std::string indentation /* = "" */) const
+inline ErrorOr<std::string> ReflectionObject::ToString() const
 {
-	return typeInfo->ToString(location, indentation);
+	std::string ret;
+	JsonWriter writer(ret, JsonWriter::Mode::Pretty);
+	CHECK_RETURN(Serialize(writer));
+	return ret;
 }
 
 } // namespace Reflection
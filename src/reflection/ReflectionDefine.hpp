@@ -1,17 +1,23 @@
 #ifndef FARB_REFLECTION_DEFINE_H
 #define FARB_REFLECTION_DEFINE_H
 
+#include <cstdint>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <iostream>
+#include <iterator>
 #include <limits.h>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 
+#include "../utils/HashExtensions.hpp"
 #include "../utils/MapReduce.hpp"
 #include "../utils/TypeInspection.hpp"
 #include "ReflectionDeclare.h"
+#include "ReflectionDiff.h"
 
 namespace Farb
 {
@@ -19,245 +25,192 @@ namespace Farb
 namespace Reflection
 {
 
-template<typename T>
-struct AssignFunction
-{
-	template<typename TArg>
-	bool Call(T& object, TArg value) const;
-
-	virtual ~AssignFunction() = default;
-};
-
-template<typename T, typename TArg>
-struct AssignFunctionTyped : public AssignFunction<T>
-{
-	static_assert(
-		std::is_same<TArg, bool>::value
-		|| std::is_same<TArg, uint>::value
-		|| std::is_same<TArg, int>::value
-		|| std::is_same<TArg, float>::value
-		|| std::is_same<TArg, std::string>::value,
-		"AssignFunctionTyped can only accept values of type bool, uint, int, float, or std::string");
-	friend struct AssignFunction<T>;
-protected:
-	bool (*pAssign)(T&, TArg);
-
-public:
-	AssignFunctionTyped(bool (*pAssign)(T&, TArg))
-		: pAssign(pAssign)
-	{ }
-};
-
-template<typename T, typename TArg>
-struct AssignFunctionTypedMember : public AssignFunction<T>
-{
-	static_assert(
-		std::is_same<TArg, bool>::value
-		|| std::is_same<TArg, uint>::value
-		|| std::is_same<TArg, int>::value
-		|| std::is_same<TArg, float>::value
-		|| std::is_same<TArg, std::string>::value,
-		"AssignFunctionTypedMember can only accept values of type bool, uint, int, float, or std::string");
-	friend struct AssignFunction<T>;
-protected:
-	bool (T::*pAssign)(TArg);
-
-public:
-	AssignFunctionTypedMember(bool (T::*pAssign)(T&, TArg))
-		: pAssign(pAssign)
-	{ }
-};
-
-template<typename T>
-template<typename TArg>
-bool AssignFunction<T>::Call(T& object, TArg value) const
-{
-	if constexpr (!std::is_fundamental<T>::value)
-	{
-		auto pAssignMemberWrapper = dynamic_cast<const AssignFunctionTypedMember<T, TArg>*>(this);
-		if (pAssignMemberWrapper != nullptr)
-		{
-			auto pAssignMember = pAssignMemberWrapper->pAssign;
-			return (object.*pAssignMember)(value);
-		}
-	}
-	auto pAssignWrapper = dynamic_cast<const AssignFunctionTyped<T, TArg>*>(this);
-	if (pAssignWrapper != nullptr)
-	{
-		return pAssignWrapper->pAssign(object, value);
-	}
-	return false;
-}
-
 template<typename T>
 struct TypeInfoCustomLeaf : public TypeInfo
 {
 protected:
-	std::unordered_map<std::string, std::shared_ptr<AssignFunction <T> > > tpAssignFunctions;
-
-	std::string (*pToString)(const T&, std::string);
+	// one slot per PrimitiveKind, nullptr if this type can't be assigned from that kind
+	std::tuple<
+		bool (*)(T&, bool),
+		bool (*)(T&, uint),
+		bool (*)(T&, int),
+		bool (*)(T&, float),
+		bool (*)(T&, std::string)
+	> assignFunctions;
+
+	// not needed for bool, numbers, and strings, which are written directly
+	ErrorOr<Success> (*pSerialize)(const T&, Writer&);
+	// optional, also not needed for bool, numbers, and strings
+	std::uint64_t (*pHash)(const T&);
+	bool (*pEqual)(const T&, const T&);
 
 public:
 	template <typename ... TArgs>
-	static TypeInfoCustomLeaf Construct(HString name, std::string (*pToString)(const T&, std::string),TArgs ... args)
+	static TypeInfoCustomLeaf Construct(HString name, ErrorOr<Success> (*pSerialize)(const T&, Writer&), TArgs ... args)
 	{
 		auto leafTypeInfo = TypeInfoCustomLeaf(name);
-		leafTypeInfo.RegisterAssignFunctions(args...);
-		leafTypeInfo.pToString = pToString;
+		(leafTypeInfo.RegisterFunction(args), ...);
+		leafTypeInfo.pSerialize = pSerialize;
 		return leafTypeInfo;
 	}
 
-	virtual bool AssignBool(byte* obj, bool value) const override
+	virtual bool AssignBool(byte* obj, bool value, DeserializationContext& context) const override
 	{
 		return Assign(obj, value);
 	}
 
-	virtual bool AssignUInt(byte* obj, uint value) const override
+	virtual bool AssignUInt(byte* obj, uint value, DeserializationContext& context) const override
 	{
 		return Assign(obj, value);
 	}
 
-	virtual bool AssignInt(byte* obj, int value) const override
+	virtual bool AssignInt(byte* obj, int value, DeserializationContext& context) const override
 	{
 		return Assign(obj, value);
 	}
 
-	virtual bool AssignFloat(byte* obj, float value) const override
+	virtual bool AssignFloat(byte* obj, float value, DeserializationContext& context) const override
 	{
 		return Assign(obj, value);
 	}
 
-	virtual bool AssignString(byte* obj, std::string value) const override
+	virtual bool AssignString(byte* obj, std::string value, DeserializationContext& context) const override
 	{
-		return Assign(obj, value);
+		return Assign(obj, std::move(value));
 	}
 
-	virtual ErrorOr<std::string> ToString(byte* obj, std::string indentation = "") const override
+	virtual ErrorOr<Success> Serialize(byte* obj, Writer& writer) const override
 	{
 		T* t = reinterpret_cast<T*>(obj);
 		if constexpr(std::is_same<bool, T>::value)
 		{
-			bool b = static_cast<bool>(t);
-			return (b ? std::string("true") : std::string("false"));
+			writer.Bool(*t);
+			return Success();
+		}
+		else if constexpr(std::is_integral<T>::value && std::is_signed<T>::value)
+		{
+			writer.Int(*t);
+			return Success();
 		}
-		else if constexpr(std::is_integral<T>::value || std::is_floating_point<T>::value)
+		else if constexpr(std::is_integral<T>::value)
 		{
-			return std::to_string(*t);
+			writer.UInt(*t);
+			return Success();
+		}
+		else if constexpr(std::is_floating_point<T>::value)
+		{
+			writer.Float(*t);
+			return Success();
+		}
+		else if constexpr(std::is_same<std::string, T>::value || std::is_same<HString, T>::value)
+		{
+			writer.String(*t);
+			return Success();
+		}
+		else if (pSerialize != nullptr)
+		{
+			return pSerialize(*t, writer);
+		}
+		else
+		{
+			return Error(ErrorCode::NotImplemented, name, "Serialize");
+		}
+	}
+
+	virtual std::uint64_t Hash(byte* obj) const override
+	{
+		T* t = reinterpret_cast<T*>(obj);
+		if constexpr(std::is_floating_point<T>::value)
+		{
+			// 0 and -0 are equal, so they need the same hash
+			double value = *t == 0 ? 0.0 : static_cast<double>(*t);
+			std::uint64_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return HashInt(bits);
+		}
+		else if constexpr(std::is_arithmetic<T>::value)
+		{
+			return HashInt(static_cast<std::uint64_t>(*t));
 		}
 		else if constexpr(std::is_same<std::string, T>::value)
 		{
-			return *t;
+			return HashBytes(t->data(), t->size());
+		}
+		else if constexpr(std::is_same<HString, T>::value)
+		{
+			return HashInt(t->GetHash());
+		}
+		else if (pHash != nullptr)
+		{
+			return pHash(*t);
+		}
+		else
+		{
+			return TypeInfo::Hash(obj);
+		}
+	}
+
+	virtual bool Equal(byte* a, byte* b) const override
+	{
+		T* tA = reinterpret_cast<T*>(a);
+		T* tB = reinterpret_cast<T*>(b);
+		if constexpr(std::is_arithmetic<T>::value
+			|| std::is_same<std::string, T>::value
+			|| std::is_same<HString, T>::value)
+		{
+			return *tA == *tB;
 		}
-		else if (pToString != nullptr)
+		else if (pEqual != nullptr)
 		{
-			return pToString(*t, indentation);
+			return pEqual(*tA, *tB);
 		}
 		else
 		{
-			return Error(name + " ToString not implemented");
+			return TypeInfo::Equal(a, b);
 		}
 	}
 
 	template <typename TArg>
 	bool Assign(byte* obj, TArg value) const
 	{
-		auto typeName = GetTypeInfo<TArg>()->GetName();
-		const auto iter = tpAssignFunctions.find(typeName);
-		if (iter == tpAssignFunctions.end())
+		auto pAssign = std::get<static_cast<std::size_t>(PrimitiveKindOf<TArg>::value)>(assignFunctions);
+		if (pAssign == nullptr)
 		{
 			// we do not have an assign function that takes this type
 			return false;
 		}
 		T* t = reinterpret_cast<T*>(obj);
-		return iter->second->Call(*t, value);
+		return pAssign(*t, std::move(value));
 	}
 
 protected:
 	TypeInfoCustomLeaf(HString name)
 		: TypeInfo(name)
-		, tpAssignFunctions()
+		, assignFunctions()
+		, pSerialize(nullptr)
+		, pHash(nullptr)
+		, pEqual(nullptr)
 	{ }
 
 private:
-	template <typename TFunc>
-	void RegisterAssignFunctions(HString typeName, TFunc pAssign)
+	void RegisterFunction(std::uint64_t (*pHash)(const T&))
 	{
-		using TArg = typename ExtractFunctionTypes<TFunc>::Param;
-		if constexpr (ExtractFunctionTypes<TFunc>::IsMember::value)
-		{
-			using C = typename ExtractFunctionTypes<TFunc>::Class;
-			static_assert(
-				std::is_same<T, C>::value,
-				"member function for TypeInfoCustomLeaf belongs to another class");
-			tpAssignFunctions.emplace(
-				typeName,
-				new AssignFunctionTypedMember<T, TArg>(pAssign));
-		}
-		else
-		{
-			tpAssignFunctions.emplace(
-				typeName,
-				new AssignFunctionTyped<T, TArg>(pAssign));
-		}
+		this->pHash = pHash;
 	}
 
+	void RegisterFunction(bool (*pEqual)(const T&, const T&))
+	{
+		this->pEqual = pEqual;
+	}
 
-	// rmf note: this could cause a link lock if the types are interdependent
-	// so you can specify a type name to get around this
-	// see the overload that accepts an HString typeName
 	template <typename TFunc>
-	void RegisterAssignFunctions(TFunc pAssign)
+	void RegisterFunction(TFunc pAssign)
 	{
 		using TArg = typename ExtractFunctionTypes<TFunc>::Param;
-		/*
-		rmf todo: consider trying to evaluate whether this is safe
-		so that we can give a better error message than just a linker deadlock...
 		static_assert(
-			std::is_same<TArg, T>::value
-			|| std::is_same<T,
-			"assignment functions whose value type does not match the target type must specify the typename of their value");
-		*/
-		HString typeName = [&]
-		{
-			if constexpr(std::is_same<TArg, T>::value)
-			{
-				return name;
-			} else {
-				return GetTypeInfo<TArg>()->GetName();
-			}
-		}();
-
-		AssignFunction<T>* pAssignWrapper = [&]
-		{
-			if constexpr(ExtractFunctionTypes<TFunc>::IsMember::value)
-			{
-				using C = typename ExtractFunctionTypes<TFunc>::Class;
-				static_assert(
-					std::is_same<T, C>::value,
-					"member function for TypeInfoCustomLeaf belongs to another class");
-				return new AssignFunctionTypedMember<T, TArg>(pAssign);
-			}
-			else
-			{
-				return new AssignFunctionTyped<T, TArg>(pAssign);
-			}
-		}();
-		tpAssignFunctions.emplace(typeName, pAssignWrapper);
-	}
-
-
-	template <typename TFunc, typename ... Rest>
-	void RegisterAssignFunctions(HString typeName, TFunc pAssign, Rest ... rest)
-	{
-		RegisterAssignFunctions(typeName, pAssign);
-		RegisterAssignFunctions(rest...);
-	}
-
-	template <typename TFunc, typename ... Rest>
-	void RegisterAssignFunctions(TFunc pAssign, Rest ... rest)
-	{
-		RegisterAssignFunctions(pAssign);
-		RegisterAssignFunctions(rest...);
+			std::is_same<TFunc, bool (*)(T&, TArg)>::value,
+			"TypeInfoCustomLeaf assign functions must have the form bool (*)(T&, TArg)");
+		std::get<static_cast<std::size_t>(PrimitiveKindOf<TArg>::value)>(assignFunctions) = pAssign;
 	}
 };
 
@@ -273,10 +226,13 @@ public:
 		: TypeInfo(name)
 		, vValues(vEnumValues)
 	{
-
+		for (auto & pair : vValues)
+		{
+			pair.first = pair.first.Interned();
+		}
 	}
 
-	virtual bool AssignInt(byte* obj, int value) const override
+	virtual bool AssignInt(byte* obj, int value, DeserializationContext& context) const override
 	{
 		T* t = reinterpret_cast<T*>(obj);
 		for (const auto & pair : vValues)
@@ -290,18 +246,23 @@ public:
 		return false;
 	}
 
-	virtual bool AssignUInt(byte* obj, uint value) const override
+	virtual bool AssignUInt(byte* obj, uint value, DeserializationContext& context) const override
 	{
 		if (value > INT_MAX)
 		{
 			return false;
 		}
-		return AssignInt(obj, static_cast<int>(value));
+		return AssignInt(obj, static_cast<int>(value), context);
 	}
 
-	virtual bool AssignString(byte* obj, std::string value) const override
+	virtual bool AssignString(byte* obj, std::string value, DeserializationContext& context) const override
 	{
-		HString sValue = value;
+		// all of our value names are interned, so a string that was never interned can't match
+		HString sValue = HString::Find(value);
+		if (sValue.Empty())
+		{
+			return false;
+		}
 		T* t = reinterpret_cast<T*>(obj);
 		for (const auto & pair : vValues)
 		{
@@ -314,17 +275,54 @@ public:
 		return false;
 	}
 
-	virtual ErrorOr<std::string> ToString(byte* obj, std::string indentation = "") const override
+	virtual std::uint64_t Hash(byte* obj) const override
 	{
 		T* t = reinterpret_cast<T*>(obj);
+		return HashInt(static_cast<std::uint64_t>(*t));
+	}
+
+	virtual bool Equal(byte* a, byte* b) const override
+	{
+		return *reinterpret_cast<T*>(a) == *reinterpret_cast<T*>(b);
+	}
+
+	// the reflected name of value, or an empty HString if it isn't reflected
+	HString GetValueName(T value) const
+	{
 		for (const auto & pair : vValues)
 		{
-			if (static_cast<T>(pair.second) == *t)
+			if (static_cast<T>(pair.second) == value)
 			{
 				return pair.first;
 			}
 		}
-		return std::to_string(static_cast<int>(*t));
+		return HString();
+	}
+
+	virtual void HashSchema(SchemaHash& hash) const override
+	{
+		hash.Combine(name);
+		for (const auto & pair : vValues)
+		{
+			hash.Combine(pair.first);
+			hash.Combine(static_cast<std::uint64_t>(pair.second));
+		}
+	}
+
+	virtual ErrorOr<Success> Serialize(byte* obj, Writer& writer) const override
+	{
+		T* t = reinterpret_cast<T*>(obj);
+		HString valueName = GetValueName(*t);
+		if (!valueName.Empty())
+		{
+			writer.Enum(valueName, static_cast<int>(*t));
+		}
+		else
+		{
+			// values without a name can still be assigned back with AssignInt
+			writer.Int(static_cast<int>(*t));
+		}
+		return Success();
 	}
 };
 
@@ -338,8 +336,6 @@ public:
 // we could also consider having an alternative interface for copying values
 // rather than reflecting in place
 
-// should also consider fixed length arrays that can't use PushBackDefault
-
 
 template<typename T, typename TVal>
 struct TypeInfoArray : public TypeInfo
@@ -348,12 +344,14 @@ struct TypeInfoArray : public TypeInfo
 	using FAt = TVal& (*)(T& obj, int index);
 	using FPushBackDefault = bool (*)(T& obj);
 	using FArrayEnd = bool (*)(T&obj);
+	using FReserve = bool (*)(T& obj, std::size_t size);
 
 private:
 	FBoundsCheck pBoundsCheck;
 	FAt pAt;
 	FPushBackDefault pPushBackDefault;
 	FArrayEnd pArrayEnd;
+	FReserve pReserve;
 
 public:
 	TypeInfoArray(
@@ -361,12 +359,14 @@ public:
 		FBoundsCheck pBoundsCheck,
 		FAt pAt,
 		FPushBackDefault pPushBackDefault,
-		FArrayEnd pArrayEnd)
+		FArrayEnd pArrayEnd,
+		FReserve pReserve = nullptr)
 		: TypeInfo(name)
 		, pBoundsCheck(pBoundsCheck)
 		, pAt(pAt)
 		, pPushBackDefault(pPushBackDefault)
 		, pArrayEnd(pArrayEnd)
+		, pReserve(pReserve)
 	{ }
 
 	template<typename TDefaultInterfaceArray >
@@ -384,7 +384,12 @@ public:
 			}),
 			static_cast<FAt>([](T& obj, int index) -> TVal& { return obj[index]; }),
 			static_cast<FPushBackDefault>([](T& obj) { obj.push_back(TVal()); return true; }),
-			static_cast<FArrayEnd>([](T& obj) { return true; }));
+			static_cast<FArrayEnd>([](T& obj) { return true; }),
+			static_cast<FReserve>([](T& obj, std::size_t size)
+			{
+				obj.reserve(obj.size() + size);
+				return true;
+			}));
 	}
 
 	// rmf todo: @implement an array of pointers to objects that have derived types
@@ -394,71 +399,187 @@ public:
 	// but that logic should be in the deserialization, not in reflection
 	virtual ErrorOr<ReflectionObject> GetAtIndex(
 		byte* obj,
-		int index) const override
+		int index,
+		DeserializationContext& context) const override
 	{
 		T* t = reinterpret_cast<T*>(obj);
 		if (!pBoundsCheck(*t, index))
 		{
-			return Error(
-				name
-				+ " array GetAtIndex "
-				+ std::to_string(index)
-				+ " is out of bounds, "
-				+ std::to_string(t->size())
-				+ ".");
+			return Error(ErrorCode::IndexOutOfBounds, name, "array", index, std::size(*t));
 		}
 		return Reflect(pAt(*t, index));
 	}
 
-	virtual bool PushBackDefault(byte* obj) const override
+	// vectors of the types defined in ReflectionBasics.cpp, which are all TypeInfoCustomLeaf
+	static constexpr bool IsPrimitiveVector =
+		IsSpecialization<T, std::vector>::value
+		&& (std::is_same<TVal, bool>::value
+			|| std::is_same<TVal, char>::value
+			|| std::is_same<TVal, unsigned char>::value
+			|| std::is_same<TVal, uint>::value
+			|| std::is_same<TVal, int>::value
+			|| std::is_same<TVal, float>::value
+			|| std::is_same<TVal, std::string>::value);
+
+	virtual bool AppendsPrimitives() const override { return IsPrimitiveVector; }
+	virtual bool AppendBool(byte* obj, bool value) const override { return Append(obj, value); }
+	virtual bool AppendUInt(byte* obj, uint value) const override { return Append(obj, value); }
+	virtual bool AppendInt(byte* obj, int value) const override { return Append(obj, value); }
+	virtual bool AppendFloat(byte* obj, float value) const override { return Append(obj, value); }
+	virtual bool AppendString(byte* obj, std::string value) const override { return Append(obj, std::move(value)); }
+
+	// converts value the same way assigning it to an element would, without a virtual call
+	template<typename TArg>
+	bool Append(byte* obj, TArg value) const
+	{
+		if constexpr (IsPrimitiveVector)
+		{
+			static const auto leaf = static_cast<const TypeInfoCustomLeaf<TVal>*>(GetTypeInfo<TVal>());
+			TVal element{};
+			if (!leaf->Assign(reinterpret_cast<byte*>(&element), std::move(value))) return false;
+			reinterpret_cast<T*>(obj)->push_back(std::move(element));
+			return true;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	virtual TypeInfo* GetElementTypeInfo() const override
+	{
+		return GetTypeInfo<TVal>();
+	}
+
+	virtual byte* FindAtIndex(byte* obj, int index) const override
+	{
+		T* t = reinterpret_cast<T*>(obj);
+		if (!pBoundsCheck(*t, index)) return nullptr;
+		return reinterpret_cast<byte*>(&pAt(*t, index));
+	}
+
+	virtual bool PushBackDefault(byte* obj, DeserializationContext& context) const override
 	{
 		T* t = reinterpret_cast<T*>(obj);
 		return pPushBackDefault(*t);
 	}
 
-	virtual bool ArrayEnd(byte* obj) const override
+	virtual bool ArrayEnd(byte* obj, DeserializationContext& context) const override
 	{
 		if (pArrayEnd == nullptr) return true;
 		T* t = reinterpret_cast<T*>(obj);
 		return pArrayEnd(*t);
 	}
 
-	// rmf todo: indentation levels, and optionally removing all whitespace
-	// this is not the same as a serialization function
-	// though it's pretty close, so maybe that should be an option, too
-	// should only return error if ToString<TVal> returns an error
-	virtual ErrorOr<std::string> ToString(byte* obj, std::string indentation = "") const override
+	virtual bool Reserve(byte* obj, std::size_t size, DeserializationContext& context) const override
+	{
+		if (pReserve == nullptr) return true;
+		T* t = reinterpret_cast<T*>(obj);
+		return pReserve(*t, size);
+	}
+
+	virtual bool Clear(byte* obj) const override
+	{
+		// fixed arrays are always overwritten element by element
+		if constexpr (!std::is_array<T>::value)
+		{
+			T* t = reinterpret_cast<T*>(obj);
+			t->clear();
+		}
+		return true;
+	}
+
+	// integers and enums are compared as raw bytes, when they are stored contiguously
+	static constexpr bool IsContiguousBytes =
+		(std::is_array<T>::value
+			|| (IsSpecialization<T, std::vector>::value && !std::is_same<TVal, bool>::value))
+		&& (std::is_integral<TVal>::value || std::is_enum<TVal>::value);
+
+	virtual std::uint64_t Hash(byte* obj) const override
 	{
-		std::string ret;
-		std::string line = "[ ";
-		line.reserve(SerializationLineLengthTarget * 2);
 		T* t = reinterpret_cast<T*>(obj);
-		indentation += "\t";
-		for (int index = 0; pBoundsCheck(*t, index); ++index)
+		if constexpr (IsContiguousBytes)
 		{
-			TVal & value = pAt(*t, index);
-			line += CHECK_RETURN(Reflect(value).ToString(indentation)) + ", ";
-			if (line.size() > SerializationLineLengthTarget)
+			return HashBytes(std::data(*t), std::size(*t) * sizeof(TVal));
+		}
+		else
+		{
+			std::uint64_t hash = HashInt(std::size(*t));
+			TypeInfo* valueTypeInfo = GetTypeInfo<TVal>();
+			for (const auto & value : *t)
 			{
-				ret += line + "\n" + indentation;
-				line = "";
+				hash = HashCombine(hash, valueTypeInfo->Hash(reinterpret_cast<byte*>(const_cast<TVal*>(&value))));
 			}
+			return hash;
 		}
-		indentation.pop_back();
-		if (line.size() == 0)
+	}
+
+	virtual bool Equal(byte* a, byte* b) const override
+	{
+		T* tA = reinterpret_cast<T*>(a);
+		T* tB = reinterpret_cast<T*>(b);
+		if (std::size(*tA) != std::size(*tB)) return false;
+		if constexpr (IsContiguousBytes)
 		{
-			line += "\n" + indentation + "]";
+			return std::size(*tA) == 0
+				|| std::memcmp(std::data(*tA), std::data(*tB), std::size(*tA) * sizeof(TVal)) == 0;
 		}
-		else if (strncmp(&line.back(), " ", 1) == 0)
+		else
 		{
-			line += "]";
+			TypeInfo* valueTypeInfo = GetTypeInfo<TVal>();
+			for (int index = 0; index < static_cast<int>(std::size(*tA)); ++index)
+			{
+				if (!valueTypeInfo->Equal(
+					reinterpret_cast<byte*>(&pAt(*tA, index)),
+					reinterpret_cast<byte*>(&pAt(*tB, index))))
+				{
+					return false;
+				}
+			}
+			return true;
 		}
-		else
+	}
+
+	// arrays of the same length are diffed element by element
+	virtual ErrorOr<Success> Diff(byte* a, byte* b, Differ& differ) const override
+	{
+		T* tA = reinterpret_cast<T*>(a);
+		T* tB = reinterpret_cast<T*>(b);
+		if (std::size(*tA) != std::size(*tB))
+		{
+			return differ.Replace(this, b);
+		}
+		TypeInfo* valueTypeInfo = GetTypeInfo<TVal>();
+		for (int index = 0; index < static_cast<int>(std::size(*tA)); ++index)
+		{
+			differ.PushIndex(index);
+			CHECK_RETURN(valueTypeInfo->Diff(
+				reinterpret_cast<byte*>(&pAt(*tA, index)),
+				reinterpret_cast<byte*>(&pAt(*tB, index)),
+				differ));
+			differ.Pop();
+		}
+		return Success();
+	}
+
+	virtual void HashSchema(SchemaHash& hash) const override
+	{
+		hash.Combine(name);
+		hash.Include(GetTypeInfo<TVal>());
+	}
+
+	// iterates the container directly rather than through pBoundsCheck and pAt
+	// so containers that only expose a pending element, like sets, serialize all of theirs
+	virtual ErrorOr<Success> Serialize(byte* obj, Writer& writer) const override
+	{
+		T* t = reinterpret_cast<T*>(obj);
+		writer.BeginArray(std::size(*t));
+		for (const auto & value : *t)
 		{
-			line += " ]";
+			CHECK_RETURN(Reflect(const_cast<TVal&>(value)).Serialize(writer));
 		}
-		ret += line;
-		return ret;
+		writer.EndArray();
+		return Success();
 	}
 };
 
@@ -471,24 +592,35 @@ struct TypeInfoTable : public TypeInfo
 
 	virtual ErrorOr<ReflectionObject> GetAtKey(
 		byte* obj,
-		HString name) const override
+		HString name,
+		DeserializationContext& context) const override
 	{
 		T* t = reinterpret_cast<T*>(obj);
 		TKey key = TKey(name);
 
 		if (!t->count(key))
 		{
-			return Error(this->name
-				+ " table GetAtKey "
-				+ name
-				+ " failed. No entry exists with that name.");
+			return Error(ErrorCode::NoEntry, this->name, name);
 		}
 
 		TVal& value = t->at(key);
 		return Reflect(value);
 	}
 
-	virtual bool InsertKey(byte* obj, HString name) const override
+	virtual TypeInfo* GetValueTypeInfo() const override
+	{
+		return GetTypeInfo<TVal>();
+	}
+
+	virtual byte* FindAtKey(byte* obj, const HString& name) const override
+	{
+		T* t = reinterpret_cast<T*>(obj);
+		auto iter = t->find(TKey(name));
+		if (iter == t->end()) return nullptr;
+		return reinterpret_cast<byte*>(&iter->second);
+	}
+
+	virtual bool InsertKey(byte* obj, HString name, DeserializationContext& context) const override
 	{
 		T* t = reinterpret_cast<T*>(obj);
 		TKey key = TKey(name);
@@ -500,7 +632,157 @@ struct TypeInfoTable : public TypeInfo
 		return t->insert({key, TVal()}).second;
 	}
 
-	// rmf todo: iterate over members
+	// only HString keys are interned, other keys are constructed from the text
+	virtual ErrorOr<ReflectionObject> InsertTextKey(
+		byte* obj,
+		std::string_view text,
+		DeserializationContext& context) const override
+	{
+		T* t = reinterpret_cast<T*>(obj);
+		if constexpr (!std::is_same<TKey, HString>::value && std::is_constructible<TKey, std::string_view>::value)
+		{
+			auto inserted = t->emplace(TKey(text), TVal());
+			if (!inserted.second) return Error("Insert key failed " + std::string(text));
+			return Reflect(inserted.first->second);
+		}
+		else
+		{
+			HString name = HString(std::string(text));
+			if (!InsertKey(obj, name, context)) return Error("Insert key failed " + name);
+			return GetAtKey(obj, name, context);
+		}
+	}
+
+	virtual ErrorOr<ReflectionObject> GetAtTextKey(
+		byte* obj,
+		std::string_view text,
+		DeserializationContext& context) const override
+	{
+		if constexpr (!std::is_same<TKey, HString>::value && std::is_constructible<TKey, std::string_view>::value)
+		{
+			T* t = reinterpret_cast<T*>(obj);
+			auto iter = t->find(TKey(text));
+			if (iter == t->end()) return Error(this->name + " has no key " + std::string(text));
+			return Reflect(iter->second);
+		}
+		else
+		{
+			return TypeInfo::GetAtTextKey(obj, text, context);
+		}
+	}
+
+	virtual bool Reserve(byte* obj, std::size_t size, DeserializationContext& context) const override
+	{
+		T* t = reinterpret_cast<T*>(obj);
+		t->reserve(t->size() + size);
+		return true;
+	}
+
+	virtual bool Clear(byte* obj) const override
+	{
+		T* t = reinterpret_cast<T*>(obj);
+		t->clear();
+		return true;
+	}
+
+	// entries are summed, so the hash doesn't depend on the order of the table
+	virtual std::uint64_t Hash(byte* obj) const override
+	{
+		T* t = reinterpret_cast<T*>(obj);
+		std::uint64_t sum = 0;
+		TypeInfo* valueTypeInfo = GetTypeInfo<TVal>();
+		for (const auto & pair : *t)
+		{
+			sum += HashCombine(
+				HashInt(std::hash<TKey>()(pair.first)),
+				valueTypeInfo->Hash(reinterpret_cast<byte*>(const_cast<TVal*>(&pair.second))));
+		}
+		return HashCombine(HashInt(t->size()), sum);
+	}
+
+	virtual bool Equal(byte* a, byte* b) const override
+	{
+		T* tA = reinterpret_cast<T*>(a);
+		T* tB = reinterpret_cast<T*>(b);
+		if (tA->size() != tB->size()) return false;
+		TypeInfo* valueTypeInfo = GetTypeInfo<TVal>();
+		for (auto & pair : *tA)
+		{
+			auto iter = tB->find(pair.first);
+			if (iter == tB->end()
+				|| !valueTypeInfo->Equal(
+					reinterpret_cast<byte*>(&pair.second),
+					reinterpret_cast<byte*>(&iter->second)))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// entries are diffed by key, tables that gained or lost keys are replaced whole
+	virtual ErrorOr<Success> Diff(byte* a, byte* b, Differ& differ) const override
+	{
+		T* tA = reinterpret_cast<T*>(a);
+		T* tB = reinterpret_cast<T*>(b);
+		if (tA->size() != tB->size())
+		{
+			return differ.Replace(this, b);
+		}
+		for (const auto & pair : *tB)
+		{
+			if (!tA->count(pair.first))
+			{
+				return differ.Replace(this, b);
+			}
+		}
+		TypeInfo* valueTypeInfo = GetTypeInfo<TVal>();
+		for (const auto & pair : *tB)
+		{
+			// other keys are copied into the patch only if a change is recorded under them
+			if constexpr (std::is_same<TKey, HString>::value)
+			{
+				differ.PushKey(pair.first);
+			}
+			else
+			{
+				differ.PushTextKey(pair.first);
+			}
+			CHECK_RETURN(valueTypeInfo->Diff(
+				reinterpret_cast<byte*>(&tA->at(pair.first)),
+				reinterpret_cast<byte*>(const_cast<TVal*>(&pair.second)),
+				differ));
+			differ.Pop();
+		}
+		return Success();
+	}
+
+	virtual void HashSchema(SchemaHash& hash) const override
+	{
+		hash.Combine(name);
+		hash.Include(GetTypeInfo<TKey>());
+		hash.Include(GetTypeInfo<TVal>());
+	}
+
+	virtual ErrorOr<Success> Serialize(byte* obj, Writer& writer) const override
+	{
+		T* t = reinterpret_cast<T*>(obj);
+		writer.BeginObject();
+		for (const auto & pair : *t)
+		{
+			if constexpr (std::is_same<TKey, HString>::value || std::is_convertible<const TKey&, std::string_view>::value)
+			{
+				writer.Key(pair.first);
+			}
+			else
+			{
+				writer.Key(std::string(pair.first));
+			}
+			CHECK_RETURN(Reflect(const_cast<TVal&>(pair.second)).Serialize(writer));
+		}
+		writer.EndObject();
+		return Success();
+	}
 };
 
 
@@ -512,135 +794,374 @@ struct TypeInfoAs : public TypeInfo
 {
 	TypeInfo * typeInfo;
 
-	// rmf todo: consider switching converter to take in T& for in-place manipulation
-	// rather than relying on a copy constructor
-	// I generally don't like out parameters though...
 	using Converter = Functor<ErrorOr<T>, const TDeserialize &>;
-	Converter & converter;
-
-	std::unique_ptr<std::unordered_map<T*, TDeserialize>> values;
+	Converter * pConverter;
+	// the inverse of converter, used to serialize in the deserialized form
+	// if nullptr T is serialized with its default TypeInfo
+	using FConvertBack = ErrorOr<TDeserialize> (*)(const T&);
+	FConvertBack pConvertBack;
+
+	// in-place variants write straight into the existing object
+	// so T doesn't need to be copyable, and nothing is constructed per conversion
+	using FConvertInPlace = ErrorOr<Success> (*)(const TDeserialize&, T&);
+	FConvertInPlace pConvertInPlace;
+	using FConvertBackInPlace = ErrorOr<Success> (*)(const T&, TDeserialize&);
+	FConvertBackInPlace pConvertBackInPlace;
+
+	TypeInfoAs(HString name, Converter & converter, FConvertBack pConvertBack = nullptr)
+		: TypeInfo(name)
+		, typeInfo(GetTypeInfo<TDeserialize>())
+		, pConverter(&converter)
+		, pConvertBack(pConvertBack)
+		, pConvertInPlace(nullptr)
+		, pConvertBackInPlace(nullptr)
+	{ }
 
-	TypeInfoAs(HString name, Converter & converter)
+	TypeInfoAs(
+		HString name,
+		FConvertInPlace pConvertInPlace,
+		FConvertBackInPlace pConvertBackInPlace = nullptr)
 		: TypeInfo(name)
 		, typeInfo(GetTypeInfo<TDeserialize>())
-		, converter(converter)
-		, values(new std::unordered_map<T*, TDeserialize>)
+		, pConverter(nullptr)
+		, pConvertBack(nullptr)
+		, pConvertInPlace(pConvertInPlace)
+		, pConvertBackInPlace(pConvertBackInPlace)
 	{ }
 
 protected:
-	
-	template<typename ... TArgs>
-	ErrorOr<Success> PassThrough(ErrorOr<Success> (TypeInfo::*function)(byte* obj, TArgs...) const, byte* obj, TArgs... args) const
+	// the TDeserialize being built for obj, kept in the context until it is converted
+	byte* Temp(byte* obj, DeserializationContext& context) const
 	{
-		T* t = reinterpret_cast<T*>(obj);
-		byte* temp = reinterpret_cast<byte*>(&values[t]);
-		CHECK_RETURN((typeInfo->*function)(temp, args...));
-		(*t) = CHECK_RETURN(converter(values[t]));
-		values.erase(t);
-		return Success();
+		return reinterpret_cast<byte*>(&context.Pending<TDeserialize>(obj, this));
 	}
-	
 
-	template<typename ... TArgs>
-	bool PassThrough(bool (TypeInfo::*function)(byte* obj, TArgs...) const, byte* obj, TArgs... args) const
+	// calls function on the pending value, and on success converts it into obj
+	template<typename TFunc>
+	bool PassThrough(byte* obj, DeserializationContext& context, TFunc&& function) const
 	{
-		T* t = reinterpret_cast<T*>(obj);
-		byte* temp = reinterpret_cast<byte*>(&(*values)[t]);
-		bool success = (typeInfo->*function)(temp, args...);
+		byte* temp = Temp(obj, context);
+		bool success = function(temp);
 		if (!success) return false;
-		auto result = converter((*values)[t]);
+		T* t = reinterpret_cast<T*>(obj);
+		const TDeserialize& deserialized = *reinterpret_cast<TDeserialize*>(temp);
+		if (pConvertInPlace != nullptr)
+		{
+			auto result = pConvertInPlace(deserialized, *t);
+			context.ErasePending(obj, this);
+			if (result.IsError())
+			{
+				result.GetError().Log();
+				return false;
+			}
+			return true;
+		}
+		auto result = (*pConverter)(deserialized);
+		context.ErasePending(obj, this);
 		if (result.IsError())
 		{
 			result.GetError().Log();
 			return false;
 		}
-		(*t) = result.GetValue();
-		values->erase(t);
+		(*t) = std::move(result).GetValue();
 		return true;
 	}
 
-	virtual bool AssignBool(byte* obj, bool value) const override
+	virtual bool AssignBool(byte* obj, bool value, DeserializationContext& context) const override
 	{
-		return PassThrough(&TypeInfo::AssignBool, obj, value);
+		return PassThrough(obj, context, [&](byte* temp)
+		{
+			return typeInfo->AssignBool(temp, value, context);
+		});
 	}
 
-	virtual bool AssignUInt(byte* obj, uint value) const override
+	virtual bool AssignUInt(byte* obj, uint value, DeserializationContext& context) const override
 	{
-		return PassThrough(&TypeInfo::AssignUInt, obj, value);
+		return PassThrough(obj, context, [&](byte* temp)
+		{
+			return typeInfo->AssignUInt(temp, value, context);
+		});
 	}
 
-	virtual bool AssignInt(byte* obj, int value) const override
+	virtual bool AssignInt(byte* obj, int value, DeserializationContext& context) const override
 	{
-		return PassThrough(&TypeInfo::AssignInt, obj, value);
+		return PassThrough(obj, context, [&](byte* temp)
+		{
+			return typeInfo->AssignInt(temp, value, context);
+		});
 	}
 
-	virtual bool AssignFloat(byte* obj, float value) const override
+	virtual bool AssignFloat(byte* obj, float value, DeserializationContext& context) const override
 	{
-		return PassThrough(&TypeInfo::AssignFloat, obj, value);
+		return PassThrough(obj, context, [&](byte* temp)
+		{
+			return typeInfo->AssignFloat(temp, value, context);
+		});
 	}
 
-	virtual bool AssignString(byte* obj, std::string value) const override
+	virtual bool AssignString(byte* obj, std::string value, DeserializationContext& context) const override
 	{
-		return PassThrough(&TypeInfo::AssignString, obj, value);
+		return PassThrough(obj, context, [&](byte* temp)
+		{
+			return typeInfo->AssignString(temp, std::move(value), context);
+		});
 	}
 
 	virtual ErrorOr<ReflectionObject> GetAtKey(
 		byte* obj,
-		HString name) const override
+		HString name,
+		DeserializationContext& context) const override
 	{
-		T* t = reinterpret_cast<T*>(obj);
-		byte* temp = reinterpret_cast<byte*>(&(*values)[t]);
-		return typeInfo->GetAtKey(temp, name);
+		return typeInfo->GetAtKey(Temp(obj, context), name, context);
 	}
 
-	virtual bool InsertKey(byte* obj, HString name) const override
+	virtual bool InsertKey(byte* obj, HString name, DeserializationContext& context) const override
 	{
-		T* t = reinterpret_cast<T*>(obj);
-		byte* temp = reinterpret_cast<byte*>(&(*values)[t]);
-		return typeInfo->InsertKey(temp, name);
+		return typeInfo->InsertKey(Temp(obj, context), name, context);
 	}
 
-	virtual bool ObjectEnd(byte* obj) const override
+	virtual ErrorOr<ReflectionObject> InsertTextKey(
+		byte* obj,
+		std::string_view key,
+		DeserializationContext& context) const override
 	{
-		return PassThrough(&TypeInfo::ObjectEnd, obj);
+		return typeInfo->InsertTextKey(Temp(obj, context), key, context);
+	}
+
+	virtual ErrorOr<ReflectionObject> GetAtTextKey(
+		byte* obj,
+		std::string_view key,
+		DeserializationContext& context) const override
+	{
+		return typeInfo->GetAtTextKey(Temp(obj, context), key, context);
+	}
+
+	virtual bool ObjectEnd(byte* obj, DeserializationContext& context) const override
+	{
+		return PassThrough(obj, context, [&](byte* temp)
+		{
+			return typeInfo->ObjectEnd(temp, context);
+		});
 	}
 
 	virtual ErrorOr<ReflectionObject> GetAtIndex(
 		byte* obj,
-		int index) const override
+		int index,
+		DeserializationContext& context) const override
 	{
-		T* t = reinterpret_cast<T*>(obj);
-		byte* temp = reinterpret_cast<byte*>(&(*values)[t]);
-		return typeInfo->GetAtIndex(temp, index);
+		return typeInfo->GetAtIndex(Temp(obj, context), index, context);
 	}
 
-	virtual bool PushBackDefault(byte* obj) const override
+	virtual bool PushBackDefault(byte* obj, DeserializationContext& context) const override
 	{
-		T* t = reinterpret_cast<T*>(obj);
-		byte* temp = reinterpret_cast<byte*>(&(*values)[t]);
-		return typeInfo->PushBackDefault(temp);
+		return typeInfo->PushBackDefault(Temp(obj, context), context);
+	}
+
+	virtual bool Reserve(byte* obj, std::size_t size, DeserializationContext& context) const override
+	{
+		return typeInfo->Reserve(Temp(obj, context), size, context);
 	}
 
-	virtual bool ArrayEnd(byte* obj) const override
+	virtual void HashSchema(SchemaHash& hash) const override
 	{
-		return PassThrough(&TypeInfo::ArrayEnd, obj);
+		hash.Combine(name);
+		hash.Include(typeInfo);
 	}
 
-	virtual ErrorOr<std::string> ToString(byte* obj, std::string indentation = "") const override
+	virtual bool ArrayEnd(byte* obj, DeserializationContext& context) const override
 	{
+		return PassThrough(obj, context, [&](byte* temp)
+		{
+			return typeInfo->ArrayEnd(temp, context);
+		});
+	}
+
+	virtual ErrorOr<Success> Serialize(byte* obj, Writer& writer) const override
+	{
+		T* t = reinterpret_cast<T*>(obj);
+		if (pConvertBackInPlace != nullptr)
+		{
+			TDeserialize converted{};
+			CHECK_RETURN(pConvertBackInPlace(*t, converted));
+			return typeInfo->Serialize(reinterpret_cast<byte*>(&converted), writer);
+		}
+		// arrays can't be returned, so they can only be converted back in place
+		if constexpr (!std::is_array<TDeserialize>::value)
+		{
+			if (pConvertBack != nullptr)
+			{
+				TDeserialize converted = CHECK_RETURN(pConvertBack(*t));
+				return typeInfo->Serialize(reinterpret_cast<byte*>(&converted), writer);
+			}
+		}
 		TypeInfo* defaultTypeInfo = GetTypeInfo<T>();
 		if (defaultTypeInfo == this)
 		{
-			// rmf todo: convert back for ToString? Always?
-			return Error("ToString not implemented for TypeInfoAs");
+			return Error(name + " Serialize requires a function to convert back");
 		}
-		return defaultTypeInfo->ToString(obj, indentation);
+		return defaultTypeInfo->Serialize(obj, writer);
 	}
 };
 
 template<typename T>
 struct TypeInfoStruct;
 
+// collision free hash table from member name to the type that declares it
+// built once when a struct is registered, including the members of parent types
+// so a lookup is a single probe using the precomputed HString hash
+struct MemberLookupTable
+{
+	struct Entry
+	{
+		HString name;
+		// the TypeInfoStruct that declares this member, nullptr for an empty slot
+		const TypeInfo* owner = nullptr;
+		int index = -1;
+	};
+
+	// in lookup priority order, own members before inherited ones
+	std::vector<Entry> entries;
+	std::vector<Entry> slots;
+	std::uint64_t multiplier = 1;
+	int shift = 63;
+
+	void Add(HString name, const TypeInfo* owner, int index)
+	{
+		for (const auto & entry : entries)
+		{
+			// derived members hide parent members with the same name
+			if (entry.name == name) return;
+		}
+		entries.push_back(Entry{name, owner, index});
+	}
+
+	void AddInherited(const TypeInfo* parentType)
+	{
+		if (parentType == nullptr) return;
+		const MemberLookupTable* parentTable = parentType->GetMemberLookupTable();
+		if (parentTable == nullptr) return;
+		for (const auto & entry : parentTable->entries)
+		{
+			Add(entry.name, entry.owner, entry.index);
+		}
+	}
+
+	// searches for a multiplier that maps every name to a distinct slot
+	// with only a handful of members per struct this converges almost immediately
+	void Build()
+	{
+		// no multiplier separates names whose hashes are equal, so the later one is dropped
+		for (std::size_t i = 0; i < entries.size(); ++i)
+		{
+			for (std::size_t j = i + 1; j < entries.size(); )
+			{
+				if (entries[j].name.GetHash() != entries[i].name.GetHash())
+				{
+					++j;
+					continue;
+				}
+				Error("member " + entries[j].name + " has the same hash as " + entries[i].name
+					+ " and can't be looked up, rename one of them").Log();
+				entries.erase(entries.begin() + j);
+			}
+		}
+
+		int bits = 1;
+		while ((std::size_t(1) << bits) < entries.size() * 2)
+		{
+			++bits;
+		}
+		std::uint64_t candidate = 0x9E3779B97F4A7C15ull;
+		for (; bits <= MaxBits; ++bits)
+		{
+			for (int attempt = 0; attempt < 64; ++attempt)
+			{
+				// multipliers must be odd so no hash bits are discarded
+				candidate = (candidate ^ (candidate >> 29)) * 0xBF58476D1CE4E5B9ull;
+				candidate |= 1;
+				if (TryBuild(bits, candidate))
+				{
+					return;
+				}
+			}
+		}
+		// distinct hashes are separated long before this, but never loop forever
+		Error("no lookup table separates " + std::to_string(entries.size())
+			+ " members, members that share a slot can't be looked up").Log();
+		TryBuild(MaxBits, candidate);
+	}
+
+	const Entry* Find(const HString& name) const
+	{
+		const Entry& entry = slots[Slot(name.GetHash())];
+		if (entry.owner != nullptr && entry.name == name)
+		{
+			return &entry;
+		}
+		return nullptr;
+	}
+
+	// also used by DeserializationPlan, which keeps its own slots for the same hashes
+	std::size_t Slot(std::size_t hash) const
+	{
+		return static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * multiplier) >> shift);
+	}
+
+private:
+	// slots are 2^bits, far more than any struct needs
+	static constexpr int MaxBits = 20;
+
+	// entries that collide keep the slot of the first, in priority order
+	bool TryBuild(int bits, std::uint64_t candidate)
+	{
+		multiplier = candidate;
+		shift = 64 - bits;
+		slots.assign(std::size_t(1) << bits, Entry());
+		bool separated = true;
+		for (const auto & entry : entries)
+		{
+			Entry& slot = slots[Slot(entry.name.GetHash())];
+			if (slot.owner != nullptr)
+			{
+				separated = false;
+				continue;
+			}
+			slot = entry;
+		}
+		return separated;
+	}
+};
+
+// everything TypeInfoStruct needs to reach a member, without knowing its type
+// a struct's layouts are stored contiguously, and members are addressed by offset
+// so walking a struct touches one array rather than an object per member
+struct MemberLayout
+{
+	using FShouldSkip = bool (*)(void (*pPredicate)(), const byte* member);
+
+	HString name;
+	std::size_t offset;
+	// nullptr until TypeInfoStruct resolves it from pGetTypeInfo
+	TypeInfo* typeInfo;
+	TypeInfo* (*pGetTypeInfo)();
+	// pSkipPredicate is the member's typed predicate, which pShouldSkip casts back
+	FShouldSkip pShouldSkip;
+	void (*pSkipPredicate)();
+
+	ReflectionObject Get(byte* obj) const
+	{
+		return ReflectionObject(obj + offset, typeInfo);
+	}
+
+	bool ShouldSkipSerialization(const byte* obj) const
+	{
+		if (pSkipPredicate == nullptr) return false;
+		return pShouldSkip(pSkipPredicate, obj + offset);
+	}
+};
+
+// describes a member while a TypeInfoStruct is being declared
+// TypeInfoStruct copies the layout out and deletes these once it is constructed
 template<typename T>
 struct MemberInfo
 {
@@ -649,15 +1170,15 @@ protected:
 	HString name;
 
 	MemberInfo(HString name)
-		: name(name)
+		: name(name.Interned())
 	{ }
 
 public:
 	virtual ~MemberInfo() { }
 
-	virtual ReflectionObject Get(T* t) const = 0;
+	const HString& GetName() const { return name; }
 
-	virtual bool ShouldSkipSerialization(const T* t) const = 0;
+	virtual MemberLayout GetLayout() const = 0;
 };
 
 template<typename T, typename TMem>
@@ -674,6 +1195,12 @@ protected:
 	// (i.e. UI::Note.children std::vector<UI::Node>)
 	TypeInfo* typeInfoOverride;
 
+	static bool ShouldSkipTyped(void (*pPredicate)(), const byte* member)
+	{
+		auto pTyped = reinterpret_cast<bool (*)(const TMem&)>(pPredicate);
+		return pTyped(*reinterpret_cast<const TMem*>(member));
+	}
+
 public:
 	MemberInfoTyped(
 		HString name,
@@ -686,17 +1213,16 @@ public:
 		, typeInfoOverride(typeInfoOverride)
 	{ }
 
-	virtual ReflectionObject Get(T* t) const override
-	{
-		return ReflectionObject(
-			reinterpret_cast<byte*>(&(t->*location)),
-			typeInfoOverride != nullptr ? typeInfoOverride : GetTypeInfo<TMem>());
-	}
-
-	virtual bool ShouldSkipSerialization(const T* t) const override
+	virtual MemberLayout GetLayout() const override
 	{
-		if (pShouldSkipSerialization == nullptr) return false;
-		return pShouldSkipSerialization(t->*location);
+		return MemberLayout{
+			this->name,
+			MemberOffset(location),
+			typeInfoOverride,
+			&GetTypeInfo<TMem>,
+			&MemberInfoTyped::ShouldSkipTyped,
+			reinterpret_cast<void (*)()>(pShouldSkipSerialization)
+		};
 	}
 };
 
@@ -734,115 +1260,238 @@ struct TypeInfoStruct : public TypeInfo
 	// rmf note: at first all TypeInfo would have the opportunity for a parent type
 	// but I figured it was mostly unecessary for the others. Feel free to change in the future.
 	TypeInfo* parentType;
-	// rmf todo: change to value_ptr?
-	std::vector<MemberInfo<T>*> vMembers;
 	bool(*pPostLoad)(T& object);
+	MemberLookupTable memberTable;
 
+private:
+	// in declaration order, use Members() so that member types are resolved
+	mutable std::vector<MemberLayout> members;
+	mutable std::once_flag resolveFlag;
+
+public:
 	TypeInfoStruct(
 		HString name,
 		TypeInfo* parentType,
-		std::vector<MemberInfo<T>*> members,
+		std::vector<MemberInfo<T>*> memberInfos,
 		bool(*pPostLoad)(T& object) = nullptr)
 		: TypeInfo(name)
 		, parentType(parentType)
-		, vMembers(members)
 		, pPostLoad(pPostLoad)
-	{}
-
-	~TypeInfoStruct()
+		, memberTable()
+		, members()
+		, resolveFlag()
 	{
-		for (auto pMember : vMembers)
+		members.reserve(memberInfos.size());
+		for (auto pMemberInfo : memberInfos)
+		{
+			members.push_back(pMemberInfo->GetLayout());
+			delete pMemberInfo;
+		}
+		for (std::size_t index = 0; index < members.size(); ++index)
 		{
-			delete pMember;
+			memberTable.Add(members[index].name, this, static_cast<int>(index));
 		}
+		memberTable.AddInherited(parentType);
+		memberTable.Build();
+	}
+
+	// the lookup table refers back to this instance
+	TypeInfoStruct(const TypeInfoStruct& other) = delete;
+
+	// member TypeInfo can't be looked up while the struct is being registered
+	// because members may refer back to it (i.e. UI::Node.children), so it is done on first use
+	const std::vector<MemberLayout>& Members() const
+	{
+		std::call_once(resolveFlag, [this]()
+		{
+			for (auto & member : members)
+			{
+				if (member.typeInfo == nullptr)
+				{
+					member.typeInfo = member.pGetTypeInfo();
+				}
+			}
+		});
+		return members;
+	}
+
+	virtual const MemberLookupTable* GetMemberLookupTable() const override
+	{
+		return &memberTable;
 	}
 
 	virtual ErrorOr<ReflectionObject> GetAtIndex(
 		byte* obj,
-		int index) const override
+		int index,
+		DeserializationContext& context) const override
 	{
-		T* t = reinterpret_cast<T*>(obj);
-		if (vMembers.size() <= index)
+		const auto & layouts = Members();
+		if (index < 0 || layouts.size() <= static_cast<std::size_t>(index))
 		{
-			return Error(
-				name
-				+ " struct GetAtIndex "
-				+ std::to_string(index)
-				+ " is out of bounds, "
-				+ std::to_string(vMembers.size())
-				+ ".");
+			return Error(ErrorCode::IndexOutOfBounds, name, "struct", index, layouts.size());
 		}
-		return vMembers[index]->Get(t);
+		return layouts[index].Get(obj);
 	}
 
-	virtual bool PushBackDefault(byte* obj) const override
+	virtual bool PushBackDefault(byte* obj, DeserializationContext& context) const override
 	{
 		// has no meaning, failure would occur in GetAtIndex if array is too long
 		return true;
 	}
 
+	virtual bool ArrayEnd(byte* obj, DeserializationContext& context) const override
+	{
+		// members that weren't given an element keep their default values
+		return true;
+	}
+
 	virtual ErrorOr<ReflectionObject> GetAtKey(
 		byte* obj,
-		HString name) const override
+		HString name,
+		DeserializationContext& context) const override
 	{
-		T* t = reinterpret_cast<T*>(obj);
-		for (auto member : vMembers)
+		const MemberLookupTable::Entry* entry = memberTable.Find(name);
+		if (entry != nullptr)
 		{
-			if (member->name == name)
+			if (entry->owner == this)
 			{
-				return member->Get(t);
+				return Members()[entry->index].Get(obj);
 			}
+			// inherited members are reflected by the parent type, which assumes
+			// the parent is at the start of the object (single inheritance)
+			return entry->owner->GetAtIndex(obj, entry->index, context);
 		}
+		return Error(ErrorCode::NoMember, this->name, name);
+	}
 
-		if (parentType != nullptr)
+	// implemented as a no-op to unify table and struct deserialization
+	virtual bool InsertKey(byte* obj, HString name, DeserializationContext& context) const override
+	{
+		return memberTable.Find(name) != nullptr;
+	}
+
+	virtual bool FindMember(const HString& name, std::size_t& offset, TypeInfo*& typeInfo) const override
+	{
+		const MemberLookupTable::Entry* entry = memberTable.Find(name);
+		if (entry == nullptr) return false;
+		if (entry->owner != this) return entry->owner->FindMember(name, offset, typeInfo);
+		const MemberLayout& member = Members()[entry->index];
+		offset = member.offset;
+		typeInfo = member.typeInfo;
+		return true;
+	}
+
+	virtual std::uint64_t Hash(byte* obj) const override
+	{
+		std::uint64_t hash = parentType != nullptr ? parentType->Hash(obj) : HashSeed;
+		for (const auto & member : Members())
 		{
-			return parentType->GetAtKey(obj, name);
+			// skipped members aren't serialized, and may not be convertible in their default state
+			hash = HashCombine(hash, member.ShouldSkipSerialization(obj)
+				? 0
+				: member.typeInfo->Hash(obj + member.offset));
 		}
-		return Error(
-			this->name
-			+ " struct GetAtKey "
-			+ name
-			+ " failed. No member exists with that name.");
+		return hash;
 	}
 
-	// implemented as a no-op to unify table and struct deserialization
-	virtual bool InsertKey(byte* obj, HString name) const override
+	virtual bool Equal(byte* a, byte* b) const override
+	{
+		if (parentType != nullptr && !parentType->Equal(a, b)) return false;
+		for (const auto & member : Members())
+		{
+			bool skipA = member.ShouldSkipSerialization(a);
+			if (skipA != member.ShouldSkipSerialization(b)) return false;
+			if (skipA) continue;
+			if (!member.typeInfo->Equal(a + member.offset, b + member.offset)) return false;
+		}
+		return true;
+	}
+
+	// members are diffed one by one, including those inherited from parent types
+	// which are diffed by the parent, so they are skipped by its predicates
+	virtual ErrorOr<Success> Diff(byte* a, byte* b, Differ& differ) const override
+	{
+		for (const auto & entry : memberTable.entries)
+		{
+			differ.PushKey(entry.name);
+			CHECK_RETURN(entry.owner->DiffMember(a, b, entry.index, differ));
+			differ.Pop();
+		}
+		return Success();
+	}
+
+	virtual ErrorOr<Success> DiffMember(byte* a, byte* b, int index, Differ& differ) const override
+	{
+		const MemberLayout& member = Members()[index];
+		bool skipB = member.ShouldSkipSerialization(b);
+		if (skipB && member.ShouldSkipSerialization(a)) return Success();
+		// members that are skipped can't be deserialized in their default state
+		// so they are written whole, and applying them will fail if they are required
+		if (skipB) return differ.Replace(member.typeInfo, b + member.offset);
+		return member.typeInfo->Diff(a + member.offset, b + member.offset, differ);
+	}
+
+	virtual bool ObjectEnd(byte* obj, DeserializationContext& context) const override
 	{
-		return !(GetAtKey(obj, name).IsError());
+		if (pPostLoad == nullptr) return true;
+		if (context.DefersPostLoad())
+		{
+			context.DeferPostLoad(this);
+			return true;
+		}
+		return PostLoad(obj);
 	}
 
-	virtual bool ObjectEnd(byte* obj) const override
+	virtual bool HasPostLoad() const override
+	{
+		return pPostLoad != nullptr;
+	}
+
+	virtual bool PostLoad(byte* obj) const override
 	{
 		if (pPostLoad == nullptr) return true;
+		FARB_STAT_POSTLOAD(this);
 		T* t = reinterpret_cast<T*>(obj);
 		return pPostLoad(*t);
 	}
 
-	virtual ErrorOr<std::string> ToString(byte* obj, std::string indentation = "") const override
+	virtual void HashSchema(SchemaHash& hash) const override
 	{
-		std::string ret = "\n" + indentation + "{";
-		T* t = reinterpret_cast<T*>(obj);
-		indentation += "\t";
-		for (auto member : vMembers)
+		hash.Combine(name);
+		if (parentType != nullptr)
 		{
-			// each member is always on a new line
-			ret += "\n"
-				+ indentation
-				+ member->name
-				+ ": "
-				+ CHECK_RETURN(member->Get(t).ToString(indentation))
-				+ ",";
+			hash.Include(parentType);
 		}
-		indentation.pop_back();
-		if (vMembers.size() == 0)
+		for (const auto & member : Members())
 		{
-			ret += " }";
+			hash.Combine(member.name);
+			hash.Include(member.typeInfo);
 		}
-		else
+	}
+
+	virtual ErrorOr<Success> Serialize(byte* obj, Writer& writer) const override
+	{
+		writer.BeginObject();
+		CHECK_RETURN(SerializeMembers(obj, writer));
+		writer.EndObject();
+		return Success();
+	}
+
+	virtual ErrorOr<Success> SerializeMembers(byte* obj, Writer& writer) const override
+	{
+		// parent members are written first so that if a member hides one
+		// in the parent, the derived value is the one assigned last when read back
+		if (parentType != nullptr)
 		{
-			ret += "\n" + indentation + "}";
+			CHECK_RETURN(parentType->SerializeMembers(obj, writer));
 		}
-		return ret;
+		for (const auto & member : Members())
+		{
+			if (member.ShouldSkipSerialization(obj)) continue;
+			writer.Key(member.name);
+			CHECK_RETURN(member.Get(obj).Serialize(writer));
+		}
+		return Success();
 	}
 };
 
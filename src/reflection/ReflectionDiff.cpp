@@ -0,0 +1,213 @@
+#include <string_view>
+
+#include "ReflectionDeclare.h"
+#include "ReflectionDiff.h"
+#include "../serialization/BinarySerialization.h"
+
+namespace Farb
+{
+
+namespace Reflection
+{
+
+ErrorOr<Success> TypeInfo::Diff(byte* a, byte* b, Differ& differ) const
+{
+	return differ.Leaf(this, a, b);
+}
+
+std::string PathString(const PatchStep* steps, std::uint32_t count, std::string_view keys)
+{
+	std::string ret;
+	for (std::uint32_t i = 0; i < count; ++i)
+	{
+		const PatchStep& step = steps[i];
+		if (step.index >= 0)
+		{
+			ret += "[" + std::to_string(step.index) + "]";
+			continue;
+		}
+		if (i != 0) ret += '.';
+		ret += step.text ? keys.substr(step.textOffset, step.textSize) : step.key.View();
+	}
+	return ret;
+}
+
+std::string Patch::PathString(const Change& change) const
+{
+	return Reflection::PathString(steps.data() + change.firstStep, change.stepCount, keys);
+}
+
+Differ::Differ(Patch& patch)
+	: patch(patch)
+	, path()
+{ }
+
+ErrorOr<Success> Differ::Leaf(const TypeInfo* typeInfo, byte* a, byte* b)
+{
+	if (typeInfo->Equal(a, b)) return Success();
+	return Replace(typeInfo, b);
+}
+
+ErrorOr<Success> Differ::Replace(const TypeInfo* typeInfo, byte* b)
+{
+	std::size_t valueOffset = patch.values.size();
+	BinaryWriter writer(patch.values);
+	CHECK_RETURN(typeInfo->Serialize(b, writer));
+
+	patch.changes.push_back(Patch::Change{
+		static_cast<std::uint32_t>(patch.steps.size()),
+		static_cast<std::uint32_t>(path.size()),
+		static_cast<std::uint32_t>(valueOffset),
+		static_cast<std::uint32_t>(patch.values.size() - valueOffset)});
+	for (const auto & pathStep : path)
+	{
+		PatchStep step = pathStep.step;
+		if (step.text)
+		{
+			step.textOffset = static_cast<std::uint32_t>(patch.keys.size());
+			step.textSize = static_cast<std::uint32_t>(pathStep.text.size());
+			patch.keys += pathStep.text;
+		}
+		patch.steps.push_back(step);
+	}
+	return Success();
+}
+
+ErrorOr<Success> Diff(ReflectionObject a, ReflectionObject b, Patch& patch)
+{
+	if (a.typeInfo != b.typeInfo)
+	{
+		return Error("Diff requires objects of the same type, not "
+			+ a.typeInfo->GetName()
+			+ " and "
+			+ b.typeInfo->GetName());
+	}
+	if (patch.typeInfo != nullptr && patch.typeInfo != a.typeInfo)
+	{
+		return Error("Diff of " + a.typeInfo->GetName()
+			+ " can't be added to a patch for " + patch.typeInfo->GetName());
+	}
+	patch.typeInfo = a.typeInfo;
+	Differ differ(patch);
+	return a.typeInfo->Diff(a.location, b.location, differ);
+}
+
+namespace
+{
+
+bool SameStep(const Patch& patch, const PatchStep& a, const PatchStep& b)
+{
+	if (a.index != b.index || a.text != b.text) return false;
+	if (a.index >= 0) return true;
+	return a.text ? patch.KeyText(a) == patch.KeyText(b) : a.key == b.key;
+}
+
+ErrorOr<ReflectionObject> Step(ReflectionObject parent, const Patch& patch, const PatchStep& step)
+{
+	if (step.index >= 0)
+	{
+		return parent.GetAtIndex(step.index);
+	}
+	if (step.text)
+	{
+		std::string_view key = patch.KeyText(step);
+		auto existing = parent.GetAtTextKey(key);
+		if (!existing.IsError()) return existing.GetValue();
+		auto inserted = parent.InsertTextKey(key);
+		if (inserted.IsError())
+		{
+			return Error("Apply couldn't insert " + std::string(key) + " into " + parent.typeInfo->GetName());
+		}
+		return inserted.GetValue();
+	}
+	{
+		auto existing = parent.GetAtKey(step.key);
+		if (!existing.IsError()) return existing.GetValue();
+	}
+	// table entries that were diffed in another object may not exist in this one
+	if (!parent.InsertKey(step.key))
+	{
+		return Error("Apply couldn't insert " + step.key + " into " + parent.typeInfo->GetName());
+	}
+	return parent.GetAtKey(step.key);
+}
+
+} // namespace
+
+ErrorOr<Success> Apply(ReflectionObject obj, const Patch& patch)
+{
+	if (patch.Empty()) return Success();
+	if (patch.typeInfo != obj.typeInfo)
+	{
+		return Error("Patch for " + patch.typeInfo->GetName()
+			+ " can't be applied to " + obj.typeInfo->GetName());
+	}
+	DeserializationContext context;
+	if (obj.context == nullptr) obj.context = &context;
+
+	// the objects along the path of the last change, which the next change
+	// is likely to share a prefix of since Diff writes changes depth first
+	// an object is ended when no later change is inside of it
+	// so PostLoad runs once per modified object, after all of its changes
+	std::vector<ReflectionObject> stack{obj};
+	// the top of the stack was just assigned, which already ended it
+	bool topAssigned = false;
+	const PatchStep* previous = nullptr;
+	std::uint32_t previousCount = 0;
+
+	auto popTo = [&](std::size_t size) -> ErrorOr<Success>
+	{
+		while (stack.size() > size)
+		{
+			ReflectionObject ended = stack.back();
+			stack.pop_back();
+			if (topAssigned)
+			{
+				topAssigned = false;
+				continue;
+			}
+			if (!ended.ObjectEnd())
+			{
+				return Error("Apply failed to end " + ended.typeInfo->GetName());
+			}
+		}
+		return Success();
+	};
+
+	for (const auto & change : patch.changes)
+	{
+		const PatchStep* steps = patch.steps.data() + change.firstStep;
+		std::uint32_t shared = 0;
+		while (shared < previousCount
+			&& shared < change.stepCount
+			&& SameStep(patch, previous[shared], steps[shared]))
+		{
+			++shared;
+		}
+		CHECK_RETURN(popTo(shared + 1));
+
+		for (std::uint32_t i = shared; i < change.stepCount; ++i)
+		{
+			topAssigned = false;
+			ReflectionObject child = CHECK_RETURN(Step(stack.back(), patch, steps[i]));
+			stack.push_back(child);
+		}
+
+		ReflectionObject target = stack.back();
+		std::string_view value(patch.values.data() + change.valueOffset, change.valueSize);
+		if (!target.typeInfo->Clear(target.location)
+			|| !DeserializeBinaryValue(value, target))
+		{
+			return Error("Apply failed to assign " + patch.PathString(change)
+				+ " of " + patch.typeInfo->GetName());
+		}
+		topAssigned = true;
+		previous = steps;
+		previousCount = change.stepCount;
+	}
+	return popTo(0);
+}
+
+} // namespace Reflection
+
+} // namespace Farb
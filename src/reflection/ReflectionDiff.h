@@ -0,0 +1,133 @@
+#ifndef FARB_REFLECTION_DIFF_H
+#define FARB_REFLECTION_DIFF_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ReflectionDeclare.h"
+
+namespace Farb
+{
+
+namespace Reflection
+{
+
+// one step from an object into a member, table entry, or array element
+struct PatchStep
+{
+	// empty for array elements and text keys
+	HString key;
+	// -1 for members and table entries
+	int index;
+	// keys of tables that aren't keyed by HString aren't interned,
+	// they're copied into Patch::keys at textOffset instead
+	bool text = false;
+	std::uint32_t textOffset = 0;
+	std::uint32_t textSize = 0;
+};
+
+// i.e. children[2].text, for logging and tests
+// keys holds the text of text keys, see Patch::keys
+std::string PathString(const PatchStep* steps, std::uint32_t count, std::string_view keys = {});
+
+// the changes that turn one object into another of the same type
+// steps, keys and values for every change are stored back to back, so a patch
+// is four allocations no matter how many changes it has
+struct Patch
+{
+	struct Change
+	{
+		std::uint32_t firstStep;
+		std::uint32_t stepCount;
+		// the new value in the binary format, without a header
+		std::uint32_t valueOffset;
+		std::uint32_t valueSize;
+	};
+
+	// the type of the objects that were diffed, patches only apply to that type
+	const TypeInfo* typeInfo = nullptr;
+	std::vector<Change> changes;
+	std::vector<PatchStep> steps;
+	// the text of every text key in steps
+	std::string keys;
+	std::string values;
+
+	bool Empty() const { return changes.empty(); }
+
+	void Clear()
+	{
+		typeInfo = nullptr;
+		changes.clear();
+		steps.clear();
+		keys.clear();
+		values.clear();
+	}
+
+	// i.e. children[2].text, for logging and tests
+	std::string PathString(const Change& change) const;
+
+	std::string_view KeyText(const PatchStep& step) const
+	{
+		return std::string_view(keys.data() + step.textOffset, step.textSize);
+	}
+};
+
+// passed through TypeInfo::Diff, which pushes a step before diffing a child
+// values that can't be diffed any further are compared as a whole
+class Differ
+{
+public:
+	Differ(Patch& patch);
+
+	Differ(const Differ& other) = delete;
+	Differ& operator=(const Differ& other) = delete;
+
+	void PushKey(const HString& key) { path.push_back(PathStep{PatchStep{key, -1}, {}}); }
+	// key has to outlive the step, it's only copied into the patch if a change is recorded
+	void PushTextKey(std::string_view key) { path.push_back(PathStep{PatchStep{HString(), -1, true}, key}); }
+	void PushIndex(int index) { path.push_back(PathStep{PatchStep{HString(), index}, {}}); }
+	void Pop() { path.pop_back(); }
+
+	// records b at the current path unless TypeInfo::Equal says it matches a
+	ErrorOr<Success> Leaf(const TypeInfo* typeInfo, byte* a, byte* b);
+	// records b at the current path, for values that changed shape
+	ErrorOr<Success> Replace(const TypeInfo* typeInfo, byte* b);
+
+private:
+	struct PathStep
+	{
+		PatchStep step;
+		std::string_view text;
+	};
+
+	Patch& patch;
+	std::vector<PathStep> path;
+};
+
+// appends the changes that turn a into b to patch
+// arrays that changed length and tables that gained or lost keys are replaced whole
+ErrorOr<Success> Diff(ReflectionObject a, ReflectionObject b, Patch& patch);
+
+// assigns every change in patch to obj in place, through GetAtKey, GetAtIndex and Assign*
+// obj doesn't need to be the object the patch was made from, only the same type
+ErrorOr<Success> Apply(ReflectionObject obj, const Patch& patch);
+
+template<typename T>
+ErrorOr<Success> Diff(T& a, T& b, Patch& patch)
+{
+	return Diff(Reflect(a), Reflect(b), patch);
+}
+
+template<typename T>
+ErrorOr<Success> Apply(T& obj, const Patch& patch)
+{
+	return Apply(Reflect(obj), patch);
+}
+
+} // namespace Reflection
+
+} // namespace Farb
+
+#endif // FARB_REFLECTION_DIFF_H
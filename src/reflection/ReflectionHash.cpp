@@ -0,0 +1,52 @@
+#include <string>
+
+#include "ReflectionDeclare.h"
+#include "../serialization/BinarySerialization.h"
+#include "../utils/HashExtensions.hpp"
+
+namespace Farb
+{
+
+namespace Reflection
+{
+
+namespace
+{
+
+// reused so comparing serialized forms doesn't allocate once they are large enough
+// a type's Serialize never hashes, so these are never in use twice at once
+thread_local std::string scratchA;
+thread_local std::string scratchB;
+
+bool SerializeInto(const TypeInfo* typeInfo, byte* obj, std::string& output)
+{
+	output.clear();
+	BinaryWriter writer(output);
+	return !typeInfo->Serialize(obj, writer).IsError();
+}
+
+} // namespace
+
+std::uint64_t TypeInfo::Hash(byte* obj) const
+{
+	if (!SerializeInto(this, obj, scratchA))
+	{
+		Error(name + " Hash failed to serialize").Log();
+		return 0;
+	}
+	return HashBytes(scratchA.data(), scratchA.size());
+}
+
+bool TypeInfo::Equal(byte* a, byte* b) const
+{
+	if (!SerializeInto(this, a, scratchA) || !SerializeInto(this, b, scratchB))
+	{
+		Error(name + " Equal failed to serialize").Log();
+		return false;
+	}
+	return scratchA == scratchB;
+}
+
+} // namespace Reflection
+
+} // namespace Farb
@@ -0,0 +1,138 @@
+#include <cctype>
+#include <climits>
+
+#include "ReflectionPath.h"
+
+namespace Farb
+{
+
+namespace Reflection
+{
+
+Path::Path()
+	: text()
+	, root(nullptr)
+	, leaf(nullptr)
+	, leadingOffset(0)
+	, steps()
+{ }
+
+namespace
+{
+
+bool IsNameChar(char c)
+{
+	return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == ':';
+}
+
+} // namespace
+
+ErrorOr<Success> Path::Compile(const TypeInfo* root, std::string_view text, Path& path)
+{
+	path.text = std::string(text);
+	path.root = nullptr;
+	path.leaf = nullptr;
+	path.leadingOffset = 0;
+	path.steps.clear();
+
+	TypeInfo* current = const_cast<TypeInfo*>(root);
+	// members add to the offset of the last step, or the leading offset before any steps
+	std::size_t* offset = &path.leadingOffset;
+	std::size_t i = 0;
+	while (i < text.size())
+	{
+		if (text[i] == '[')
+		{
+			std::size_t end = text.find(']', i);
+			if (end == std::string_view::npos || end == i + 1)
+			{
+				return Error("Path " + path.text + " has an unterminated index at " + std::to_string(i));
+			}
+			int index = 0;
+			for (std::size_t digit = i + 1; digit < end; ++digit)
+			{
+				if (!std::isdigit(static_cast<unsigned char>(text[digit])))
+				{
+					return Error("Path " + path.text + " has an index that isn't a number at " + std::to_string(i));
+				}
+				int value = text[digit] - '0';
+				if (index > (INT_MAX - value) / 10)
+				{
+					return Error("Path " + path.text + " has an index that's too large at " + std::to_string(i));
+				}
+				index = index * 10 + value;
+			}
+			// an index is followed by a member or another index, i.e. not a[0]b
+			if (end + 1 < text.size() && text[end + 1] != '.' && text[end + 1] != '[')
+			{
+				return Error("Path " + path.text + " expected '.' or '[' at " + std::to_string(end + 1));
+			}
+			TypeInfo* element = current->GetElementTypeInfo();
+			if (element == nullptr)
+			{
+				return Error("Path " + path.text + " indexes " + current->GetName() + ", which isn't an array");
+			}
+			path.steps.push_back(Step{current, index, HString(), 0});
+			offset = &path.steps.back().offset;
+			current = element;
+			i = end + 1;
+			continue;
+		}
+
+		if (text[i] == '.')
+		{
+			if (i == 0)
+			{
+				return Error("Path " + path.text + " can't start with '.'");
+			}
+			++i;
+		}
+		std::size_t end = i;
+		while (end < text.size() && IsNameChar(text[end])) ++end;
+		if (end == i)
+		{
+			return Error("Path " + path.text + " expected a name at " + std::to_string(i));
+		}
+		HString name(std::string(text.substr(i, end - i)));
+		std::size_t memberOffset = 0;
+		TypeInfo* member = nullptr;
+		if (current->FindMember(name, memberOffset, member))
+		{
+			*offset += memberOffset;
+			current = member;
+		}
+		else if (TypeInfo* value = current->GetValueTypeInfo())
+		{
+			path.steps.push_back(Step{current, -1, name, 0});
+			offset = &path.steps.back().offset;
+			current = value;
+		}
+		else
+		{
+			return Error("Path " + path.text + " has no member " + name + " in " + current->GetName());
+		}
+		i = end;
+	}
+
+	path.root = root;
+	path.leaf = current;
+	return Success();
+}
+
+ErrorOr<ReflectionObject> Path::Resolve(ReflectionObject obj) const
+{
+	if (obj.typeInfo != root)
+	{
+		return Error("Path " + text + " can't be followed from " + obj.typeInfo->GetName());
+	}
+	byte* location = Find(obj.location);
+	if (location == nullptr)
+	{
+		return Error("Path " + text + " doesn't exist in this " + obj.typeInfo->GetName());
+	}
+	return ReflectionObject(location, leaf, obj.context);
+}
+
+} // namespace Reflection
+
+} // namespace Farb
@@ -0,0 +1,91 @@
+#ifndef FARB_REFLECTION_PATH_H
+#define FARB_REFLECTION_PATH_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ReflectionDeclare.h"
+
+namespace Farb
+{
+
+namespace Reflection
+{
+
+// a path like children[3].text.size, parsed and resolved against a root type once
+// members are folded into byte offsets, so only array indexes and table keys
+// are looked up when the path is followed
+// following a path that doesn't exist in an object returns nullptr rather than an error
+class Path
+{
+public:
+	Path();
+
+	// replaces path with text resolved against root
+	// fails if a member doesn't exist, or a step indexes something that isn't an array or table
+	static ErrorOr<Success> Compile(const TypeInfo* root, std::string_view text, Path& path);
+
+	template<typename TRoot>
+	static ErrorOr<Success> Compile(std::string_view text, Path& path)
+	{
+		return Compile(GetTypeInfo<TRoot>(), text, path);
+	}
+
+	bool IsValid() const { return root != nullptr; }
+	const std::string& GetText() const { return text; }
+	const TypeInfo* GetRootTypeInfo() const { return root; }
+	TypeInfo* GetLeafTypeInfo() const { return leaf; }
+
+	// the address of the leaf, or nullptr if an index or key along the path doesn't exist
+	// obj must be of the root type
+	byte* Find(byte* obj) const
+	{
+		byte* current = obj + leadingOffset;
+		for (const auto & step : steps)
+		{
+			current = step.index >= 0
+				? step.container->FindAtIndex(current, step.index)
+				: step.container->FindAtKey(current, step.key);
+			if (current == nullptr) return nullptr;
+			current += step.offset;
+		}
+		return current;
+	}
+
+	// checks the root type, and builds an error naming the path if it can't be followed
+	ErrorOr<ReflectionObject> Resolve(ReflectionObject obj) const;
+
+	// nullptr if obj isn't the root type, TLeaf isn't the leaf type, or the path doesn't exist
+	template<typename TLeaf, typename TRoot>
+	TLeaf* Get(TRoot& obj) const
+	{
+		if (root != GetTypeInfo<TRoot>() || leaf != GetTypeInfo<TLeaf>()) return nullptr;
+		return reinterpret_cast<TLeaf*>(Find(reinterpret_cast<byte*>(&obj)));
+	}
+
+private:
+	// an index or key into container, followed by the offset of any members after it
+	struct Step
+	{
+		const TypeInfo* container;
+		// -1 for table keys
+		int index;
+		HString key;
+		std::size_t offset;
+	};
+
+	std::string text;
+	const TypeInfo* root;
+	TypeInfo* leaf;
+	// the offset of any members before the first index or key
+	std::size_t leadingOffset;
+	std::vector<Step> steps;
+};
+
+} // namespace Reflection
+
+} // namespace Farb
+
+#endif // FARB_REFLECTION_PATH_H
@@ -0,0 +1,161 @@
+#ifndef FARB_REFLECTION_STATIC_HPP
+#define FARB_REFLECTION_STATIC_HPP
+
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "ReflectionDeclare.h"
+#include "ReflectionDefine.hpp"
+#include "../utils/TypeInspection.hpp"
+
+namespace Farb
+{
+
+namespace Reflection
+{
+
+// evaluated once per type, so visiting members never rebuilds the tuple
+template<typename T>
+inline constexpr auto StaticMembersOf = T::GetStaticMembers();
+
+template <class T, typename = void>
+struct has_PostLoad : std::false_type {};
+
+template<typename T>
+struct has_PostLoad<T, void_t<decltype(T::PostLoad(std::declval<T&>()))> > : std::true_type {};
+
+template<typename T>
+constexpr std::size_t StaticMemberCount()
+{
+	return std::tuple_size<std::decay_t<decltype(StaticMembersOf<T>)> >::value;
+}
+
+// calls func(member) for each StaticMember of T in declaration order
+template<typename T, typename TFunc>
+void ForEachStaticMember(TFunc&& func)
+{
+	std::apply([&](const auto& ... members)
+	{
+		(func(members), ...);
+	}, StaticMembersOf<T>);
+}
+
+// calls func(member) on the member with the given name
+// returns false if T has no member with that name
+template<typename T, typename TFunc>
+bool VisitStaticMember(std::string_view name, TFunc&& func)
+{
+	std::size_t hash = HString::Hash(name.data(), name.size());
+	return std::apply([&](const auto& ... members)
+	{
+		return ((members.name.GetHash() == hash
+			&& members.name.View() == name
+			&& (func(members), true)) || ...);
+	}, StaticMembersOf<T>);
+}
+
+// calls func(member) on the member at index
+// returns false if index is out of range
+template<typename T, typename TFunc>
+bool VisitStaticMember(int index, TFunc&& func)
+{
+	int current = 0;
+	return std::apply([&](const auto& ... members)
+	{
+		return ((current++ == index && (func(members), true)) || ...);
+	}, StaticMembersOf<T>);
+}
+
+template<typename T>
+std::vector<MemberInfo<T>*> MakeStaticMemberInfos()
+{
+	std::vector<MemberInfo<T>*> members;
+	ForEachStaticMember<T>([&](const auto& member)
+	{
+		members.push_back(MakeMemberInfoTyped(
+			member.name,
+			member.location,
+			member.pShouldSkipSerialization));
+	});
+	return members;
+}
+
+// the runtime TypeInfo for a type with static members
+// T::PostLoad is used if it is declared
+template<typename T>
+TypeInfoStruct<T> MakeStaticTypeInfoStruct(HString name, TypeInfo* parentType = nullptr)
+{
+	static_assert(has_GetStaticMembers<T>::value,
+		"MakeStaticTypeInfoStruct requires static constexpr auto T::GetStaticMembers()");
+	bool (*pPostLoad)(T&) = nullptr;
+	if constexpr (has_PostLoad<T>::value)
+	{
+		pPostLoad = &T::PostLoad;
+	}
+	return TypeInfoStruct<T>(name, parentType, MakeStaticMemberInfos<T>(), pPostLoad);
+}
+
+// matches TypeInfoStruct::Serialize, but members of types with static members
+// are visited directly rather than through TypeInfo
+template<typename T>
+ErrorOr<Success> SerializeStatic(const T& object, Writer& writer)
+{
+	if constexpr (has_GetStaticMembers<T>::value)
+	{
+		writer.BeginObject();
+		ErrorOr<Success> result = Success();
+		ForEachStaticMember<T>([&](const auto& member)
+		{
+			if (result.IsError()) return;
+			const auto& value = object.*(member.location);
+			if (member.pShouldSkipSerialization != nullptr
+				&& member.pShouldSkipSerialization(value))
+			{
+				return;
+			}
+			writer.Key(member.name);
+			result = SerializeStatic(value, writer);
+		});
+		if (result.IsError()) return result.GetError();
+		writer.EndObject();
+		return Success();
+	}
+	else if constexpr (IsSpecialization<T, std::vector>::value
+		&& !std::is_same<T, std::vector<bool> >::value)
+	{
+		writer.BeginArray(object.size());
+		for (const auto & value : object)
+		{
+			CHECK_RETURN(SerializeStatic(value, writer));
+		}
+		writer.EndArray();
+		return Success();
+	}
+	else
+	{
+		return Reflect(const_cast<T&>(object)).Serialize(writer);
+	}
+}
+
+// matches Reflection::ToString
+template<typename T>
+std::string ToStringStatic(const T& object)
+{
+	std::string ret;
+	JsonWriter writer(ret, JsonWriter::Mode::Pretty);
+	auto result = SerializeStatic(object, writer);
+	if (result.IsError())
+	{
+		return "Uknown value of type " + GetTypeInfo<T>()->GetName() + " with error " + result.GetError().Message();
+	}
+	return ret;
+}
+
+} // namespace Reflection
+
+} // namespace Farb
+
+#endif // FARB_REFLECTION_STATIC_HPP
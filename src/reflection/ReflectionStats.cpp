@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "ReflectionDeclare.h"
+#include "ReflectionStats.h"
+
+namespace Farb
+{
+
+namespace Reflection
+{
+
+std::string ReflectionStats::Report() const
+{
+	if (!Enabled)
+	{
+		return "Reflection stats are disabled, build with FARB_REFLECTION_STATS to record them\n";
+	}
+
+	std::vector<std::pair<const TypeInfo*, TypeStats> > rows(types.begin(), types.end());
+	std::sort(rows.begin(), rows.end(), [](const auto & a, const auto & b)
+	{
+		if (a.second.postLoadNanoseconds != b.second.postLoadNanoseconds)
+		{
+			return a.second.postLoadNanoseconds > b.second.postLoadNanoseconds;
+		}
+		if (a.second.assigns != b.second.assigns)
+		{
+			return a.second.assigns > b.second.assigns;
+		}
+		return a.first->GetName().View() < b.first->GetName().View();
+	});
+
+	std::ostringstream report;
+	report << std::left << std::setw(40) << "type" << std::right
+		<< std::setw(10) << "assigns"
+		<< std::setw(10) << "lookups"
+		<< std::setw(10) << "cached"
+		<< std::setw(10) << "failed"
+		<< std::setw(10) << "pushes"
+		<< std::setw(14) << "string bytes"
+		<< std::setw(11) << "postloads"
+		<< std::setw(13) << "postload ms" << "\n";
+	for (const auto & [typeInfo, stats] : rows)
+	{
+		report << std::left << std::setw(40) << typeInfo->GetName().View() << std::right
+			<< std::setw(10) << stats.assigns
+			<< std::setw(10) << stats.keyLookups
+			<< std::setw(10) << stats.keyCacheHits
+			<< std::setw(10) << stats.failedLookups
+			<< std::setw(10) << stats.contextPushes
+			<< std::setw(14) << stats.stringBytes
+			<< std::setw(11) << stats.postLoads
+			<< std::setw(13) << std::fixed << std::setprecision(3)
+			<< stats.postLoadNanoseconds / 1000000.0 << "\n";
+	}
+	return report.str();
+}
+
+} // namespace Reflection
+
+} // namespace Farb
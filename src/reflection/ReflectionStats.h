@@ -0,0 +1,126 @@
+#ifndef FARB_REFLECTION_STATS_H
+#define FARB_REFLECTION_STATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace Farb
+{
+
+namespace Reflection
+{
+
+struct TypeInfo;
+
+// what reflection did with one type, to find which types dominate load times
+struct TypeStats
+{
+	std::uint64_t assigns = 0;
+	std::uint64_t keyLookups = 0;
+	// struct keys the json parser resolved from its cache without a lookup
+	std::uint64_t keyCacheHits = 0;
+	// keys and indexes that didn't exist
+	std::uint64_t failedLookups = 0;
+	// ReflectionContexts pushed by the json parser
+	std::uint64_t contextPushes = 0;
+	// of strings assigned, which are allocated unless they fit the small string buffer
+	std::uint64_t stringBytes = 0;
+	std::uint64_t postLoads = 0;
+	std::uint64_t postLoadNanoseconds = 0;
+};
+
+// only recorded when built with FARB_REFLECTION_STATS, see make stats
+// otherwise the counting macros are empty and every report is empty
+class ReflectionStats
+{
+public:
+#ifdef FARB_REFLECTION_STATS
+	static constexpr bool Enabled = true;
+#else
+	static constexpr bool Enabled = false;
+#endif
+
+	TypeStats& For(const TypeInfo* typeInfo) { return types[typeInfo]; }
+	const std::unordered_map<const TypeInfo*, TypeStats>& Types() const { return types; }
+	void Clear() { types.clear(); }
+
+	// a table with a row per type, the slowest PostLoad first
+	std::string Report() const;
+
+	// the stats reflection on this thread records into, nullptr outside of a Scope
+	static ReflectionStats* Current() { return current; }
+
+	// records into stats until it goes out of scope, the previous scope is restored after
+	class Scope
+	{
+	public:
+		Scope(ReflectionStats& stats)
+			: previous(current)
+		{
+			current = &stats;
+		}
+
+		~Scope() { current = previous; }
+
+		Scope(const Scope& other) = delete;
+		Scope& operator=(const Scope& other) = delete;
+
+	private:
+		ReflectionStats* previous;
+	};
+
+	// times a PostLoad hook until it goes out of scope
+	class PostLoadTimer
+	{
+	public:
+		PostLoadTimer(const TypeInfo* typeInfo)
+			: typeInfo(typeInfo)
+			, start(std::chrono::steady_clock::now())
+		{ }
+
+		~PostLoadTimer()
+		{
+			if (current == nullptr) return;
+			TypeStats& stats = current->For(typeInfo);
+			++stats.postLoads;
+			stats.postLoadNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start).count();
+		}
+
+		PostLoadTimer(const PostLoadTimer& other) = delete;
+		PostLoadTimer& operator=(const PostLoadTimer& other) = delete;
+
+	private:
+		const TypeInfo* typeInfo;
+		std::chrono::steady_clock::time_point start;
+	};
+
+private:
+	static inline thread_local ReflectionStats* current = nullptr;
+
+	std::unordered_map<const TypeInfo*, TypeStats> types;
+};
+
+#ifdef FARB_REFLECTION_STATS
+#define FARB_STAT(typeInfo, counter, amount) \
+	do \
+	{ \
+		if (auto farbStats = ::Farb::Reflection::ReflectionStats::Current()) \
+		{ \
+			farbStats->For(typeInfo).counter += (amount); \
+		} \
+	} while (0)
+#define FARB_STAT_POSTLOAD(typeInfo) \
+	::Farb::Reflection::ReflectionStats::PostLoadTimer farbPostLoadTimer(typeInfo)
+#else
+#define FARB_STAT(typeInfo, counter, amount) do { } while (0)
+#define FARB_STAT_POSTLOAD(typeInfo) do { } while (0)
+#endif
+
+} // namespace Reflection
+
+} // namespace Farb
+
+#endif // FARB_REFLECTION_STATS_H
@@ -42,30 +42,36 @@ struct TemplatedTypeInfo<NamedType<T, Tag>>
 	template<typename TVal>
 	static bool Assign(NamedType<T, Tag>& obj, TVal value)
 	{
-		auto reflect = Reflect(obj.value);
-		auto pTypeInfo = dynamic_cast<TypeInfoCustomLeaf<T>*>(reflect.typeInfo);
-		if (pTypeInfo == nullptr)
-		{
-			return false;
-		}
-		return pTypeInfo->Assign(reflect.location, value);
+		return Reflect(obj.value).Assign(value);
+	}
+
+	static ErrorOr<Success> Serialize(const NamedType<T, Tag>& object, Writer& writer)
+	{
+		return Reflect(const_cast<T&>(object.value)).Serialize(writer);
+	}
+
+	static std::uint64_t HashValue(const NamedType<T, Tag>& object)
+	{
+		return Reflection::Hash(object.value);
 	}
 
-	static std::string ToString(const NamedType<T, Tag>& object, std::string indentation)
+	static bool EqualValue(const NamedType<T, Tag>& a, const NamedType<T, Tag>& b)
 	{
-		return Reflection::ToString(object.value, indentation);
+		return Reflection::Equal(a.value, b.value);
 	}
 
 	static TypeInfo* Get()
 	{
 		static auto namedTypeInfo = TypeInfoCustomLeaf<NamedType<T, Tag> >::Construct(
 			Tag::GetName(),
-			ToString,
+			Serialize,
 			Assign<bool>,
 			Assign<uint>,
 			Assign<int>,
 			Assign<float>,
-			Assign<std::string>);
+			Assign<std::string>,
+			HashValue,
+			EqualValue);
 
 		return &namedTypeInfo;
 	}
@@ -77,15 +83,8 @@ struct TemplatedTypeInfo<ValueCheckedType<T, Tag> >
 	template<typename TVal>
 	static bool Assign(ValueCheckedType<T, Tag>& obj, TVal value)
 	{
-		auto pTypeInfo = GetTypeInfo<T>();
-		auto pTypeInfoLeaf = dynamic_cast<TypeInfoCustomLeaf<T>*>(pTypeInfo);
-		if (pTypeInfoLeaf == nullptr)
-		{
-			return false;
-		}
 		T unchecked{};
-		auto uncheckedReflect = Reflect(unchecked);
-		if (!pTypeInfoLeaf->Assign(uncheckedReflect.location, value))
+		if (!Reflect(unchecked).Assign(value))
 		{
 			return false;
 		}
@@ -94,25 +93,37 @@ struct TemplatedTypeInfo<ValueCheckedType<T, Tag> >
 		{
 			return false;
 		}
-		obj = result.GetValue();
+		obj = std::move(result).GetValue();
 		return true;
 	}
 
-	static std::string ToString(const ValueCheckedType<T, Tag>& object, std::string indentation)
+	static ErrorOr<Success> Serialize(const ValueCheckedType<T, Tag>& object, Writer& writer)
+	{
+		return Reflect(const_cast<T&>(object.GetValue())).Serialize(writer);
+	}
+
+	static std::uint64_t HashValue(const ValueCheckedType<T, Tag>& object)
+	{
+		return Reflection::Hash(object.GetValue());
+	}
+
+	static bool EqualValue(const ValueCheckedType<T, Tag>& a, const ValueCheckedType<T, Tag>& b)
 	{
-		return Reflection::ToString(object.GetValue(), indentation);
+		return Reflection::Equal(a.GetValue(), b.GetValue());
 	}
 
 	static TypeInfo* Get()
 	{
 		static auto namedTypeInfo = TypeInfoCustomLeaf<ValueCheckedType<T, Tag> >::Construct(
 			Tag::GetName(),
-			ToString,
+			Serialize,
 			Assign<bool>,
 			Assign<uint>,
 			Assign<int>,
 			Assign<float>,
-			Assign<std::string>);
+			Assign<std::string>,
+			HashValue,
+			EqualValue);
 
 		return &namedTypeInfo;
 	}
@@ -0,0 +1,460 @@
+#include <cstring>
+#include <fstream>
+#include <limits.h>
+#include <vector>
+
+#include "../utils/MappedFile.h"
+#include "BinarySerialization.h"
+
+namespace Farb
+{
+
+using namespace Reflection;
+
+namespace
+{
+
+constexpr char BinaryMagic[4] = { 'F', 'A', 'R', 'B' };
+
+// deep enough for any real asset, but stops malicious input from exhausting the stack
+constexpr int MaxBinaryDepth = 512;
+
+std::uint32_t ZigZag(int value)
+{
+	return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+}
+
+int UnZigZag(std::uint32_t value)
+{
+	return static_cast<int>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+// the same semantics as DeserializationParser, but reading values
+// recursively from the binary form rather than from SAX events
+class BinaryReader
+{
+public:
+	BinaryReader(std::string_view input)
+		: current(reinterpret_cast<const byte*>(input.data()))
+		, end(reinterpret_cast<const byte*>(input.data()) + input.size())
+		, keys()
+	{ }
+
+	bool ReadHeader(std::uint64_t expectedSchemaHash, const HString& typeName)
+	{
+		if (end - current < static_cast<std::ptrdiff_t>(BinaryHeaderSize)
+			|| std::memcmp(current, BinaryMagic, sizeof(BinaryMagic)) != 0)
+		{
+			Error("Binary input is missing the FARB header").Log();
+			return false;
+		}
+		current += sizeof(BinaryMagic);
+		if (*current != BinaryFormatVersion)
+		{
+			Error("Binary format version " + std::to_string(*current)
+				+ " is not supported, expected " + std::to_string(BinaryFormatVersion)).Log();
+			return false;
+		}
+		++current;
+		std::uint64_t schemaHash = 0;
+		for (int i = 0; i < 8; ++i)
+		{
+			schemaHash |= static_cast<std::uint64_t>(current[i]) << (8 * i);
+		}
+		current += 8;
+		if (schemaHash != expectedSchemaHash)
+		{
+			Error("Binary input was written for a different schema than " + typeName).Log();
+			return false;
+		}
+		return true;
+	}
+
+	bool ReadValue(ReflectionObject reflect, int depth)
+	{
+		if (depth > MaxBinaryDepth)
+		{
+			Error("Binary input is nested too deeply").Log();
+			return false;
+		}
+		BinaryTag tag;
+		if (!ReadTag(tag)) return false;
+		switch (tag)
+		{
+		case BinaryTag::False:
+		case BinaryTag::True:
+		{
+			bool value = tag == BinaryTag::True;
+			if (reflect.AssignBool(value)) return true;
+			Error("Assign bool failed " + std::string(value ? "true" : "false")).Log();
+			return false;
+		}
+		case BinaryTag::UInt:
+		{
+			std::uint64_t value;
+			if (!ReadVarint(value)) return false;
+			if (value > UINT_MAX)
+			{
+				Error("Binary uint is out of range").Log();
+				return false;
+			}
+			if (reflect.AssignUInt(static_cast<uint>(value))) return true;
+			Error("Assign uint failed " + std::to_string(value)).Log();
+			return false;
+		}
+		case BinaryTag::Int:
+		{
+			std::uint64_t value;
+			if (!ReadVarint(value)) return false;
+			if (value > UINT32_MAX)
+			{
+				Error("Binary int is out of range").Log();
+				return false;
+			}
+			int signedValue = UnZigZag(static_cast<std::uint32_t>(value));
+			if (reflect.AssignInt(signedValue)) return true;
+			Error("Assign int failed " + std::to_string(signedValue)).Log();
+			return false;
+		}
+		case BinaryTag::Float:
+		{
+			if (end - current < 4) return Truncated();
+			std::uint32_t bits = 0;
+			for (int i = 0; i < 4; ++i)
+			{
+				bits |= static_cast<std::uint32_t>(current[i]) << (8 * i);
+			}
+			current += 4;
+			float value;
+			std::memcpy(&value, &bits, sizeof(value));
+			if (reflect.AssignFloat(value)) return true;
+			Error("Assign float failed " + std::to_string(value)).Log();
+			return false;
+		}
+		case BinaryTag::String:
+		{
+			std::string_view value;
+			if (!ReadBytes(value)) return false;
+			if (reflect.AssignString(std::string(value))) return true;
+			Error("Assign string failed " + std::string(value)).Log();
+			return false;
+		}
+		case BinaryTag::BeginObject:
+			return ReadObject(reflect, depth);
+		case BinaryTag::Array:
+			return ReadArray(reflect, depth);
+		default:
+			Error("Binary input has an unexpected tag "
+				+ std::to_string(static_cast<int>(tag))).Log();
+			return false;
+		}
+	}
+
+	bool AtEnd() const { return current == end; }
+
+private:
+	const byte* current;
+	const byte* end;
+	// views into the input, only tables keyed by HString intern them
+	std::vector<std::string_view> keys;
+
+	bool Truncated()
+	{
+		Error("Binary input ended unexpectedly").Log();
+		return false;
+	}
+
+	bool ReadTag(BinaryTag& tag)
+	{
+		if (current == end) return Truncated();
+		if (*current >= static_cast<std::uint8_t>(BinaryTag::Count))
+		{
+			Error("Binary input has an invalid tag " + std::to_string(*current)).Log();
+			return false;
+		}
+		tag = static_cast<BinaryTag>(*current);
+		++current;
+		return true;
+	}
+
+	bool ReadVarint(std::uint64_t& value)
+	{
+		value = 0;
+		for (int shift = 0; shift < 64; shift += 7)
+		{
+			if (current == end) return Truncated();
+			byte part = *current++;
+			value |= static_cast<std::uint64_t>(part & 0x7F) << shift;
+			if ((part & 0x80) == 0) return true;
+		}
+		Error("Binary varint is too long").Log();
+		return false;
+	}
+
+	bool ReadBytes(std::string_view& value)
+	{
+		std::uint64_t size;
+		if (!ReadVarint(size)) return false;
+		if (static_cast<std::uint64_t>(end - current) < size) return Truncated();
+		value = std::string_view(reinterpret_cast<const char*>(current), size);
+		current += size;
+		return true;
+	}
+
+	bool ReadObject(ReflectionObject reflect, int depth)
+	{
+		while (true)
+		{
+			BinaryTag tag;
+			if (!ReadTag(tag)) return false;
+			if (tag == BinaryTag::EndObject)
+			{
+				return reflect.ObjectEnd();
+			}
+
+			std::string_view key;
+			if (tag == BinaryTag::Key)
+			{
+				if (!ReadBytes(key)) return false;
+				keys.push_back(key);
+			}
+			else if (tag == BinaryTag::KeyIndex)
+			{
+				std::uint64_t index;
+				if (!ReadVarint(index)) return false;
+				if (index >= keys.size())
+				{
+					Error("Binary key index " + std::to_string(index) + " is out of range").Log();
+					return false;
+				}
+				key = keys[index];
+			}
+			else
+			{
+				Error("Binary object expected a key").Log();
+				return false;
+			}
+
+			auto result = reflect.InsertTextKey(key);
+			if (result.IsError())
+			{
+				result.GetError().Log();
+				return false;
+			}
+			if (!ReadValue(result.GetValue(), depth + 1)) return false;
+		}
+	}
+
+	bool ReadArray(ReflectionObject reflect, int depth)
+	{
+		std::uint64_t size;
+		if (!ReadVarint(size)) return false;
+		// every element is at least one byte, so this bounds the reservation
+		if (size > static_cast<std::uint64_t>(end - current)) return Truncated();
+		if (!reflect.Reserve(size))
+		{
+			Error("Reserve failed for " + reflect.typeInfo->GetName()).Log();
+			return false;
+		}
+		for (int index = 0; index < static_cast<int>(size); ++index)
+		{
+			if (!reflect.PushBackDefault())
+			{
+				Error("Array setup failed").Log();
+				return false;
+			}
+			auto result = reflect.GetAtIndex(index);
+			if (result.IsError())
+			{
+				result.GetError().Log();
+				return false;
+			}
+			if (!ReadValue(result.GetValue(), depth + 1)) return false;
+		}
+		return reflect.ArrayEnd();
+	}
+};
+
+} // namespace
+
+BinaryWriter::BinaryWriter(std::string& buffer)
+	: output(buffer)
+	, keyIndices()
+{ }
+
+void BinaryWriter::WriteHeader(std::uint64_t schemaHash)
+{
+	output.append(BinaryMagic, sizeof(BinaryMagic));
+	output += static_cast<char>(BinaryFormatVersion);
+	for (int i = 0; i < 8; ++i)
+	{
+		output += static_cast<char>((schemaHash >> (8 * i)) & 0xFF);
+	}
+}
+
+void BinaryWriter::Tag(BinaryTag tag)
+{
+	output += static_cast<char>(tag);
+}
+
+void BinaryWriter::Varint(std::uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		output += static_cast<char>((value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	output += static_cast<char>(value);
+}
+
+void BinaryWriter::Bytes(std::string_view value)
+{
+	Varint(value.size());
+	output.append(value.data(), value.size());
+}
+
+void BinaryWriter::BeginObject()
+{
+	Tag(BinaryTag::BeginObject);
+}
+
+void BinaryWriter::Key(std::string_view key)
+{
+	std::string owned(key);
+	auto iter = keyIndices.find(owned);
+	if (iter != keyIndices.end())
+	{
+		Tag(BinaryTag::KeyIndex);
+		Varint(iter->second);
+		return;
+	}
+	std::uint32_t index = static_cast<std::uint32_t>(keyIndices.size());
+	keyIndices.emplace(std::move(owned), index);
+	Tag(BinaryTag::Key);
+	Bytes(key);
+}
+
+void BinaryWriter::EndObject()
+{
+	Tag(BinaryTag::EndObject);
+}
+
+void BinaryWriter::Enum(const HString& name, int value)
+{
+	Int(value);
+}
+
+void BinaryWriter::BeginArray(std::size_t size)
+{
+	Tag(BinaryTag::Array);
+	Varint(size);
+}
+
+void BinaryWriter::EndArray()
+{
+	// arrays are length prefixed, there is nothing to close
+}
+
+void BinaryWriter::Bool(bool value)
+{
+	Tag(value ? BinaryTag::True : BinaryTag::False);
+}
+
+void BinaryWriter::UInt(uint value)
+{
+	Tag(BinaryTag::UInt);
+	Varint(value);
+}
+
+void BinaryWriter::Int(int value)
+{
+	Tag(BinaryTag::Int);
+	Varint(ZigZag(value));
+}
+
+void BinaryWriter::Float(float value)
+{
+	std::uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	Tag(BinaryTag::Float);
+	for (int i = 0; i < 4; ++i)
+	{
+		output += static_cast<char>((bits >> (8 * i)) & 0xFF);
+	}
+}
+
+void BinaryWriter::String(std::string_view value)
+{
+	Tag(BinaryTag::String);
+	Bytes(value);
+}
+
+bool SerializeBinary(ReflectionObject reflect, std::string& output)
+{
+	BinaryWriter writer(output);
+	writer.WriteHeader(GetSchemaHash(reflect.typeInfo));
+	auto result = reflect.Serialize(writer);
+	if (result.IsError())
+	{
+		Error("Binary serialize failed for " + reflect.typeInfo->GetName()).Log();
+		result.GetError().Log(1);
+		return false;
+	}
+	return true;
+}
+
+bool SerializeBinaryFile(ReflectionObject reflect, std::string filePath)
+{
+	std::string output;
+	if (!SerializeBinary(reflect, output)) return false;
+	std::ofstream outputFile(filePath, std::ios::binary);
+	if (outputFile.fail())
+	{
+		Error("Couldn't open filePath: " + filePath).Log();
+		return false;
+	}
+	outputFile.write(output.data(), output.size());
+	return !outputFile.fail();
+}
+
+bool DeserializeBinary(std::string_view input, ReflectionObject reflect)
+{
+	DeserializationContext context;
+	if (reflect.context == nullptr) reflect.context = &context;
+	BinaryReader reader(input);
+	if (!reader.ReadHeader(GetSchemaHash(reflect.typeInfo), reflect.typeInfo->GetName()))
+	{
+		return false;
+	}
+	if (!reader.ReadValue(reflect, 0)) return false;
+	if (!reader.AtEnd())
+	{
+		Error("Binary input has trailing data after the root value").Log();
+		return false;
+	}
+	return true;
+}
+
+bool DeserializeBinaryValue(std::string_view input, ReflectionObject reflect)
+{
+	DeserializationContext context;
+	if (reflect.context == nullptr) reflect.context = &context;
+	BinaryReader reader(input);
+	if (!reader.ReadValue(reflect, 0)) return false;
+	if (!reader.AtEnd())
+	{
+		Error("Binary input has trailing data after the value").Log();
+		return false;
+	}
+	return true;
+}
+
+bool DeserializeBinaryFile(std::string filePath, ReflectionObject reflect)
+{
+	// read in place like DeserializeFile, rather than copied into a string first
+	MappedFile file;
+	if (!file.Open(filePath)) return false;
+	return DeserializeBinary(file.View(), reflect);
+}
+
+} // namespace Farb
@@ -0,0 +1,97 @@
+#ifndef FARB_BINARY_SERIALIZATION_H
+#define FARB_BINARY_SERIALIZATION_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "../reflection/ReflectionDeclare.h"
+#include "Writer.h"
+
+namespace Farb
+{
+
+// binary format
+// header: the 4 bytes "FARB", a version byte, then the 8 byte schema hash of the root type
+// followed by a single value, which begins with a BinaryTag
+// all multi byte values are little endian
+// uints are LEB128 varints, ints are zigzag encoded varints, floats are raw IEEE 754
+// strings are a varint length followed by the bytes
+// keys are written once per file, later uses of the same key are a varint index
+// arrays are a varint count followed by exactly that many values, so they can be reserved
+enum class BinaryTag : std::uint8_t
+{
+	False,
+	True,
+	UInt,
+	Int,
+	Float,
+	String,
+	BeginObject,
+	EndObject,
+	// a new key, the next index in the key table
+	Key,
+	// a varint index of a previously written key
+	KeyIndex,
+	Array,
+	Count
+};
+
+constexpr std::uint8_t BinaryFormatVersion = 1;
+constexpr std::size_t BinaryHeaderSize = 4 + 1 + 8;
+
+// writes the binary form of a value, without the header
+// output is appended to and never cleared, like JsonWriter
+class BinaryWriter : public Writer
+{
+public:
+	BinaryWriter(std::string& buffer);
+
+	BinaryWriter(const BinaryWriter& other) = delete;
+	BinaryWriter& operator=(const BinaryWriter& other) = delete;
+
+	virtual void BeginObject() override;
+	virtual void Key(std::string_view key) override;
+	virtual void EndObject() override;
+	// the schema hash covers enum values, so they are written as ints
+	virtual void Enum(const HString& name, int value) override;
+
+	virtual void BeginArray(std::size_t size) override;
+	virtual void EndArray() override;
+
+	virtual void Bool(bool value) override;
+	virtual void UInt(uint value) override;
+	virtual void Int(int value) override;
+	virtual void Float(float value) override;
+	virtual void String(std::string_view value) override;
+
+	using Writer::Key;
+	using Writer::String;
+
+	void WriteHeader(std::uint64_t schemaHash);
+
+private:
+	std::string& output;
+	// owned rather than interned, tables keyed by std::string write keys the pool never needs
+	std::unordered_map<std::string, std::uint32_t> keyIndices;
+
+	void Tag(BinaryTag tag);
+	void Varint(std::uint64_t value);
+	void Bytes(std::string_view value);
+};
+
+bool SerializeBinary(Reflection::ReflectionObject reflect, std::string& output);
+bool SerializeBinaryFile(Reflection::ReflectionObject reflect, std::string filePath);
+
+// fails without modifying reflect if the schema hash doesn't match its type
+bool DeserializeBinary(std::string_view input, Reflection::ReflectionObject reflect);
+bool DeserializeBinaryFile(std::string filePath, Reflection::ReflectionObject reflect);
+
+// a single value written by BinaryWriter without a header, i.e. the values in a Reflection::Patch
+// there is no schema hash, so the caller must know the type the value was written for
+bool DeserializeBinaryValue(std::string_view input, Reflection::ReflectionObject reflect);
+
+} // namespace Farb
+
+#endif // FARB_BINARY_SERIALIZATION_H
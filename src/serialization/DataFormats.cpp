@@ -0,0 +1,473 @@
+#include <cassert>
+#include <cstring>
+#include <fstream>
+
+#include "DataFormats.h"
+
+namespace Farb
+{
+
+using namespace Reflection;
+
+namespace
+{
+
+template<typename T>
+void AppendBigEndian(std::string& output, T value)
+{
+	for (int shift = (sizeof(T) - 1) * 8; shift >= 0; shift -= 8)
+	{
+		output += static_cast<char>(static_cast<std::uint64_t>(value) >> shift);
+	}
+}
+
+void AppendFloatBits(std::string& output, float value)
+{
+	std::uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	AppendBigEndian(output, bits);
+}
+
+bool EndsWith(std::string_view text, std::string_view suffix)
+{
+	return text.size() >= suffix.size()
+		&& text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool IsUbjsonMarker(char c, bool inObject)
+{
+	// inside an object the next byte is the type of the key's length
+	const std::string_view markers = inObject ? "#$iUIlL" : "#$iUIlLdDSTFZCH";
+	return markers.find(c) != std::string_view::npos;
+}
+
+} // namespace
+
+const char* DataFormatName(DataFormat format)
+{
+	switch (format)
+	{
+	case DataFormat::Json: return "json";
+	case DataFormat::Cbor: return "cbor";
+	case DataFormat::MessagePack: return "messagepack";
+	case DataFormat::Ubjson: return "ubjson";
+	default: return "unknown";
+	}
+}
+
+DataFormat DataFormatFromExtension(std::string_view filePath)
+{
+	if (EndsWith(filePath, ".json")) return DataFormat::Json;
+	if (EndsWith(filePath, ".cbor")) return DataFormat::Cbor;
+	if (EndsWith(filePath, ".msgpack") || EndsWith(filePath, ".mpk")) return DataFormat::MessagePack;
+	if (EndsWith(filePath, ".ubj") || EndsWith(filePath, ".ubjson")) return DataFormat::Ubjson;
+	return DataFormat::Unknown;
+}
+
+DataFormat DetectDataFormat(std::string_view input)
+{
+	if (input.substr(0, CborSelfDescribeTag.size()) == CborSelfDescribeTag) return DataFormat::Cbor;
+	if (input.empty()) return DataFormat::Unknown;
+
+	unsigned char first = static_cast<unsigned char>(input[0]);
+	if (first == '{' || first == '[')
+	{
+		// json can only follow a bracket with whitespace, a string, or another value
+		// while ubjson follows it with a type marker
+		if (input.size() > 1 && IsUbjsonMarker(input[1], first == '{')) return DataFormat::Ubjson;
+		return DataFormat::Json;
+	}
+	if (first == ' ' || first == '\t' || first == '\r' || first == '\n'
+		|| first == '"' || first == '-' || (first >= '0' && first <= '9')
+		|| first == 't' || first == 'f' || first == 'n')
+	{
+		return DataFormat::Json;
+	}
+	// fixmap, fixarray, map 16 and 32, array 16 and 32
+	if ((first >= 0x80 && first <= 0x9F) || (first >= 0xDC && first <= 0xDF))
+	{
+		return DataFormat::MessagePack;
+	}
+	// cbor maps, definite and indefinite
+	if (first >= 0xA0 && first <= 0xBF) return DataFormat::Cbor;
+	return DataFormat::Unknown;
+}
+
+CborWriter::CborWriter(std::string& buffer)
+	: output(buffer)
+{ }
+
+void CborWriter::Head(std::uint8_t majorType, std::uint64_t value)
+{
+	std::uint8_t major = static_cast<std::uint8_t>(majorType << 5);
+	if (value < 24)
+	{
+		output += static_cast<char>(major | value);
+	}
+	else if (value <= 0xFF)
+	{
+		output += static_cast<char>(major | 24);
+		output += static_cast<char>(value);
+	}
+	else if (value <= 0xFFFF)
+	{
+		output += static_cast<char>(major | 25);
+		AppendBigEndian(output, static_cast<std::uint16_t>(value));
+	}
+	else if (value <= 0xFFFFFFFF)
+	{
+		output += static_cast<char>(major | 26);
+		AppendBigEndian(output, static_cast<std::uint32_t>(value));
+	}
+	else
+	{
+		output += static_cast<char>(major | 27);
+		AppendBigEndian(output, value);
+	}
+}
+
+void CborWriter::BeginObject()
+{
+	output += '\xBF';
+}
+
+void CborWriter::Key(std::string_view key)
+{
+	String(key);
+}
+
+void CborWriter::EndObject()
+{
+	output += '\xFF';
+}
+
+void CborWriter::BeginArray(std::size_t size)
+{
+	Head(4, size);
+}
+
+void CborWriter::EndArray()
+{ }
+
+void CborWriter::Bool(bool value)
+{
+	output += value ? '\xF5' : '\xF4';
+}
+
+void CborWriter::UInt(uint value)
+{
+	Head(0, value);
+}
+
+void CborWriter::Int(int value)
+{
+	if (value >= 0)
+	{
+		Head(0, static_cast<std::uint64_t>(value));
+		return;
+	}
+	// negative integers store -1 - value
+	Head(1, static_cast<std::uint64_t>(-1 - static_cast<std::int64_t>(value)));
+}
+
+void CborWriter::Float(float value)
+{
+	output += '\xFA';
+	AppendFloatBits(output, value);
+}
+
+void CborWriter::String(std::string_view value)
+{
+	Head(3, value.size());
+	output.append(value);
+}
+
+MessagePackWriter::MessagePackWriter(std::string& buffer)
+	: output(buffer)
+	, objects()
+{ }
+
+void MessagePackWriter::BeginObject()
+{
+	objects.push_back(OpenObject{output.size(), 0});
+	output += '\xDE';
+	AppendBigEndian(output, std::uint16_t(0));
+}
+
+void MessagePackWriter::Key(std::string_view key)
+{
+	assert(!objects.empty());
+	objects.back().count++;
+	String(key);
+}
+
+void MessagePackWriter::EndObject()
+{
+	assert(!objects.empty());
+	OpenObject object = objects.back();
+	objects.pop_back();
+	if (object.count <= 0xFFFF)
+	{
+		output[object.headerOffset + 1] = static_cast<char>(object.count >> 8);
+		output[object.headerOffset + 2] = static_cast<char>(object.count);
+		return;
+	}
+	// rare enough that moving everything after the header is fine
+	std::string header;
+	header += '\xDF';
+	AppendBigEndian(header, object.count);
+	output.replace(object.headerOffset, 3, header);
+}
+
+void MessagePackWriter::BeginArray(std::size_t size)
+{
+	if (size < 16)
+	{
+		output += static_cast<char>(0x90 | size);
+	}
+	else if (size <= 0xFFFF)
+	{
+		output += '\xDC';
+		AppendBigEndian(output, static_cast<std::uint16_t>(size));
+	}
+	else
+	{
+		output += '\xDD';
+		AppendBigEndian(output, static_cast<std::uint32_t>(size));
+	}
+}
+
+void MessagePackWriter::EndArray()
+{ }
+
+void MessagePackWriter::Bool(bool value)
+{
+	output += value ? '\xC3' : '\xC2';
+}
+
+void MessagePackWriter::UInt(uint value)
+{
+	if (value < 0x80)
+	{
+		output += static_cast<char>(value);
+	}
+	else if (value <= 0xFF)
+	{
+		output += '\xCC';
+		output += static_cast<char>(value);
+	}
+	else if (value <= 0xFFFF)
+	{
+		output += '\xCD';
+		AppendBigEndian(output, static_cast<std::uint16_t>(value));
+	}
+	else
+	{
+		output += '\xCE';
+		AppendBigEndian(output, static_cast<std::uint32_t>(value));
+	}
+}
+
+void MessagePackWriter::Int(int value)
+{
+	if (value >= 0)
+	{
+		UInt(static_cast<uint>(value));
+	}
+	else if (value >= -32)
+	{
+		output += static_cast<char>(value);
+	}
+	else if (value >= -128)
+	{
+		output += '\xD0';
+		output += static_cast<char>(value);
+	}
+	else if (value >= -32768)
+	{
+		output += '\xD1';
+		AppendBigEndian(output, static_cast<std::uint16_t>(value));
+	}
+	else
+	{
+		output += '\xD2';
+		AppendBigEndian(output, static_cast<std::uint32_t>(value));
+	}
+}
+
+void MessagePackWriter::Float(float value)
+{
+	output += '\xCA';
+	AppendFloatBits(output, value);
+}
+
+void MessagePackWriter::String(std::string_view value)
+{
+	if (value.size() < 32)
+	{
+		output += static_cast<char>(0xA0 | value.size());
+	}
+	else if (value.size() <= 0xFF)
+	{
+		output += '\xD9';
+		output += static_cast<char>(value.size());
+	}
+	else if (value.size() <= 0xFFFF)
+	{
+		output += '\xDA';
+		AppendBigEndian(output, static_cast<std::uint16_t>(value.size()));
+	}
+	else
+	{
+		output += '\xDB';
+		AppendBigEndian(output, static_cast<std::uint32_t>(value.size()));
+	}
+	output.append(value);
+}
+
+UbjsonWriter::UbjsonWriter(std::string& buffer)
+	: output(buffer)
+{ }
+
+void UbjsonWriter::Integer(std::int64_t value)
+{
+	if (value >= 0 && value <= 0xFF)
+	{
+		output += 'U';
+		output += static_cast<char>(value);
+	}
+	else if (value >= -128 && value <= 127)
+	{
+		output += 'i';
+		output += static_cast<char>(value);
+	}
+	else if (value >= -32768 && value <= 32767)
+	{
+		output += 'I';
+		AppendBigEndian(output, static_cast<std::uint16_t>(value));
+	}
+	else if (value >= INT32_MIN && value <= INT32_MAX)
+	{
+		output += 'l';
+		AppendBigEndian(output, static_cast<std::uint32_t>(value));
+	}
+	else
+	{
+		output += 'L';
+		AppendBigEndian(output, static_cast<std::uint64_t>(value));
+	}
+}
+
+void UbjsonWriter::BeginObject()
+{
+	output += '{';
+}
+
+void UbjsonWriter::Key(std::string_view key)
+{
+	// keys are always strings, so they have no marker
+	Integer(static_cast<std::int64_t>(key.size()));
+	output.append(key);
+}
+
+void UbjsonWriter::EndObject()
+{
+	output += '}';
+}
+
+void UbjsonWriter::BeginArray(std::size_t size)
+{
+	output += "[#";
+	Integer(static_cast<std::int64_t>(size));
+}
+
+void UbjsonWriter::EndArray()
+{ }
+
+void UbjsonWriter::Bool(bool value)
+{
+	output += value ? 'T' : 'F';
+}
+
+void UbjsonWriter::UInt(uint value)
+{
+	Integer(value);
+}
+
+void UbjsonWriter::Int(int value)
+{
+	Integer(value);
+}
+
+void UbjsonWriter::Float(float value)
+{
+	output += 'd';
+	AppendFloatBits(output, value);
+}
+
+void UbjsonWriter::String(std::string_view value)
+{
+	output += 'S';
+	Integer(static_cast<std::int64_t>(value.size()));
+	output.append(value);
+}
+
+namespace
+{
+
+template<typename TWriter>
+bool Serialize(ReflectionObject reflect, std::string& output)
+{
+	TWriter writer(output);
+	auto result = reflect.Serialize(writer);
+	if (result.IsError())
+	{
+		Error("Serialize failed for " + reflect.typeInfo->GetName()).Log();
+		result.GetError().Log(1);
+		return false;
+	}
+	return true;
+}
+
+} // namespace
+
+bool SerializeFormat(ReflectionObject reflect, DataFormat format, std::string& output)
+{
+	switch (format)
+	{
+	case DataFormat::Json:
+		return Serialize<JsonWriter>(reflect, output);
+	case DataFormat::Cbor:
+		output.append(CborSelfDescribeTag);
+		return Serialize<CborWriter>(reflect, output);
+	case DataFormat::MessagePack:
+		return Serialize<MessagePackWriter>(reflect, output);
+	case DataFormat::Ubjson:
+		return Serialize<UbjsonWriter>(reflect, output);
+	default:
+		Error("SerializeFormat needs a format for " + reflect.typeInfo->GetName()).Log();
+		return false;
+	}
+}
+
+bool SerializeFormatFile(ReflectionObject reflect, DataFormat format, std::string filePath)
+{
+	if (format == DataFormat::Unknown) format = DataFormatFromExtension(filePath);
+	if (format == DataFormat::Unknown)
+	{
+		Error("Couldn't tell the format of filePath: " + filePath).Log();
+		return false;
+	}
+	std::string output;
+	if (!SerializeFormat(reflect, format, output)) return false;
+	std::ofstream outputFile(filePath, std::ios::binary);
+	if (outputFile.fail())
+	{
+		Error("Couldn't open filePath: " + filePath).Log();
+		return false;
+	}
+	outputFile.write(output.data(), output.size());
+	return !outputFile.fail();
+}
+
+} // namespace Farb
@@ -0,0 +1,154 @@
+#ifndef FARB_DATA_FORMATS_H
+#define FARB_DATA_FORMATS_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../reflection/ReflectionDeclare.h"
+#include "Writer.h"
+
+namespace Farb
+{
+
+// the interchange formats nlohmann's sax_parse reads, all of which go through
+// the same DeserializationParser as json, see DeserializeFormat in Deserialization.h
+// unlike the farb binary format these carry no schema hash and keep every key,
+// so other tools can read and write them
+enum class DataFormat : std::uint8_t
+{
+	Json,
+	Cbor,
+	MessagePack,
+	Ubjson,
+	// detect the format from the file extension or the first bytes
+	Unknown
+};
+
+const char* DataFormatName(DataFormat format);
+
+// .json, .cbor, .msgpack or .mpk, .ubj or .ubjson, anything else is Unknown
+DataFormat DataFormatFromExtension(std::string_view filePath);
+
+// from the first bytes of a document
+// cbor written by CborWriter begins with the self describe tag, so it's unambiguous
+// cbor without the tag is only recognized when the root is a map, a root array
+// looks like messagepack, so pass the format explicitly for those
+DataFormat DetectDataFormat(std::string_view input);
+
+// the cbor self describe tag, 55799, which marks the rest of a file as cbor
+constexpr std::string_view CborSelfDescribeTag = "\xD9\xD9\xF7";
+
+// all of these append to a caller owned buffer and never clear it, like JsonWriter
+// multi byte values are big endian, as every one of these formats requires
+
+// objects are written with an indefinite length, since Writer doesn't know their size
+class CborWriter : public Writer
+{
+public:
+	CborWriter(std::string& buffer);
+
+	CborWriter(const CborWriter& other) = delete;
+	CborWriter& operator=(const CborWriter& other) = delete;
+
+	virtual void BeginObject() override;
+	virtual void Key(std::string_view key) override;
+	virtual void EndObject() override;
+
+	virtual void BeginArray(std::size_t size) override;
+	virtual void EndArray() override;
+
+	virtual void Bool(bool value) override;
+	virtual void UInt(uint value) override;
+	virtual void Int(int value) override;
+	virtual void Float(float value) override;
+	virtual void String(std::string_view value) override;
+
+	using Writer::Key;
+	using Writer::String;
+
+private:
+	std::string& output;
+
+	void Head(std::uint8_t majorType, std::uint64_t value);
+};
+
+// messagepack has no indefinite length maps, so every object is written as a map 16
+// and its count is filled in when it ends
+class MessagePackWriter : public Writer
+{
+public:
+	MessagePackWriter(std::string& buffer);
+
+	MessagePackWriter(const MessagePackWriter& other) = delete;
+	MessagePackWriter& operator=(const MessagePackWriter& other) = delete;
+
+	virtual void BeginObject() override;
+	virtual void Key(std::string_view key) override;
+	virtual void EndObject() override;
+
+	virtual void BeginArray(std::size_t size) override;
+	virtual void EndArray() override;
+
+	virtual void Bool(bool value) override;
+	virtual void UInt(uint value) override;
+	virtual void Int(int value) override;
+	virtual void Float(float value) override;
+	virtual void String(std::string_view value) override;
+
+	using Writer::Key;
+	using Writer::String;
+
+private:
+	struct OpenObject
+	{
+		std::size_t headerOffset;
+		std::uint32_t count;
+	};
+
+	std::string& output;
+	std::vector<OpenObject> objects;
+};
+
+// arrays are written with a count, objects with an end marker
+class UbjsonWriter : public Writer
+{
+public:
+	UbjsonWriter(std::string& buffer);
+
+	UbjsonWriter(const UbjsonWriter& other) = delete;
+	UbjsonWriter& operator=(const UbjsonWriter& other) = delete;
+
+	virtual void BeginObject() override;
+	virtual void Key(std::string_view key) override;
+	virtual void EndObject() override;
+
+	virtual void BeginArray(std::size_t size) override;
+	virtual void EndArray() override;
+
+	virtual void Bool(bool value) override;
+	virtual void UInt(uint value) override;
+	virtual void Int(int value) override;
+	virtual void Float(float value) override;
+	virtual void String(std::string_view value) override;
+
+	using Writer::Key;
+	using Writer::String;
+
+private:
+	std::string& output;
+
+	// the smallest integer type that holds value, with its marker
+	void Integer(std::int64_t value);
+};
+
+// appends reflect written in format to output, json is written compact
+// cbor begins with CborSelfDescribeTag so DetectDataFormat recognizes it
+bool SerializeFormat(Reflection::ReflectionObject reflect, DataFormat format, std::string& output);
+// an Unknown format is taken from the extension of filePath
+bool SerializeFormatFile(Reflection::ReflectionObject reflect, DataFormat format, std::string filePath);
+
+} // namespace Farb
+
+#endif // FARB_DATA_FORMATS_H
@@ -1,12 +1,17 @@
-#include <fstream>
 #include <iostream>
-#include <stack>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #include "../../lib/json/json.hpp"
 
+#include "../core/Containers.hpp"
 #include "../reflection/ReflectionBasics.h"
+#include "../utils/MappedFile.h"
 #include "Deserialization.h"
+#include "DeserializationPlan.h"
+#include "JsonTokenizer.h"
 
 namespace Farb
 {
@@ -14,35 +19,94 @@ namespace Farb
 using json = nlohmann::json;
 using namespace Reflection;
 
+// a key that resolved to a struct member earlier in the same parse
+struct CachedMember
+{
+	std::string key;
+	HString name;
+	std::size_t offset;
+	TypeInfo* typeInfo;
+};
+
 struct ReflectionContext
 {
 	ReflectionObject reflect;
+	// when parsing with a DeserializationPlan, nullptr for types it leaves Dynamic
+	const PlanNode* plan;
+	// only set for structs without a plan, the members their keys resolved to so far this parse
+	std::vector<CachedMember>* members;
+	// keys seen in this object, the slot in members the next key is compared to first
+	// or with a plan, the member after the last one found
+	std::uint32_t keyCount;
 	int arrayIndex;
 	bool inObject;
 	bool inArray;
+	// values are appended straight into the array, see TypeInfo::AppendsPrimitives
+	bool appendPrimitives;
 
 	// could put function to call here after being done as an optional member
 	// which can be used for constructing the object not in place and then copying
 
 	// should also implement shared values here
 
-	ReflectionContext(ReflectionObject reflect)
+	ReflectionContext()
+		: ReflectionContext(ReflectionObject())
+	{ }
+
+	ReflectionContext(ReflectionObject reflect, const PlanNode* plan = nullptr)
 		: reflect(reflect)
+		, plan(plan)
+		, members(nullptr)
+		, keyCount(0)
 		, arrayIndex(-1)
 		, inObject(false)
 		, inArray(false)
+		, appendPrimitives(false)
 	{ }
 };
 
 class DeserializationParser : public json::json_sax_t
 {
 public:
-	std::stack<ReflectionContext> stack;
+	// pending values for this parse only, every object on the stack refers to it
+	DeserializationContext context;
+	// deep enough for any document we ship without allocating, deeper ones still work
+	InlineStack<ReflectionContext, 64> stack;
+	// when given, PostLoad hooks are queued with the path to their object rather than run
+	PostLoadQueue* postLoads;
+	// the key or index of every context on the stack but the root, only kept for postLoads
+	std::vector<PatchStep> path;
+	// per struct type, in the order keys first named its members
+	// every object of a type in one document usually has its keys in the same order,
+	// so the nth key of an object is compared to the nth cached key before anything is hashed
+	std::unordered_map<const TypeInfo*, std::vector<CachedMember> > memberCache;
+
+	// plan must have been compiled for the type of root
+	DeserializationParser(
+		ReflectionObject root,
+		PostLoadQueue* postLoads = nullptr,
+		const DeserializationPlan* plan = nullptr)
+		: context()
+		, stack()
+		, postLoads(postLoads)
+		, path()
+		, memberCache()
+	{
+		// a caller that provides its own context keeps pending values across parses
+		if (root.context == nullptr) root.context = &context;
+		if (postLoads != nullptr) root.context->SetDeferPostLoad(true);
+		Push(root, plan == nullptr ? nullptr : &plan->Root());
+		rootContext = root.context;
+		this->plan = plan;
+	}
 
-	DeserializationParser(ReflectionObject root)
-		: stack()
+	~DeserializationParser()
 	{
-		stack.push(ReflectionContext(root));
+		if (postLoads != nullptr)
+		{
+			rootContext->SetDeferPostLoad(false);
+			rootContext->DeferredPostLoads().clear();
+		}
 	}
 
 	// called when null is parsed
@@ -56,49 +120,100 @@ public:
 	// called when a boolean is parsed; value is passed
 	bool boolean(bool val)
 	{
+		if (AppendsPrimitives())
+		{
+			const ReflectionObject& array = NextAppend();
+			bool success = array.typeInfo->AppendBool(array.location, val);
+			if (!success) { Error("Append bool failed " + ToString(val)).Log(); }
+			return success;
+		}
 		if (!UpkeepForValueStart()) { return false; }
-		bool success = stack.top().reflect.AssignBool(val);
+		bool success = IsPlannedLeaf()
+			? AssignPlanned(val)
+			: stack.Top().reflect.AssignBool(val);
 		if (!success) { Error("Assign bool failed " + ToString(val)).Log(); }
-		stack.pop();
+		Pop();
 		return success;
 	}
 
 	// called when a signed or unsigned integer number is parsed; value is passed
 	bool number_integer(number_integer_t val)
 	{
+		// json only reports negative numbers here, but the binary formats
+		// can report any value that fits their signed types, i.e. a uint above INT_MAX
+		if (val >= 0) return number_unsigned(static_cast<number_unsigned_t>(val));
+		if (AppendsPrimitives())
+		{
+			const ReflectionObject& array = NextAppend();
+			bool success = array.typeInfo->AppendInt(array.location, val);
+			if (!success) { Error("Append int failed " + ToString((int)val)).Log(); }
+			return success;
+		}
 		if (!UpkeepForValueStart()) { return false; }
-		bool success = stack.top().reflect.AssignInt(val);
+		bool success = IsPlannedLeaf()
+			? AssignPlanned(static_cast<int>(val))
+			: stack.Top().reflect.AssignInt(val);
 		if (!success) { Error("Assign int failed " + ToString((int)val)).Log(); }
-		stack.pop();
+		Pop();
 		return success;
 	}
 
 	bool number_unsigned(number_unsigned_t val)
 	{
+		if (AppendsPrimitives())
+		{
+			const ReflectionObject& array = NextAppend();
+			bool success = array.typeInfo->AppendUInt(array.location, val);
+			if (!success) { Error("Append uint failed " + ToString((uint)val)).Log(); }
+			return success;
+		}
 		if (!UpkeepForValueStart()) { return false; }
-		bool success = stack.top().reflect.AssignUInt(val);
+		bool success = IsPlannedLeaf()
+			? AssignPlanned(static_cast<uint>(val))
+			: stack.Top().reflect.AssignUInt(val);
 		if (!success) { Error("Assign uint failed " + ToString((uint)val)).Log(); }
-		stack.pop();
+		Pop();
 		return success;
 	}
 
 	// called when a floating-point number is parsed; value and original string is passed
 	bool number_float(number_float_t val, const string_t& s)
 	{
+		if (AppendsPrimitives())
+		{
+			const ReflectionObject& array = NextAppend();
+			bool success = array.typeInfo->AppendFloat(array.location, val);
+			if (!success) { Error("Append float failed " + s).Log(); }
+			return success;
+		}
 		if (!UpkeepForValueStart()) { return false; }
-		bool success = stack.top().reflect.AssignFloat(val);
+		bool success = IsPlannedLeaf()
+			? AssignPlanned(static_cast<float>(val))
+			: stack.Top().reflect.AssignFloat(val);
 		if (!success) { Error("Assign float failed " + s).Log(); }
-		stack.pop();
+		Pop();
 		return success;
 	}
 
 	// called when a string is parsed; value is passed and can be safely moved away
+	// val is copied rather than moved, the lexer reuses its capacity for the next string
+	// so a long string costs one allocation of exactly its size, and a short one none
 	bool string(string_t& val)
 	{
+		if (AppendsPrimitives())
+		{
+			const ReflectionObject& array = NextAppend();
+			FARB_STAT(array.typeInfo, stringBytes, val.size());
+			bool success = array.typeInfo->AppendString(array.location, val);
+			if (!success) { Error("Append string failed " + val).Log(); }
+			return success;
+		}
 		if (!UpkeepForValueStart()) { return false; }
-		bool success = stack.top().reflect.AssignString(val);
+		bool success = IsPlannedLeaf()
+			? AssignPlanned(val)
+			: stack.Top().reflect.AssignString(val);
 		if (!success) { Error("Assign string failed " + val).Log(); }
-		stack.pop();
+		Pop();
 		return success;
 	}
 
@@ -106,51 +221,121 @@ public:
 	bool start_object(std::size_t elements)
 	{
 		if (!UpkeepForValueStart()) { return false; }
-		stack.top().inObject = true;
+		ReflectionContext& top = stack.Top();
+		top.inObject = true;
+		// planned structs find their members in the plan instead
+		if (top.plan != nullptr && top.plan->kind == PlanKind::Struct) { return true; }
+		// tables can't be cached, their entries move and are constructed from the key
+		if (top.reflect.typeInfo->GetMemberLookupTable() != nullptr)
+		{
+			top.members = &memberCache[top.reflect.typeInfo];
+		}
 		return true;
 	}
 
 	bool end_object()
 	{
-		if (stack.empty()) { return false; }
-		if (!stack.top().inObject) { return false; }
-		stack.top().inObject = false;
-		bool success = stack.top().reflect.ObjectEnd();
+		if (stack.Empty()) { return false; }
+		if (!stack.Top().inObject) { return false; }
+		stack.Top().inObject = false;
+		const PlanNode* node = stack.Top().plan;
+		// a planned struct only has to end if it has a PostLoad hook
+		bool skipObjectEnd = node != nullptr && node->kind == PlanKind::Struct && !node->hasPostLoad;
+		bool success = skipObjectEnd || stack.Top().reflect.ObjectEnd();
 		if (!success) { return false; }
-		stack.pop();
+		if (postLoads != nullptr)
+		{
+			auto & deferred = rootContext->DeferredPostLoads();
+			for (const TypeInfo* typeInfo : deferred)
+			{
+				postLoads->Add(typeInfo, path);
+			}
+			deferred.clear();
+		}
+		Pop();
 		return true;
 	}
 
 	bool start_array(std::size_t elements)
 	{
 		if (!UpkeepForValueStart()) { return false; }
-		stack.top().inArray = true;
+		ReflectionContext& top = stack.Top();
+		top.inArray = true;
+		top.appendPrimitives = top.plan != nullptr && top.plan->kind == PlanKind::Array
+			? top.plan->appendsPrimitives
+			: Top().typeInfo->AppendsPrimitives();
+		// json doesn't know the length up front, but formats with a length prefix do
+		if (elements != std::size_t(-1) && !Top().Reserve(elements))
+		{
+			Error("Reserve failed for " + Top().typeInfo->GetName()).Log();
+			return false;
+		}
 		return true;
 	}
 
 	bool end_array()
 	{
-		if (stack.empty()) { return false; }
-		stack.top().inArray = false;
-		stack.top().reflect.ArrayEnd();
-		stack.pop();
-		return true;
+		if (stack.Empty()) { return false; }
+		stack.Top().inArray = false;
+		bool success = stack.Top().reflect.ArrayEnd();
+		if (!success) { Error("Array end failed for " + stack.Top().reflect.typeInfo->GetName()).Log(); }
+		Pop();
+		return success;
 	}
 
 	// called when an object key is parsed; value is passed and can be safely moved away
 	bool key(string_t& val)
 	{
-		if (stack.empty()) { return false; }
-		if (!stack.top().inObject) { return false; }
-		bool success = stack.top().reflect.InsertKey(val);
+		if (stack.Empty()) { return false; }
+		ReflectionContext& top = stack.Top();
+		if (!top.inObject) { return false; }
+		if (top.plan != nullptr && top.plan->kind == PlanKind::Struct)
+		{
+			bool hashed = false;
+			const PlanMember* member = top.plan->FindMember(val, top.keyCount, hashed);
+			// counted like ResolveMember, a hit on the cursor is a cache hit
+			if (hashed)
+			{
+				FARB_STAT(top.reflect.typeInfo, keyLookups, 1);
+			}
+			else
+			{
+				FARB_STAT(top.reflect.typeInfo, keyCacheHits, 1);
+			}
+			if (member == nullptr)
+			{
+				FARB_STAT(top.reflect.typeInfo, failedLookups, 1);
+				Error(top.reflect.typeInfo->GetName() + " has no member named " + val).Log();
+				return false;
+			}
+			ReflectionObject child(top.reflect.location + member->offset, member->typeInfo, top.reflect.context);
+			Push(child, PatchStep{member->name, -1}, plan->Node(member->node));
+			return true;
+		}
+		if (top.members != nullptr)
+		{
+			const CachedMember* member = ResolveMember(top, val);
+			if (member == nullptr)
+			{
+				FARB_STAT(top.reflect.typeInfo, failedLookups, 1);
+				Error(top.reflect.typeInfo->GetName() + " has no member named " + val).Log();
+				return false;
+			}
+			ReflectionObject child(top.reflect.location + member->offset, member->typeInfo, top.reflect.context);
+			Push(child, PatchStep{member->name, -1});
+			return true;
+		}
+		HString name(val);
+		bool success = stack.Top().reflect.InsertKey(name);
 		if (!success) { return false; }
-		auto result = stack.top().reflect.GetAtKey(val);
+		auto result = stack.Top().reflect.GetAtKey(name);
 		if (result.IsError())
 		{
 			result.GetError().Log();
 			return false;
 		}
-		stack.push(ReflectionContext(result.GetValue()));
+		const PlanNode* valuePlan = ChildPlan(stack.Top(), result.GetValue().typeInfo);
+		Push(result.GetValue(), PatchStep{name, -1}, valuePlan);
 		return true;
 	}
 
@@ -160,9 +345,10 @@ public:
 		const std::string& last_token,
 		const nlohmann::detail::exception& ex)
 	{
+		// the root has already been popped when there is more input after it
 		Error(
 			"1 Parse Error into object of type "
-			+ stack.top().reflect.typeInfo->GetName()
+			+ (stack.Empty() ? std::string("nothing") : stack.Top().reflect.typeInfo->GetName())
 			+ "\n last token was: "
 			+ last_token
 			+ "\n at: "
@@ -173,14 +359,114 @@ public:
 	}
 
 protected:
+	DeserializationContext* rootContext;
+	const DeserializationPlan* plan;
+
+	const ReflectionObject& Top() const { return stack.Top().reflect; }
+
+	// only true directly inside an array, elements that are objects or arrays
+	// still go through UpkeepForValueStart and fail to assign
+	bool AppendsPrimitives() const
+	{
+		return !stack.Empty() && stack.Top().appendPrimitives;
+	}
+
+	void Push(ReflectionObject reflect, const PlanNode* node = nullptr)
+	{
+		FARB_STAT(reflect.typeInfo, contextPushes, 1);
+		stack.Push(ReflectionContext(reflect, node));
+	}
+
+	void Push(ReflectionObject reflect, PatchStep step, const PlanNode* node = nullptr)
+	{
+		if (postLoads != nullptr) path.push_back(step);
+		Push(reflect, node);
+	}
+
+	bool IsPlannedLeaf() const
+	{
+		return stack.Top().plan != nullptr && stack.Top().plan->IsLeaf();
+	}
+
+	// the leaf's own conversions, without going through its TypeInfo
+	template<typename TValue>
+	bool AssignPlanned(const TValue& value)
+	{
+		const ReflectionContext& top = stack.Top();
+		FARB_STAT(top.reflect.typeInfo, assigns, 1);
+		if constexpr (std::is_same<TValue, std::string>::value)
+		{
+			if (top.plan->kind == PlanKind::String || top.plan->kind == PlanKind::HString)
+			{
+				FARB_STAT(top.reflect.typeInfo, stringBytes, value.size());
+			}
+		}
+		return top.plan->Assign(top.reflect.location, value);
+	}
+
+	// the planned element or value of an array or table, if the child found through
+	// its TypeInfo is the planned type and not a pending value of some other type
+	const PlanNode* ChildPlan(const ReflectionContext& parent, const TypeInfo* childTypeInfo) const
+	{
+		if (parent.plan == nullptr) return nullptr;
+		const PlanNode* child = plan->Node(parent.plan->child);
+		if (child == nullptr || child->typeInfo != childTypeInfo) return nullptr;
+		return child;
+	}
+
+	void Pop()
+	{
+		stack.Pop();
+		// the root has no step
+		if (postLoads != nullptr && !path.empty()) path.pop_back();
+	}
+
+	// nullptr if the struct has no member named key
+	const CachedMember* ResolveMember(ReflectionContext& top, const std::string& key)
+	{
+		std::vector<CachedMember>& members = *top.members;
+		std::size_t slot = top.keyCount++;
+		if (slot < members.size() && members[slot].key == key)
+		{
+			FARB_STAT(top.reflect.typeInfo, keyCacheHits, 1);
+			return &members[slot];
+		}
+
+		FARB_STAT(top.reflect.typeInfo, keyLookups, 1);
+		// member names are interned when they're registered, so a key that isn't in the pool
+		// can't be a member, and unknown keys in a document never grow the pool
+		HString name = HString::Find(key);
+		if (name.Empty()) { return nullptr; }
+		std::size_t offset = 0;
+		TypeInfo* typeInfo = nullptr;
+		if (!top.reflect.typeInfo->FindMember(name, offset, typeInfo)) { return nullptr; }
+		// a document that changes its key order replaces the cached order as it goes
+		CachedMember member{key, name, offset, typeInfo};
+		if (slot < members.size())
+		{
+			members[slot] = std::move(member);
+			return &members[slot];
+		}
+		members.push_back(std::move(member));
+		return &members.back();
+	}
+
+	// counts the element, so ArrayNextSetup still indexes the right one if an object follows
+	const ReflectionObject& NextAppend()
+	{
+		stack.Top().arrayIndex++;
+		FARB_STAT(stack.Top().reflect.typeInfo, assigns, 1);
+		return stack.Top().reflect;
+	}
+
 	bool UpkeepForValueStart()
 	{
-		if (stack.empty())
+		if (stack.Empty())
 		{
 			Error("Stack is empty").Log();
 			return false;
 		}
-		if (stack.top().inArray && !ArrayNextSetup())
+		if (stack.Top().inArray && !ArrayNextSetup())
 		{
 			Error("Array setup failed").Log();
 			return false;
@@ -191,20 +477,35 @@ protected:
 	// true implies continue after having setup the child context
 	bool ArrayNextSetup()
 	{
-		bool success = stack.top().reflect.PushBackDefault();
+		bool success = stack.Top().reflect.PushBackDefault();
 		if (!success)
 		{
 			 return false;
 		}
-		stack.top().arrayIndex++;
+		ReflectionContext& top = stack.Top();
+		top.arrayIndex++;
+
+		// planned arrays find the element by address, unless it's kept somewhere else while pending
+		if (top.plan != nullptr && top.plan->kind == PlanKind::Array && top.plan->child != PlanNode::None)
+		{
+			byte* element = top.reflect.typeInfo->FindAtIndex(top.reflect.location, top.arrayIndex);
+			if (element != nullptr)
+			{
+				const PlanNode* elementPlan = plan->Node(top.plan->child);
+				ReflectionObject child(element, elementPlan->typeInfo, top.reflect.context);
+				Push(child, PatchStep{HString(), top.arrayIndex}, elementPlan);
+				return true;
+			}
+		}
 
-		auto result = stack.top().reflect.GetAtIndex(stack.top().arrayIndex);
+		auto result = top.reflect.GetAtIndex(top.arrayIndex);
 		if (result.IsError())
 		{
 			result.GetError().Log();
 			return false;
 		}
-		stack.push(ReflectionContext(result.GetValue()));
+		const PlanNode* elementPlan = ChildPlan(top, result.GetValue().typeInfo);
+		Push(result.GetValue(), PatchStep{HString(), top.arrayIndex}, elementPlan);
 		return true;
 	}
 
@@ -218,14 +519,149 @@ bool DeserializeString(std::string input, ReflectionObject reflect)
 
 bool DeserializeFile(std::string filePath, ReflectionObject reflect)
 {
+	// the whole file is parsed as one contiguous range
+	// rather than pulled a character at a time through an istream
+	MappedFile file;
+	if (!file.Open(filePath)) return false;
+	DeserializationParser parser(reflect);
+	return json::sax_parse(nlohmann::detail::input_adapter(file.Data(), file.Size()), &parser);
+}
+
+bool DeserializeString(std::string_view input, ReflectionObject reflect, const DeserializationPlan& plan)
+{
+	if (reflect.typeInfo != plan.GetRootTypeInfo())
+	{
+		Error("Plan for " + plan.GetRootTypeInfo()->GetName() + " can't parse " + reflect.typeInfo->GetName()).Log();
+		return false;
+	}
+	DeserializationParser parser(reflect, nullptr, &plan);
+	return json::sax_parse(nlohmann::detail::input_adapter(input.data(), input.size()), &parser);
+}
+
+bool DeserializeFile(std::string filePath, ReflectionObject reflect, const DeserializationPlan& plan)
+{
+	MappedFile file;
+	if (!file.Open(filePath)) return false;
+	return DeserializeString(file.View(), reflect, plan);
+}
+
+bool DeserializeString(std::string_view input, ReflectionObject reflect, PostLoadQueue& postLoads)
+{
+	DeserializationParser parser(reflect, &postLoads);
+	return json::sax_parse(nlohmann::detail::input_adapter(input.data(), input.size()), &parser);
+}
+
+bool DeserializeFormat(std::string_view input, ReflectionObject reflect, DataFormat format)
+{
+	if (format == DataFormat::Unknown) format = DetectDataFormat(input);
 	DeserializationParser parser(reflect);
-	std::ifstream inputFile(filePath);
-	if (inputFile.fail())
+	switch (format)
 	{
-		Error("Couldn't open filePath: " + filePath).Log();
+	case DataFormat::Json:
+		return json::sax_parse(nlohmann::detail::input_adapter(input.data(), input.size()), &parser);
+	case DataFormat::Cbor:
+		// nlohmann doesn't read tags, and this one only marks the format
+		if (input.substr(0, CborSelfDescribeTag.size()) == CborSelfDescribeTag)
+		{
+			input.remove_prefix(CborSelfDescribeTag.size());
+		}
+		return json::sax_parse(
+			nlohmann::detail::input_adapter(input.data(), input.size()),
+			&parser,
+			nlohmann::detail::input_format_t::cbor);
+	case DataFormat::MessagePack:
+		return json::sax_parse(
+			nlohmann::detail::input_adapter(input.data(), input.size()),
+			&parser,
+			nlohmann::detail::input_format_t::msgpack);
+	case DataFormat::Ubjson:
+		return json::sax_parse(
+			nlohmann::detail::input_adapter(input.data(), input.size()),
+			&parser,
+			nlohmann::detail::input_format_t::ubjson);
+	default:
+		Error("Couldn't tell the format of the input for " + reflect.typeInfo->GetName()).Log();
 		return false;
 	}
-	return json::sax_parse(inputFile, &parser);
+}
+
+bool DeserializeFormatFile(std::string filePath, ReflectionObject reflect, DataFormat format)
+{
+	MappedFile file;
+	if (!file.Open(filePath)) return false;
+	if (format == DataFormat::Unknown) format = DataFormatFromExtension(filePath);
+	return DeserializeFormat(file.View(), reflect, format);
+}
+
+DeserializationSession::DeserializationSession(ReflectionObject reflect)
+	: parser(std::make_unique<DeserializationParser>(reflect))
+	, tokenizer(std::make_unique<JsonTokenizer>())
+{ }
+
+DeserializationSession::~DeserializationSession() = default;
+
+bool DeserializationSession::Feed(std::string_view chunk)
+{
+	return tokenizer->Feed(chunk.data(), chunk.size(), *parser);
+}
+
+bool DeserializationSession::Finish()
+{
+	return tokenizer->Finish(*parser);
+}
+
+bool DeserializationSession::Failed() const
+{
+	return tokenizer->Failed();
+}
+
+bool DeserializationSession::Finished() const
+{
+	return tokenizer->Finished();
+}
+
+std::size_t DeserializationSession::BytesFed() const
+{
+	return tokenizer->Position();
+}
+
+ErrorOr<Success> PostLoadQueue::Run(ReflectionObject root) const
+{
+	for (const auto & entry : entries)
+	{
+		ReflectionObject current = root;
+		for (std::uint32_t i = 0; i < entry.stepCount; ++i)
+		{
+			const PatchStep& step = steps[entry.firstStep + i];
+			current = CHECK_RETURN(step.index >= 0
+				? current.GetAtIndex(step.index)
+				: current.GetAtKey(step.key));
+		}
+		if (current.typeInfo != entry.typeInfo)
+		{
+			return Error("PostLoad for " + entry.typeInfo->GetName()
+				+ " found " + current.typeInfo->GetName()
+				+ " at " + PathString(steps.data() + entry.firstStep, entry.stepCount));
+		}
+		if (!current.typeInfo->PostLoad(current.location))
+		{
+			return Error("PostLoad failed for " + entry.typeInfo->GetName()
+				+ " at " + PathString(steps.data() + entry.firstStep, entry.stepCount));
+		}
+	}
+	return Success();
+}
+
+bool DeserializeString(std::string input, ReflectionObject reflect, ReflectionStats& stats)
+{
+	ReflectionStats::Scope scope(stats);
+	return DeserializeString(std::move(input), reflect);
+}
+
+bool DeserializeFile(std::string filePath, ReflectionObject reflect, ReflectionStats& stats)
+{
+	ReflectionStats::Scope scope(stats);
+	return DeserializeFile(std::move(filePath), reflect);
 }
 
 } // namespace Farb
@@ -1,9 +1,15 @@
 #ifndef FARB_DESERIALIZATION_H
 #define FARB_DESERIALIZATION_H
 
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "../reflection/ReflectionDeclare.h"
+#include "../reflection/ReflectionDiff.h"
+#include "DataFormats.h"
 
 namespace Farb
 {
@@ -11,6 +17,121 @@ namespace Farb
 bool DeserializeString(std::string input, Reflection::ReflectionObject reflect);
 bool DeserializeFile(std::string input, Reflection::ReflectionObject reflect);
 
+// PostLoad hooks left to run after a parse, in the order the parse ended their objects
+// objects are found again by path, since a vector may have moved them as it grew
+class PostLoadQueue
+{
+public:
+	bool Empty() const { return entries.empty(); }
+	std::size_t Size() const { return entries.size(); }
+
+	void Clear()
+	{
+		entries.clear();
+		steps.clear();
+	}
+
+	void Add(const Reflection::TypeInfo* typeInfo, const std::vector<Reflection::PatchStep>& path)
+	{
+		entries.push_back(Entry{
+			typeInfo,
+			static_cast<std::uint32_t>(steps.size()),
+			static_cast<std::uint32_t>(path.size())});
+		steps.insert(steps.end(), path.begin(), path.end());
+	}
+
+	// root must be the object that was parsed, stops at the first hook that fails
+	ErrorOr<Success> Run(Reflection::ReflectionObject root) const;
+
+private:
+	struct Entry
+	{
+		const Reflection::TypeInfo* typeInfo;
+		std::uint32_t firstStep;
+		std::uint32_t stepCount;
+	};
+
+	std::vector<Entry> entries;
+	std::vector<Reflection::PatchStep> steps;
+};
+
+// queues PostLoad hooks into postLoads rather than running them, see LoadBatch.h
+// objects built apart from their owner, like the element of a set, still run theirs during
+// the parse, since they only have their final address once they are inserted
+// elements of fixed arrays are in place, so they are queued like any other object
+// input is only read during the call, so it can point into a MappedFile
+bool DeserializeString(
+	std::string_view input,
+	Reflection::ReflectionObject reflect,
+	PostLoadQueue& postLoads);
+
+// any of the formats in DataFormats.h through the same parser as json
+// Unknown detects the format with DetectDataFormat
+bool DeserializeFormat(
+	std::string_view input,
+	Reflection::ReflectionObject reflect,
+	DataFormat format = DataFormat::Unknown);
+// Unknown uses the extension of filePath, then the first bytes of the file
+bool DeserializeFormatFile(
+	std::string filePath,
+	Reflection::ReflectionObject reflect,
+	DataFormat format = DataFormat::Unknown);
+
+class DeserializationPlan;
+
+// follows a plan from CompilePlan, see DeserializationPlan.h
+// the result is the same as without one, reflect must be of the plan's root type
+bool DeserializeString(
+	std::string_view input,
+	Reflection::ReflectionObject reflect,
+	const DeserializationPlan& plan);
+bool DeserializeFile(
+	std::string filePath,
+	Reflection::ReflectionObject reflect,
+	const DeserializationPlan& plan);
+
+class DeserializationParser;
+class JsonTokenizer;
+
+// parses json that arrives in pieces, like a file read a little every frame, or a pipe
+// the parser's stack is kept between calls to Feed, so values are assigned into reflect
+// as soon as they complete, but it's only safe to use once Finish succeeds
+// PostLoad hooks run as their objects end, like DeserializeString
+class DeserializationSession
+{
+public:
+	DeserializationSession(Reflection::ReflectionObject reflect);
+	~DeserializationSession();
+
+	DeserializationSession(const DeserializationSession& other) = delete;
+	DeserializationSession& operator=(const DeserializationSession& other) = delete;
+
+	// chunk can end anywhere, even partway through a token, and isn't kept after the call
+	// false once the input is invalid or doesn't fit reflect, every later call fails too
+	bool Feed(std::string_view chunk);
+	// fails if the input ended partway through the value
+	bool Finish();
+
+	bool Failed() const;
+	bool Finished() const;
+	std::size_t BytesFed() const;
+
+private:
+	std::unique_ptr<DeserializationParser> parser;
+	std::unique_ptr<JsonTokenizer> tokenizer;
+};
+
+// also records what reflection did with each type into stats, see ReflectionStats.h
+// stats accumulate over calls, print them with stats.Report()
+bool DeserializeString(
+	std::string input,
+	Reflection::ReflectionObject reflect,
+	Reflection::ReflectionStats& stats);
+bool DeserializeFile(
+	std::string input,
+	Reflection::ReflectionObject reflect,
+	Reflection::ReflectionStats& stats);
+
 } // namespace Farb
 
 #endif // FARB_DESERIALIZATION_H
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include <limits.h>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "../reflection/ReflectionBasics.h"
+#include "../reflection/ReflectionDefine.hpp"
+#include "DeserializationPlan.h"
+
+namespace Farb
+{
+
+using namespace Reflection;
+
+namespace
+{
+
+PlanKind KindOf(const TypeInfo* typeInfo)
+{
+	// compared by address, so members with a TypeInfo override stay Dynamic
+	if (typeInfo == GetTypeInfo<bool>()) return PlanKind::Bool;
+	if (typeInfo == GetTypeInfo<uint>()) return PlanKind::UInt;
+	if (typeInfo == GetTypeInfo<int>()) return PlanKind::Int;
+	if (typeInfo == GetTypeInfo<float>()) return PlanKind::Float;
+	if (typeInfo == GetTypeInfo<std::string>()) return PlanKind::String;
+	if (typeInfo == GetTypeInfo<HString>()) return PlanKind::HString;
+	if (typeInfo->GetMemberLookupTable() != nullptr) return PlanKind::Struct;
+	if (typeInfo->GetElementTypeInfo() != nullptr) return PlanKind::Array;
+	if (typeInfo->GetValueTypeInfo() != nullptr) return PlanKind::Table;
+	return PlanKind::Dynamic;
+}
+
+} // namespace
+
+const PlanMember* PlanNode::FindMember(std::string_view key, std::uint32_t& cursor, bool& hashed) const
+{
+	hashed = false;
+	if (cursor < members.size() && members[cursor].key == key)
+	{
+		return &members[cursor++];
+	}
+	hashed = true;
+	std::uint32_t index = slots[lookupTable->Slot(HString::Hash(key.data(), key.size()))];
+	if (index == None || members[index].key != key) return nullptr;
+	cursor = index + 1;
+	return &members[index];
+}
+
+// the conversions match the TypeInfoCustomLeaf of each type in ReflectionBasics.cpp
+
+bool PlanNode::Assign(byte* location, bool value) const
+{
+	if (kind != PlanKind::Bool) return false;
+	*reinterpret_cast<bool*>(location) = value;
+	return true;
+}
+
+bool PlanNode::Assign(byte* location, uint value) const
+{
+	switch (kind)
+	{
+	case PlanKind::Bool:
+		if (value > 1) return false;
+		*reinterpret_cast<bool*>(location) = value == 1;
+		return true;
+	case PlanKind::UInt:
+		*reinterpret_cast<uint*>(location) = value;
+		return true;
+	case PlanKind::Int:
+		if (value > INT_MAX) return false;
+		*reinterpret_cast<int*>(location) = static_cast<int>(value);
+		return true;
+	case PlanKind::Float:
+		*reinterpret_cast<float*>(location) = static_cast<float>(value);
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool PlanNode::Assign(byte* location, int value) const
+{
+	switch (kind)
+	{
+	case PlanKind::Bool:
+		if (value != 0 && value != 1) return false;
+		*reinterpret_cast<bool*>(location) = value == 1;
+		return true;
+	case PlanKind::UInt:
+		if (value < 0) return false;
+		*reinterpret_cast<uint*>(location) = static_cast<uint>(value);
+		return true;
+	case PlanKind::Int:
+		*reinterpret_cast<int*>(location) = value;
+		return true;
+	case PlanKind::Float:
+		*reinterpret_cast<float*>(location) = static_cast<float>(value);
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool PlanNode::Assign(byte* location, float value) const
+{
+	if (kind != PlanKind::Float) return false;
+	*reinterpret_cast<float*>(location) = value;
+	return true;
+}
+
+bool PlanNode::Assign(byte* location, const std::string& value) const
+{
+	switch (kind)
+	{
+	case PlanKind::String:
+		*reinterpret_cast<std::string*>(location) = value;
+		return true;
+	case PlanKind::HString:
+		*reinterpret_cast<HString*>(location) = HString(value);
+		return true;
+	default:
+		return false;
+	}
+}
+
+DeserializationPlan::DeserializationPlan(TypeInfo* root)
+	: nodes()
+{
+	std::unordered_map<const TypeInfo*, std::uint32_t> indexes;
+	auto nodeFor = [&](TypeInfo* typeInfo)
+	{
+		auto iter = indexes.find(typeInfo);
+		if (iter != indexes.end()) return iter->second;
+		std::uint32_t index = PlanNode::None;
+		if (KindOf(typeInfo) != PlanKind::Dynamic)
+		{
+			index = static_cast<std::uint32_t>(nodes.size());
+			nodes.emplace_back(typeInfo);
+		}
+		indexes[typeInfo] = index;
+		return index;
+	};
+
+	// the root always has a node, even if it's Dynamic
+	indexes[root] = 0;
+	nodes.emplace_back(root);
+
+	// filling in a node can add more, so nodes is indexed rather than iterated
+	for (std::size_t i = 0; i < nodes.size(); ++i)
+	{
+		TypeInfo* typeInfo = nodes[i].typeInfo;
+		PlanNode node(typeInfo);
+		node.kind = KindOf(typeInfo);
+		switch (node.kind)
+		{
+		case PlanKind::Struct:
+		{
+			node.hasPostLoad = typeInfo->HasPostLoad();
+			node.lookupTable = typeInfo->GetMemberLookupTable();
+			node.slots.assign(node.lookupTable->slots.size(), PlanNode::None);
+			for (const auto & entry : node.lookupTable->entries)
+			{
+				std::size_t offset = 0;
+				TypeInfo* memberTypeInfo = nullptr;
+				if (!typeInfo->FindMember(entry.name, offset, memberTypeInfo)) continue;
+				node.slots[node.lookupTable->Slot(entry.name.GetHash())] = static_cast<std::uint32_t>(node.members.size());
+				node.members.push_back(PlanMember{
+					std::string(entry.name.View()),
+					entry.name,
+					offset,
+					memberTypeInfo,
+					nodeFor(memberTypeInfo)});
+			}
+			break;
+		}
+		case PlanKind::Array:
+			node.appendsPrimitives = typeInfo->AppendsPrimitives();
+			node.child = nodeFor(typeInfo->GetElementTypeInfo());
+			break;
+		case PlanKind::Table:
+			node.child = nodeFor(typeInfo->GetValueTypeInfo());
+			break;
+		default:
+			break;
+		}
+		nodes[i] = std::move(node);
+	}
+}
+
+const DeserializationPlan& CompilePlan(TypeInfo* root)
+{
+	static std::mutex cacheMutex;
+	static std::unordered_map<const TypeInfo*, std::unique_ptr<DeserializationPlan> > cache;
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	auto & plan = cache[root];
+	if (plan == nullptr)
+	{
+		plan = std::make_unique<DeserializationPlan>(root);
+	}
+	return *plan;
+}
+
+} // namespace Farb
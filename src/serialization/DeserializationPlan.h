@@ -0,0 +1,128 @@
+#ifndef FARB_DESERIALIZATION_PLAN_H
+#define FARB_DESERIALIZATION_PLAN_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../reflection/ReflectionDeclare.h"
+
+namespace Farb
+{
+
+// what a parse needs to know about every type reachable from one root type,
+// found once by walking the TypeInfo graph instead of through virtual calls
+// for every object of every parse, see CompilePlan
+// types the plan doesn't know are still parsed through their TypeInfo
+
+enum class PlanKind : std::uint8_t
+{
+	// parsed through its TypeInfo, as without a plan
+	Dynamic,
+	// assigned directly, with the same conversions as their TypeInfo
+	Bool,
+	UInt,
+	Int,
+	Float,
+	String,
+	HString,
+	// keys are found in the node's jump table
+	Struct,
+	// elements are pushed back and found by address
+	Array,
+	// keys go through the TypeInfo, only the value type is planned
+	Table
+};
+
+struct PlanMember
+{
+	std::string key;
+	// for the paths of queued PostLoad hooks
+	HString name;
+	std::size_t offset;
+	Reflection::TypeInfo* typeInfo;
+	std::uint32_t node;
+};
+
+struct PlanNode
+{
+	static constexpr std::uint32_t None = UINT32_MAX;
+
+	Reflection::TypeInfo* typeInfo;
+	PlanKind kind;
+	// ObjectEnd is skipped for structs without a PostLoad hook
+	bool hasPostLoad;
+	// see TypeInfo::AppendsPrimitives
+	bool appendsPrimitives;
+	// the node of an Array's elements or a Table's values, None when they're Dynamic
+	std::uint32_t child;
+
+	// only for Struct, including inherited members, in MemberLookupTable priority order
+	std::vector<PlanMember> members;
+	// the struct's MemberLookupTable slots, holding indexes into members
+	std::vector<std::uint32_t> slots;
+	const Reflection::MemberLookupTable* lookupTable;
+
+	PlanNode(Reflection::TypeInfo* typeInfo)
+		: typeInfo(typeInfo)
+		, kind(PlanKind::Dynamic)
+		, hasPostLoad(false)
+		, appendsPrimitives(false)
+		, child(None)
+		, members()
+		, slots()
+		, lookupTable(nullptr)
+	{ }
+
+	bool IsLeaf() const { return kind >= PlanKind::Bool && kind <= PlanKind::HString; }
+
+	// nullptr if the struct has no member named key
+	// cursor is the member after the last one found in this object, which is compared first
+	// since objects are usually written in member order, then key is hashed like an HString
+	// hashed is set when the cursor missed, for ReflectionStats
+	const PlanMember* FindMember(std::string_view key, std::uint32_t& cursor, bool& hashed) const;
+
+	// only for leaves, false if value doesn't convert to the leaf type
+	bool Assign(byte* location, bool value) const;
+	bool Assign(byte* location, uint value) const;
+	bool Assign(byte* location, int value) const;
+	bool Assign(byte* location, float value) const;
+	bool Assign(byte* location, const std::string& value) const;
+};
+
+class DeserializationPlan
+{
+public:
+	DeserializationPlan(Reflection::TypeInfo* root);
+
+	DeserializationPlan(const DeserializationPlan& other) = delete;
+	DeserializationPlan& operator=(const DeserializationPlan& other) = delete;
+
+	Reflection::TypeInfo* GetRootTypeInfo() const { return nodes[0].typeInfo; }
+	const PlanNode& Root() const { return nodes[0]; }
+	// nullptr for None
+	const PlanNode* Node(std::uint32_t index) const
+	{
+		return index == PlanNode::None ? nullptr : &nodes[index];
+	}
+	std::size_t NodeCount() const { return nodes.size(); }
+
+private:
+	// one per type reachable from the root, types that refer to themselves share a node
+	std::vector<PlanNode> nodes;
+};
+
+// compiles the plan for root the first time it's asked for and keeps it for the rest of
+// the program, so it's cheap to call for every load of a type, from any thread
+const DeserializationPlan& CompilePlan(Reflection::TypeInfo* root);
+
+template<typename T>
+const DeserializationPlan& CompilePlan()
+{
+	return CompilePlan(Reflection::GetTypeInfo<T>());
+}
+
+} // namespace Farb
+
+#endif // FARB_DESERIALIZATION_PLAN_H
@@ -0,0 +1,147 @@
+#include <fstream>
+
+#include "FrozenImage.h"
+
+namespace Farb
+{
+
+namespace
+{
+
+constexpr char FrozenMagic[4] = { 'F', 'R', 'Z', 'N' };
+
+bool IsAligned(const void* pointer, std::size_t alignment)
+{
+	return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+
+} // namespace
+
+std::size_t ReadFrozenImageHeader(
+	std::string_view image,
+	std::uint64_t layoutHash,
+	std::size_t rootSize,
+	std::size_t rootAlignment)
+{
+	FrozenImageHeader header;
+	if (image.size() < sizeof(header))
+	{
+		Error("Frozen image is too small for its header").Log();
+		return 0;
+	}
+	std::memcpy(&header, image.data(), sizeof(header));
+	if (std::memcmp(header.magic, FrozenMagic, sizeof(FrozenMagic)) != 0)
+	{
+		Error("Frozen image is missing the FRZN header").Log();
+		return 0;
+	}
+	if (header.version != FrozenImageVersion)
+	{
+		Error("Frozen image version " + std::to_string(header.version)
+			+ " is not supported, expected " + std::to_string(FrozenImageVersion)).Log();
+		return 0;
+	}
+	if (header.layoutHash != layoutHash)
+	{
+		Error("Frozen image was built for a different layout").Log();
+		return 0;
+	}
+	if (header.size != image.size())
+	{
+		Error("Frozen image is " + std::to_string(image.size())
+			+ " bytes but its header says " + std::to_string(header.size)).Log();
+		return 0;
+	}
+	if (!IsAligned(image.data(), alignof(std::max_align_t)))
+	{
+		Error("Frozen image isn't aligned in memory").Log();
+		return 0;
+	}
+	if (header.rootOffset < sizeof(header)
+		|| header.rootOffset > image.size()
+		|| image.size() - header.rootOffset < rootSize
+		|| header.rootOffset % rootAlignment != 0)
+	{
+		Error("Frozen image root is out of bounds").Log();
+		return 0;
+	}
+	return static_cast<std::size_t>(header.rootOffset);
+}
+
+FrozenImageBuilder::FrozenImageBuilder(std::string& output)
+	: output(output)
+{
+	output.assign(sizeof(FrozenImageHeader), '\0');
+}
+
+std::size_t FrozenImageBuilder::AllocateBytes(std::size_t size, std::size_t alignment)
+{
+	std::size_t offset = (output.size() + alignment - 1) / alignment * alignment;
+	output.resize(offset + size, '\0');
+	return offset;
+}
+
+void FrozenImageBuilder::Finish(std::uint64_t layoutHash, std::size_t rootOffset)
+{
+	// the size of an image is a multiple of the largest alignment
+	// so images can be concatenated or embedded without breaking it
+	AllocateBytes(0, alignof(std::max_align_t));
+	FrozenImageHeader header;
+	std::memcpy(header.magic, FrozenMagic, sizeof(FrozenMagic));
+	header.version = FrozenImageVersion;
+	header.layoutHash = layoutHash;
+	header.rootOffset = rootOffset;
+	header.size = output.size();
+	std::memcpy(&output[0], &header, sizeof(header));
+}
+
+bool WriteFrozenImageFile(const std::string& image, const std::string& filePath)
+{
+	std::ofstream outputFile(filePath, std::ios::binary);
+	if (outputFile.fail())
+	{
+		Error("Couldn't open filePath: " + filePath).Log();
+		return false;
+	}
+	outputFile.write(image.data(), image.size());
+	return !outputFile.fail();
+}
+
+bool FrozenValidator::CheckRange(
+	const void* owner,
+	const void* first,
+	std::size_t count,
+	std::size_t elementSize,
+	std::size_t alignment)
+{
+	std::uintptr_t address = reinterpret_cast<std::uintptr_t>(first);
+	std::uintptr_t ownerAddress = reinterpret_cast<std::uintptr_t>(owner);
+	std::uintptr_t imageBegin = reinterpret_cast<std::uintptr_t>(begin);
+	std::uintptr_t imageEnd = reinterpret_cast<std::uintptr_t>(end);
+	if (address <= ownerAddress || address < imageBegin || address > imageEnd)
+	{
+		return Fail("Frozen offset points outside of the image");
+	}
+	if (address < reinterpret_cast<std::uintptr_t>(cursor))
+	{
+		return Fail("Frozen offset points into a range that was already checked");
+	}
+	if (address % alignment != 0)
+	{
+		return Fail("Frozen offset is misaligned");
+	}
+	if (count > (imageEnd - address) / elementSize)
+	{
+		return Fail("Frozen vector runs past the end of the image");
+	}
+	cursor = reinterpret_cast<const char*>(first) + count * elementSize;
+	return true;
+}
+
+bool FrozenValidator::Fail(const char* message)
+{
+	Error(message).Log();
+	return false;
+}
+
+} // namespace Farb
@@ -0,0 +1,527 @@
+#ifndef FARB_FROZEN_IMAGE_H
+#define FARB_FROZEN_IMAGE_H
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../reflection/ReflectionDeclare.h"
+#include "../reflection/ReflectionStatic.hpp"
+#include "../utils/MappedFile.h"
+
+namespace Farb
+{
+
+// frozen images are read only data laid out exactly as it is used in memory
+// so a file can be mapped and used directly, without deserialization
+// every pointer is stored as an offset from its own address, so the image is relocatable
+//
+// a frozen type is one of
+// - a trivially copyable leaf without pointers, like int, float, enums, or UI::Dimensions
+// - FrozenVector<T> of a frozen type, or FrozenString
+// - a struct of frozen types with static constexpr auto GetStaticMembers()
+// images are only valid on the platform that built them, the layout hash
+// covers sizes and offsets so anything else is rejected on open
+
+// a pointer stored as the distance from its own address, zero is null
+// copying one would change what it points to, so they only live inside an image
+template<typename T>
+class OffsetPtr
+{
+public:
+	OffsetPtr()
+		: offset(0)
+	{ }
+
+	OffsetPtr(const OffsetPtr& other) = delete;
+	OffsetPtr& operator=(const OffsetPtr& other) = delete;
+
+	const T* Get() const
+	{
+		if (offset == 0) return nullptr;
+		return reinterpret_cast<const T*>(reinterpret_cast<const char*>(this) + offset);
+	}
+
+	std::int64_t GetOffset() const { return offset; }
+
+	// only used while building an image
+	void Set(const T* target)
+	{
+		offset = target == nullptr
+			? 0
+			: reinterpret_cast<const char*>(target) - reinterpret_cast<const char*>(this);
+	}
+
+private:
+	std::int64_t offset;
+};
+
+template<typename T>
+class FrozenVector
+{
+public:
+	using value_type = T;
+
+	FrozenVector()
+		: elements()
+		, count(0)
+	{ }
+
+	const T* data() const { return elements.Get(); }
+	const T* begin() const { return elements.Get(); }
+	const T* end() const { return elements.Get() + count; }
+	std::size_t size() const { return static_cast<std::size_t>(count); }
+	bool empty() const { return count == 0; }
+
+	const T& operator[](std::size_t index) const
+	{
+		assert(index < count);
+		return elements.Get()[index];
+	}
+
+	// only used while building an image
+	void Set(const T* first, std::size_t size)
+	{
+		elements.Set(first);
+		count = size;
+	}
+
+private:
+	OffsetPtr<T> elements;
+	std::uint64_t count;
+};
+
+// always null terminated, the terminator isn't included in size
+class FrozenString
+{
+public:
+	const char* c_str() const { return chars.empty() ? "" : chars.data(); }
+	std::size_t size() const { return chars.size(); }
+	bool empty() const { return chars.empty(); }
+	std::string_view View() const { return std::string_view(c_str(), chars.size()); }
+
+	// only used while building an image
+	void Set(const char* first, std::size_t size) { chars.Set(first, size); }
+
+private:
+	FrozenVector<char> chars;
+};
+
+template<typename T>
+struct IsFrozenVector : std::false_type {};
+
+template<typename T>
+struct IsFrozenVector<FrozenVector<T> > : std::true_type {};
+
+template<typename T>
+constexpr bool IsFrozenLeaf()
+{
+	// types with every copy deleted count as trivially copyable, but can't be copied
+	return std::is_trivially_copyable<T>::value
+		&& std::is_copy_constructible<T>::value
+		&& !std::is_pointer<T>::value;
+}
+
+// leaves are only checked by their bounds, so vectors of them validate in constant time
+template<typename T>
+constexpr bool NeedsFrozenValidation()
+{
+	if constexpr (IsFrozenVector<T>::value || std::is_same<T, FrozenString>::value)
+	{
+		return true;
+	}
+	else if constexpr (Reflection::has_GetStaticMembers<T>::value)
+	{
+		return std::apply([](const auto& ... members)
+		{
+			return (NeedsFrozenValidation<
+				typename std::decay_t<decltype(members)>::Type>() || ...);
+		}, Reflection::StaticMembersOf<T>);
+	}
+	else
+	{
+		static_assert(IsFrozenLeaf<T>(),
+			"Frozen leaves must be trivially copyable and can't be pointers");
+		return false;
+	}
+}
+
+// covers the size, alignment, and member offsets of every type reachable from the root
+class FrozenLayoutHash
+{
+public:
+	template<typename T>
+	void Include()
+	{
+		hash.Combine(sizeof(T));
+		hash.Combine(alignof(T));
+		if constexpr (IsFrozenVector<T>::value)
+		{
+			hash.Combine('V');
+			IncludeOnce<typename T::value_type>();
+		}
+		else if constexpr (std::is_same<T, FrozenString>::value)
+		{
+			hash.Combine('S');
+		}
+		else if constexpr (Reflection::has_GetStaticMembers<T>::value)
+		{
+			hash.Combine('M');
+			Reflection::ForEachStaticMember<T>([&](const auto& member)
+			{
+				hash.Combine(member.name);
+				hash.Combine(Reflection::MemberOffset(member.location));
+				IncludeOnce<typename std::decay_t<decltype(member)>::Type>();
+			});
+		}
+		else
+		{
+			static_assert(IsFrozenLeaf<T>(),
+				"Frozen leaves must be trivially copyable and can't be pointers");
+			hash.Combine(std::is_floating_point<T>::value);
+			hash.Combine(std::is_signed<T>::value);
+			hash.Combine(std::is_enum<T>::value);
+		}
+	}
+
+	std::uint64_t Value() const { return hash.value; }
+
+private:
+	template<typename T>
+	struct TypeTag { static constexpr char value = 0; };
+
+	Reflection::SchemaHash hash;
+	// frozen types can contain vectors of themselves, this stops the recursion
+	std::vector<const void*> visited;
+
+	template<typename T>
+	void IncludeOnce()
+	{
+		const void* tag = &TypeTag<T>::value;
+		for (const void* pVisited : visited)
+		{
+			if (pVisited == tag)
+			{
+				hash.Combine('R');
+				return;
+			}
+		}
+		visited.push_back(tag);
+		Include<T>();
+	}
+};
+
+template<typename T>
+std::uint64_t GetFrozenLayoutHash()
+{
+	static const std::uint64_t value = []()
+	{
+		FrozenLayoutHash hash;
+		hash.Include<T>();
+		return hash.Value();
+	}();
+	return value;
+}
+
+struct FrozenImageHeader
+{
+	char magic[4];
+	std::uint32_t version;
+	std::uint64_t layoutHash;
+	std::uint64_t rootOffset;
+	std::uint64_t size;
+};
+
+constexpr std::uint32_t FrozenImageVersion = 1;
+
+// checks the header and returns the offset of the root, or 0 on failure
+std::size_t ReadFrozenImageHeader(
+	std::string_view image,
+	std::uint64_t layoutHash,
+	std::size_t rootSize,
+	std::size_t rootAlignment);
+
+// appends zeroed space for frozen values, the image is built in place
+class FrozenImageBuilder
+{
+public:
+	// replaces the contents of output, the header is filled in by Finish
+	FrozenImageBuilder(std::string& output);
+
+	template<typename T>
+	std::size_t Allocate(std::size_t count)
+	{
+		static_assert(alignof(T) <= alignof(std::max_align_t),
+			"Frozen types can't be over aligned");
+		return AllocateBytes(sizeof(T) * count, alignof(T));
+	}
+
+	// only valid until the next Allocate
+	template<typename T>
+	T* At(std::size_t offset)
+	{
+		return reinterpret_cast<T*>(&output[offset]);
+	}
+
+	void Finish(std::uint64_t layoutHash, std::size_t rootOffset);
+
+private:
+	std::string& output;
+
+	std::size_t AllocateBytes(std::size_t size, std::size_t alignment);
+};
+
+template<typename TFrozen, typename TSource>
+void FreezeInto(FrozenImageBuilder& builder, std::size_t offset, const TSource& source);
+
+template<typename TFrozen, typename TSource, std::size_t ... Is>
+void FreezeMembers(
+	FrozenImageBuilder& builder,
+	std::size_t offset,
+	const TSource& source,
+	std::index_sequence<Is...>)
+{
+	(([&]()
+	{
+		const auto& frozenMember = std::get<Is>(Reflection::StaticMembersOf<TFrozen>);
+		const auto& sourceMember = std::get<Is>(Reflection::StaticMembersOf<TSource>);
+		assert(frozenMember.name.View() == sourceMember.name.View()
+			&& "Frozen members must match the members of the source type in order");
+		using TMem = typename std::decay_t<decltype(frozenMember)>::Type;
+		FreezeInto<TMem>(
+			builder,
+			offset + Reflection::MemberOffset(frozenMember.location),
+			source.*(sourceMember.location));
+	}()), ...);
+}
+
+// writes the frozen form of source at offset, which was allocated for a TFrozen
+// a frozen struct is built from a source type with the same static members in the same order
+template<typename TFrozen, typename TSource>
+void FreezeInto(FrozenImageBuilder& builder, std::size_t offset, const TSource& source)
+{
+	if constexpr (IsFrozenVector<TFrozen>::value)
+	{
+		using TElement = typename TFrozen::value_type;
+		std::size_t count = source.size();
+		std::size_t first = builder.Allocate<TElement>(count);
+		std::size_t index = 0;
+		for (const auto & element : source)
+		{
+			FreezeInto<TElement>(builder, first + sizeof(TElement) * index, element);
+			++index;
+		}
+		builder.At<TFrozen>(offset)->Set(
+			count == 0 ? nullptr : builder.At<TElement>(first),
+			count);
+	}
+	else if constexpr (std::is_same<TFrozen, FrozenString>::value)
+	{
+		std::string_view chars(source);
+		if (chars.empty()) return;
+		std::size_t first = builder.Allocate<char>(chars.size() + 1);
+		std::memcpy(builder.At<char>(first), chars.data(), chars.size());
+		builder.At<FrozenString>(offset)->Set(builder.At<char>(first), chars.size());
+	}
+	else if constexpr (std::is_same<TFrozen, TSource>::value && IsFrozenLeaf<TFrozen>())
+	{
+		std::memcpy(builder.At<TFrozen>(offset), &source, sizeof(TFrozen));
+	}
+	else if constexpr (Reflection::has_GetStaticMembers<TFrozen>::value)
+	{
+		static_assert(Reflection::has_GetStaticMembers<TSource>::value
+			&& Reflection::StaticMemberCount<TFrozen>() == Reflection::StaticMemberCount<TSource>(),
+			"Frozen structs are built from a type with the same static members");
+		FreezeMembers<TFrozen>(
+			builder,
+			offset,
+			source,
+			std::make_index_sequence<Reflection::StaticMemberCount<TFrozen>()>());
+	}
+	else
+	{
+		static_assert(IsFrozenLeaf<TFrozen>() && std::is_convertible<TSource, TFrozen>::value,
+			"There is no frozen form for this source type");
+		TFrozen value = source;
+		std::memcpy(builder.At<TFrozen>(offset), &value, sizeof(TFrozen));
+	}
+}
+
+// replaces the contents of output with a frozen image of source
+template<typename TFrozen, typename TSource>
+void FreezeImage(const TSource& source, std::string& output)
+{
+	FrozenImageBuilder builder(output);
+	std::size_t rootOffset = builder.Allocate<TFrozen>(1);
+	FreezeInto<TFrozen>(builder, rootOffset, source);
+	builder.Finish(GetFrozenLayoutHash<TFrozen>(), rootOffset);
+}
+
+bool WriteFrozenImageFile(const std::string& image, const std::string& filePath);
+
+template<typename TFrozen, typename TSource>
+bool FreezeImageFile(const TSource& source, const std::string& filePath)
+{
+	std::string image;
+	FreezeImage<TFrozen>(source, image);
+	return WriteFrozenImageFile(image, filePath);
+}
+
+// checks that every offset in an image stays within it before anything is read through them
+// ranges are visited in the order FreezeInto allocates them, and each has to start after the
+// end of the last, so no range is shared or visited twice and validation is linear in the image
+class FrozenValidator
+{
+public:
+	FrozenValidator(std::string_view image)
+		: begin(image.data())
+		, end(image.data() + image.size())
+		, cursor(image.data())
+		, depth(0)
+	{ }
+
+	// the root is allocated first, so everything it points to comes after it
+	template<typename T>
+	bool ValidateRoot(const T& root)
+	{
+		cursor = reinterpret_cast<const char*>(&root + 1);
+		return Validate(root);
+	}
+
+private:
+	template<typename T>
+	bool Validate(const T& value)
+	{
+		if constexpr (!NeedsFrozenValidation<T>())
+		{
+			return true;
+		}
+		else if constexpr (IsFrozenVector<T>::value)
+		{
+			using TElement = typename T::value_type;
+			if (value.empty())
+			{
+				return value.data() == nullptr || Fail("Frozen vector is empty but points at data");
+			}
+			if (!CheckRange(&value, value.data(), value.size(), sizeof(TElement), alignof(TElement)))
+			{
+				return false;
+			}
+			if constexpr (NeedsFrozenValidation<TElement>())
+			{
+				if (++depth > MaxDepth) return Fail("Frozen image is nested too deeply");
+				for (const TElement & element : value)
+				{
+					if (!Validate(element)) return false;
+				}
+				--depth;
+			}
+			return true;
+		}
+		else if constexpr (std::is_same<T, FrozenString>::value)
+		{
+			if (value.empty()) return true;
+			// the terminator is part of the allocation
+			return CheckRange(&value, value.c_str(), value.size() + 1, 1, 1)
+				&& (value.c_str()[value.size()] == '\0'
+					|| Fail("Frozen string is missing its terminator"));
+		}
+		else
+		{
+			bool valid = true;
+			Reflection::ForEachStaticMember<T>([&](const auto& member)
+			{
+				valid = valid && Validate(value.*(member.location));
+			});
+			return valid;
+		}
+	}
+
+	// deep enough for any real asset, but stops malicious input from exhausting the stack
+	static constexpr int MaxDepth = 512;
+
+	const char* begin;
+	const char* end;
+	// the end of the last range accepted
+	const char* cursor;
+	int depth;
+
+	bool CheckRange(
+		const void* owner,
+		const void* first,
+		std::size_t count,
+		std::size_t elementSize,
+		std::size_t alignment);
+
+	bool Fail(const char* message);
+};
+
+// a frozen image opened in place, either mapped from a file or borrowed from a buffer
+// the whole image is validated on open, after that it is read directly
+template<typename T>
+class FrozenImage
+{
+public:
+	FrozenImage()
+		: file()
+		, root(nullptr)
+	{ }
+
+	FrozenImage(const FrozenImage& other) = delete;
+	FrozenImage& operator=(const FrozenImage& other) = delete;
+
+	bool OpenFile(const std::string& filePath)
+	{
+		Close();
+		if (!file.Open(filePath)) return false;
+		if (Open(file.View())) return true;
+		file.Close();
+		return false;
+	}
+
+	// image isn't copied and has to outlive this
+	bool Open(std::string_view image)
+	{
+		root = nullptr;
+		std::size_t rootOffset = ReadFrozenImageHeader(
+			image,
+			GetFrozenLayoutHash<T>(),
+			sizeof(T),
+			alignof(T));
+		if (rootOffset == 0) return false;
+		const T* candidate = reinterpret_cast<const T*>(image.data() + rootOffset);
+		if (!FrozenValidator(image).ValidateRoot(*candidate)) return false;
+		root = candidate;
+		return true;
+	}
+
+	void Close()
+	{
+		root = nullptr;
+		file.Close();
+	}
+
+	bool IsOpen() const { return root != nullptr; }
+
+	const T& Root() const
+	{
+		assert(root != nullptr);
+		return *root;
+	}
+
+	const T* operator->() const { return &Root(); }
+
+private:
+	MappedFile file;
+	const T* root;
+};
+
+} // namespace Farb
+
+#endif // FARB_FROZEN_IMAGE_H
@@ -0,0 +1,409 @@
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include "JsonTokenizer.h"
+
+namespace Farb
+{
+
+namespace
+{
+
+bool IsWhitespace(char c)
+{
+	return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+bool IsDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+bool IsNumberCharacter(char c)
+{
+	return IsDigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+// -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+bool IsValidNumber(const std::string& token, bool& isInteger)
+{
+	std::size_t i = 0;
+	const std::size_t size = token.size();
+	auto digits = [&]()
+	{
+		std::size_t start = i;
+		while (i < size && IsDigit(token[i])) ++i;
+		return i > start;
+	};
+
+	if (i < size && token[i] == '-') ++i;
+	if (i < size && token[i] == '0') ++i;
+	else if (!digits()) return false;
+
+	isInteger = true;
+	if (i < size && token[i] == '.')
+	{
+		isInteger = false;
+		++i;
+		if (!digits()) return false;
+	}
+	if (i < size && (token[i] == 'e' || token[i] == 'E'))
+	{
+		isInteger = false;
+		++i;
+		if (i < size && (token[i] == '+' || token[i] == '-')) ++i;
+		if (!digits()) return false;
+	}
+	return i == size;
+}
+
+void AppendUtf8(std::string& out, std::uint32_t codePoint)
+{
+	if (codePoint < 0x80)
+	{
+		out += static_cast<char>(codePoint);
+	}
+	else if (codePoint < 0x800)
+	{
+		out += static_cast<char>(0xC0 | (codePoint >> 6));
+		out += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+	else if (codePoint < 0x10000)
+	{
+		out += static_cast<char>(0xE0 | (codePoint >> 12));
+		out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		out += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+	else
+	{
+		out += static_cast<char>(0xF0 | (codePoint >> 18));
+		out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+		out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		out += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+}
+
+} // namespace
+
+JsonTokenizer::JsonTokenizer()
+	: token()
+	, containers()
+	, literal(nullptr)
+	, position(0)
+	, unicode(0)
+	, highSurrogate(0)
+	, unicodeDigits(0)
+	, lex(Lex::Between)
+	, expect(Expect::Value)
+	, tokenIsKey(false)
+	, failed(false)
+	, finished(false)
+{ }
+
+bool JsonTokenizer::Feed(const char* data, std::size_t size, Sax& sax)
+{
+	if (failed) return false;
+	if (finished) return Fail(sax, "input fed after Finish");
+
+	const char* end = data + size;
+	const char* current = data;
+	while (current < end)
+	{
+		char c = *current;
+		switch (lex)
+		{
+		case Lex::Between:
+			position++;
+			current++;
+			if (IsWhitespace(c)) break;
+			if (!Between(c, sax)) return false;
+			break;
+
+		case Lex::String:
+		{
+			if (highSurrogate != 0 && c != '\\')
+			{
+				position++;
+				return Fail(sax, "expected the low half of a surrogate pair");
+			}
+			// most of a string has nothing to unescape, so it's appended in one go
+			const char* run = current;
+			while (run < end
+				&& *run != '"'
+				&& *run != '\\'
+				&& static_cast<unsigned char>(*run) >= 0x20)
+			{
+				++run;
+			}
+			token.append(current, run);
+			position += run - current;
+			current = run;
+			if (current == end) break;
+
+			c = *current;
+			position++;
+			current++;
+			if (c == '"')
+			{
+				if (!EndString(sax)) return false;
+			}
+			else if (c == '\\')
+			{
+				lex = Lex::Escape;
+			}
+			else
+			{
+				return Fail(sax, "control characters must be escaped in strings");
+			}
+			break;
+		}
+
+		case Lex::Escape:
+			position++;
+			current++;
+			if (highSurrogate != 0 && c != 'u')
+			{
+				return Fail(sax, "expected the low half of a surrogate pair");
+			}
+			lex = Lex::String;
+			switch (c)
+			{
+			case '"': token += '"'; break;
+			case '\\': token += '\\'; break;
+			case '/': token += '/'; break;
+			case 'b': token += '\b'; break;
+			case 'f': token += '\f'; break;
+			case 'n': token += '\n'; break;
+			case 'r': token += '\r'; break;
+			case 't': token += '\t'; break;
+			case 'u':
+				lex = Lex::Unicode;
+				unicode = 0;
+				unicodeDigits = 0;
+				break;
+			default:
+				return Fail(sax, "invalid escape in string");
+			}
+			break;
+
+		case Lex::Unicode:
+			position++;
+			current++;
+			if (c >= '0' && c <= '9') unicode = (unicode << 4) | (c - '0');
+			else if (c >= 'a' && c <= 'f') unicode = (unicode << 4) | (c - 'a' + 10);
+			else if (c >= 'A' && c <= 'F') unicode = (unicode << 4) | (c - 'A' + 10);
+			else return Fail(sax, "\\u must be followed by four hex digits");
+			if (++unicodeDigits < 4) break;
+			if (!EndUnicode()) return Fail(sax, "invalid surrogate pair");
+			lex = Lex::String;
+			break;
+
+		case Lex::Number:
+			// a number only ends at the next character that can't be part of it,
+			// which is left for Between
+			if (!IsNumberCharacter(c))
+			{
+				if (!EndNumber(sax)) return false;
+				break;
+			}
+			position++;
+			current++;
+			token += c;
+			break;
+
+		case Lex::Literal:
+			position++;
+			current++;
+			if (literal[token.size()] != c) return Fail(sax, "invalid literal");
+			token += c;
+			if (literal[token.size()] == '\0' && !EndLiteral(sax)) return false;
+			break;
+		}
+	}
+	return true;
+}
+
+bool JsonTokenizer::Finish(Sax& sax)
+{
+	if (failed) return false;
+	if (finished) return true;
+	// a number at the top level has nothing after it to end it
+	if (lex == Lex::Number && !EndNumber(sax)) return false;
+	if (lex != Lex::Between || expect != Expect::End)
+	{
+		return Fail(sax, "unexpected end of input");
+	}
+	finished = true;
+	return true;
+}
+
+bool JsonTokenizer::Between(char c, Sax& sax)
+{
+	if (expect == Expect::End)
+	{
+		return Fail(sax, "unexpected character after the value");
+	}
+	switch (c)
+	{
+	case '{':
+		if (!ExpectsValue()) break;
+		if (!sax.start_object(std::size_t(-1))) return Fail(sax, "");
+		containers.push_back('{');
+		expect = Expect::FirstKey;
+		return true;
+
+	case '[':
+		if (!ExpectsValue()) break;
+		if (!sax.start_array(std::size_t(-1))) return Fail(sax, "");
+		containers.push_back('[');
+		expect = Expect::FirstValue;
+		return true;
+
+	case '}':
+		if (containers.empty() || containers.back() != '{') break;
+		if (expect != Expect::FirstKey && expect != Expect::CommaOrEnd) break;
+		if (!sax.end_object()) return Fail(sax, "");
+		containers.pop_back();
+		AfterValue();
+		return true;
+
+	case ']':
+		if (containers.empty() || containers.back() != '[') break;
+		if (expect != Expect::FirstValue && expect != Expect::CommaOrEnd) break;
+		if (!sax.end_array()) return Fail(sax, "");
+		containers.pop_back();
+		AfterValue();
+		return true;
+
+	case ':':
+		if (expect != Expect::Colon) break;
+		expect = Expect::Value;
+		return true;
+
+	case ',':
+		if (expect != Expect::CommaOrEnd) break;
+		expect = containers.back() == '{' ? Expect::Key : Expect::Value;
+		return true;
+
+	case '"':
+		if (!ExpectsValue() && !ExpectsKey()) break;
+		tokenIsKey = ExpectsKey();
+		token.clear();
+		lex = Lex::String;
+		return true;
+
+	case 't':
+	case 'f':
+	case 'n':
+		if (!ExpectsValue()) break;
+		literal = c == 't' ? "true" : c == 'f' ? "false" : "null";
+		token.assign(1, c);
+		lex = Lex::Literal;
+		return true;
+
+	default:
+		if (!ExpectsValue() || (c != '-' && !IsDigit(c))) break;
+		token.assign(1, c);
+		lex = Lex::Number;
+		return true;
+	}
+	return Fail(sax, std::string("unexpected '") + c + "'");
+}
+
+bool JsonTokenizer::EndString(Sax& sax)
+{
+	lex = Lex::Between;
+	if (tokenIsKey)
+	{
+		expect = Expect::Colon;
+		if (!sax.key(token)) return Fail(sax, "");
+		return true;
+	}
+	AfterValue();
+	if (!sax.string(token)) return Fail(sax, "");
+	return true;
+}
+
+bool JsonTokenizer::EndUnicode()
+{
+	if (highSurrogate != 0)
+	{
+		if (unicode < 0xDC00 || unicode > 0xDFFF) return false;
+		AppendUtf8(token, 0x10000 + ((highSurrogate - 0xD800) << 10) + (unicode - 0xDC00));
+		highSurrogate = 0;
+		return true;
+	}
+	if (unicode >= 0xDC00 && unicode <= 0xDFFF) return false;
+	if (unicode >= 0xD800 && unicode <= 0xDBFF)
+	{
+		highSurrogate = unicode;
+		return true;
+	}
+	AppendUtf8(token, unicode);
+	return true;
+}
+
+bool JsonTokenizer::EndNumber(Sax& sax)
+{
+	lex = Lex::Between;
+	bool isInteger = false;
+	if (!IsValidNumber(token, isInteger))
+	{
+		return Fail(sax, "invalid number " + token);
+	}
+	AfterValue();
+
+	// like nlohmann, integers that don't fit 64 bits become floats
+	if (isInteger)
+	{
+		errno = 0;
+		char* parsedEnd = nullptr;
+		if (token[0] == '-')
+		{
+			long long value = std::strtoll(token.c_str(), &parsedEnd, 10);
+			if (errno == 0)
+			{
+				if (!sax.number_integer(value)) return Fail(sax, "");
+				return true;
+			}
+		}
+		else
+		{
+			unsigned long long value = std::strtoull(token.c_str(), &parsedEnd, 10);
+			if (errno == 0)
+			{
+				if (!sax.number_unsigned(value)) return Fail(sax, "");
+				return true;
+			}
+		}
+	}
+	double value = std::strtod(token.c_str(), nullptr);
+	if (!sax.number_float(value, token)) return Fail(sax, "");
+	return true;
+}
+
+bool JsonTokenizer::EndLiteral(Sax& sax)
+{
+	lex = Lex::Between;
+	AfterValue();
+	bool success = literal[0] == 't' ? sax.boolean(true)
+		: literal[0] == 'f' ? sax.boolean(false)
+		: sax.null();
+	if (!success) return Fail(sax, "");
+	return true;
+}
+
+// an empty message means sax already rejected the value and logged why
+bool JsonTokenizer::Fail(Sax& sax, const std::string& message)
+{
+	failed = true;
+	if (!message.empty())
+	{
+		auto exception = nlohmann::detail::parse_error::create(101, position, message);
+		sax.parse_error(position, token, exception);
+	}
+	return false;
+}
+
+} // namespace Farb
@@ -0,0 +1,93 @@
+#ifndef FARB_JSON_TOKENIZER_H
+#define FARB_JSON_TOKENIZER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../lib/json/json.hpp"
+
+namespace Farb
+{
+
+// pushes json into a sax handler as it arrives, in chunks of any size
+// nlohmann's sax_parse pulls from its input until the value ends, so it can't
+// stop partway through and be resumed with more input later, this can
+// a token split between chunks is kept until the rest of it arrives
+// strings are passed through as bytes, only escapes are checked
+class JsonTokenizer
+{
+public:
+	using Sax = nlohmann::json::json_sax_t;
+
+	JsonTokenizer();
+
+	// calls sax for every token that completes in data
+	// false once the input is invalid or sax returns false, every later call fails too
+	bool Feed(const char* data, std::size_t size, Sax& sax);
+	// the end of the input, fails unless exactly one whole value was fed
+	bool Finish(Sax& sax);
+
+	bool Failed() const { return failed; }
+	bool Finished() const { return finished; }
+	// bytes fed so far, parse errors are reported at this position
+	std::size_t Position() const { return position; }
+
+private:
+	enum class Lex : std::uint8_t
+	{
+		Between,
+		String,
+		Escape,
+		Unicode,
+		Number,
+		Literal
+	};
+
+	enum class Expect : std::uint8_t
+	{
+		// a value, or ] right after [
+		FirstValue,
+		Value,
+		// a key, or } right after {
+		FirstKey,
+		Key,
+		Colon,
+		CommaOrEnd,
+		// the top level value ended, only whitespace may follow
+		End
+	};
+
+	bool ExpectsValue() const { return expect == Expect::FirstValue || expect == Expect::Value; }
+	bool ExpectsKey() const { return expect == Expect::FirstKey || expect == Expect::Key; }
+	void AfterValue() { expect = containers.empty() ? Expect::End : Expect::CommaOrEnd; }
+
+	// the structural characters, and the first character of every other token
+	bool Between(char c, Sax& sax);
+	bool EndString(Sax& sax);
+	bool EndUnicode();
+	bool EndNumber(Sax& sax);
+	bool EndLiteral(Sax& sax);
+	bool Fail(Sax& sax, const std::string& message);
+
+	// the string, number, or literal that is partway through
+	std::string token;
+	// '{' or '[' for every container the next token is inside of
+	std::vector<char> containers;
+	// the literal that token has to match
+	const char* literal;
+	std::size_t position;
+	// the \u escape partway through, and the high half of a surrogate pair before it
+	std::uint32_t unicode;
+	std::uint32_t highSurrogate;
+	int unicodeDigits;
+	Lex lex;
+	Expect expect;
+	bool tokenIsKey;
+	bool failed;
+	bool finished;
+};
+
+} // namespace Farb
+
+#endif // FARB_JSON_TOKENIZER_H
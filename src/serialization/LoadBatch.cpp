@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include "../utils/MappedFile.h"
+#include "Deserialization.h"
+#include "LoadBatch.h"
+
+namespace Farb
+{
+
+using namespace Reflection;
+
+namespace
+{
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void ParseJob(const LoadJob& job, LoadResult& result, PostLoadQueue& postLoads)
+{
+	auto start = std::chrono::steady_clock::now();
+	MappedFile file;
+	if (!file.Open(job.filePath))
+	{
+		result.error = "Couldn't read filePath: " + job.filePath;
+		return;
+	}
+	result.readMilliseconds = MillisecondsSince(start);
+
+	start = std::chrono::steady_clock::now();
+	result.success = DeserializeString(file.View(), job.reflect, postLoads);
+	result.parseMilliseconds = MillisecondsSince(start);
+	if (!result.success)
+	{
+		result.error = "Couldn't deserialize " + job.filePath
+			+ " into " + job.reflect.typeInfo->GetName();
+	}
+}
+
+} // namespace
+
+bool LoadBatch(
+	const std::vector<LoadJob>& jobs,
+	std::vector<LoadResult>& results,
+	unsigned int threadCount)
+{
+	results.assign(jobs.size(), LoadResult());
+	for (std::size_t i = 0; i < jobs.size(); ++i)
+	{
+		results[i].filePath = jobs[i].filePath;
+	}
+	std::vector<PostLoadQueue> postLoads(jobs.size());
+
+	if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+	threadCount = static_cast<unsigned int>(std::min<std::size_t>(threadCount, jobs.size()));
+
+	// jobs are taken in order, so the first files finish first
+	std::atomic<std::size_t> next{0};
+	auto work = [&]()
+	{
+		for (std::size_t i = next++; i < jobs.size(); i = next++)
+		{
+			ParseJob(jobs[i], results[i], postLoads[i]);
+		}
+	};
+	std::vector<std::thread> workers;
+	for (unsigned int i = 1; i < threadCount; ++i)
+	{
+		workers.emplace_back(work);
+	}
+	work();
+	for (auto & worker : workers)
+	{
+		worker.join();
+	}
+
+	bool success = true;
+	for (std::size_t i = 0; i < jobs.size(); ++i)
+	{
+		LoadResult& result = results[i];
+		if (!result.success)
+		{
+			success = false;
+			continue;
+		}
+		auto start = std::chrono::steady_clock::now();
+		auto postLoaded = postLoads[i].Run(jobs[i].reflect);
+		result.postLoadMilliseconds = MillisecondsSince(start);
+		if (postLoaded.IsError())
+		{
+			result.success = false;
+			result.error = postLoaded.GetError().Message();
+			success = false;
+		}
+	}
+	return success;
+}
+
+std::string LoadReport(const std::vector<LoadResult>& results)
+{
+	std::ostringstream report;
+	report << std::fixed << std::setprecision(3)
+		<< std::setw(10) << "read ms"
+		<< std::setw(10) << "parse ms"
+		<< std::setw(13) << "postload ms"
+		<< "  file\n";
+	for (const auto & result : results)
+	{
+		report << std::setw(10) << result.readMilliseconds
+			<< std::setw(10) << result.parseMilliseconds
+			<< std::setw(13) << result.postLoadMilliseconds
+			<< "  " << result.filePath;
+		if (!result.success) report << "\n    " << result.error;
+		report << "\n";
+	}
+	return report.str();
+}
+
+} // namespace Farb
@@ -0,0 +1,46 @@
+#ifndef FARB_LOAD_BATCH_H
+#define FARB_LOAD_BATCH_H
+
+#include <string>
+#include <vector>
+
+#include "../reflection/ReflectionDeclare.h"
+
+namespace Farb
+{
+
+struct LoadJob
+{
+	std::string filePath;
+	Reflection::ReflectionObject reflect;
+};
+
+struct LoadResult
+{
+	std::string filePath;
+	bool success = false;
+	// empty on success, parse errors are also logged as they happen
+	std::string error;
+	// files are mapped, so most of the reading shows up as page faults in parseMilliseconds
+	double readMilliseconds = 0.0;
+	double parseMilliseconds = 0.0;
+	double postLoadMilliseconds = 0.0;
+};
+
+// reads and parses the file of every job on a pool of threads, then runs their PostLoad
+// hooks on the calling thread, job by job in the order given, so hooks that load images
+// or share resources run in the same order as loading the files one at a time
+// jobs must not share objects or a DeserializationContext
+// results gets one entry per job, returns false if any job failed
+// threadCount 0 uses one thread per core
+bool LoadBatch(
+	const std::vector<LoadJob>& jobs,
+	std::vector<LoadResult>& results,
+	unsigned int threadCount = 0);
+
+// a row per file, for logging where startup time goes
+std::string LoadReport(const std::vector<LoadResult>& results);
+
+} // namespace Farb
+
+#endif // FARB_LOAD_BATCH_H
@@ -0,0 +1,61 @@
+#include <fstream>
+
+#include "Serialization.h"
+
+namespace Farb
+{
+
+using namespace Reflection;
+
+namespace
+{
+
+bool Serialize(ReflectionObject reflect, JsonWriter& writer)
+{
+	auto result = reflect.Serialize(writer);
+	if (result.IsError())
+	{
+		Error("Serialize failed for " + reflect.typeInfo->GetName()).Log();
+		result.GetError().Log(1);
+		return false;
+	}
+	return true;
+}
+
+} // namespace
+
+bool SerializeString(
+	ReflectionObject reflect,
+	std::string& output,
+	JsonWriter::Mode mode /* = JsonWriter::Mode::Compact */)
+{
+	JsonWriter writer(output, mode);
+	return Serialize(reflect, writer);
+}
+
+bool SerializeStream(
+	ReflectionObject reflect,
+	std::ostream& output,
+	JsonWriter::Mode mode /* = JsonWriter::Mode::Compact */)
+{
+	JsonWriter writer(output, mode);
+	bool success = Serialize(reflect, writer);
+	writer.Flush();
+	return success && !output.fail();
+}
+
+bool SerializeFile(
+	ReflectionObject reflect,
+	std::string filePath,
+	JsonWriter::Mode mode /* = JsonWriter::Mode::Pretty */)
+{
+	std::ofstream outputFile(filePath);
+	if (outputFile.fail())
+	{
+		Error("Couldn't open filePath: " + filePath).Log();
+		return false;
+	}
+	return SerializeStream(reflect, outputFile, mode);
+}
+
+} // namespace Farb
@@ -0,0 +1,34 @@
+#ifndef FARB_SERIALIZATION_H
+#define FARB_SERIALIZATION_H
+
+#include <ostream>
+#include <string>
+
+#include "../reflection/ReflectionDeclare.h"
+#include "Writer.h"
+
+namespace Farb
+{
+
+// all of these write JSON that DeserializeString/DeserializeFile read back
+// errors are logged and return false, output may be partially written
+
+// appends to output, so a buffer can be reused without reallocating
+bool SerializeString(
+	Reflection::ReflectionObject reflect,
+	std::string& output,
+	JsonWriter::Mode mode = JsonWriter::Mode::Compact);
+
+bool SerializeStream(
+	Reflection::ReflectionObject reflect,
+	std::ostream& output,
+	JsonWriter::Mode mode = JsonWriter::Mode::Compact);
+
+bool SerializeFile(
+	Reflection::ReflectionObject reflect,
+	std::string filePath,
+	JsonWriter::Mode mode = JsonWriter::Mode::Pretty);
+
+} // namespace Farb
+
+#endif // FARB_SERIALIZATION_H
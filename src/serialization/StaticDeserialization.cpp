@@ -0,0 +1,310 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../../lib/json/json.hpp"
+
+#include "../reflection/ReflectionBasics.h"
+#include "../utils/MappedFile.h"
+#include "StaticDeserialization.h"
+
+namespace Farb
+{
+
+using json = nlohmann::json;
+using namespace Reflection;
+
+namespace
+{
+
+SaxFrame MakeDynamicFrame(ReflectionObject reflect)
+{
+	return SaxFrame{
+		reflect.location,
+		GetDynamicSaxHandlers(),
+		reflect.typeInfo,
+		-1,
+		false,
+		false,
+		reflect.context
+	};
+}
+
+ReflectionObject ReflectFrame(const SaxFrame& frame)
+{
+	return ReflectionObject(frame.location, frame.typeInfo, frame.context);
+}
+
+bool DynamicBool(SaxFrame& frame, bool value)
+{
+	return ReflectFrame(frame).AssignBool(value);
+}
+
+bool DynamicUInt(SaxFrame& frame, uint value)
+{
+	return ReflectFrame(frame).AssignUInt(value);
+}
+
+bool DynamicInt(SaxFrame& frame, int value)
+{
+	return ReflectFrame(frame).AssignInt(value);
+}
+
+bool DynamicFloat(SaxFrame& frame, float value)
+{
+	return ReflectFrame(frame).AssignFloat(value);
+}
+
+bool DynamicString(SaxFrame& frame, std::string& value)
+{
+	return ReflectFrame(frame).AssignString(std::move(value));
+}
+
+bool DynamicKey(SaxFrame& frame, std::string& key, SaxFrame& child)
+{
+	ReflectionObject reflect = ReflectFrame(frame);
+	// struct member names are already interned, so an unknown key never grows the pool
+	// only tables construct their entries from the key
+	HString name = reflect.typeInfo->GetMemberLookupTable() != nullptr
+		? HString::Find(key)
+		: HString(key);
+	if (name.Empty() && !key.empty())
+	{
+		Error(reflect.typeInfo->GetName() + " has no member named " + key).Log();
+		return false;
+	}
+	if (!reflect.InsertKey(name)) { return false; }
+	auto result = reflect.GetAtKey(name);
+	if (result.IsError())
+	{
+		result.GetError().Log();
+		return false;
+	}
+	child = MakeDynamicFrame(result.GetValue());
+	return true;
+}
+
+bool DynamicNextElement(SaxFrame& frame, SaxFrame& child)
+{
+	if (!ReflectFrame(frame).PushBackDefault()) { return false; }
+	frame.arrayIndex++;
+	auto result = ReflectFrame(frame).GetAtIndex(frame.arrayIndex);
+	if (result.IsError())
+	{
+		result.GetError().Log();
+		return false;
+	}
+	child = MakeDynamicFrame(result.GetValue());
+	return true;
+}
+
+bool DynamicObjectEnd(SaxFrame& frame)
+{
+	return ReflectFrame(frame).ObjectEnd();
+}
+
+bool DynamicArrayEnd(SaxFrame& frame)
+{
+	return ReflectFrame(frame).ArrayEnd();
+}
+
+// the same state machine as DeserializationParser
+// but each event is a call through the handlers of the frame on top of the stack
+class StaticDeserializationParser : public json::json_sax_t
+{
+public:
+	// only the dynamic fallback handlers keep pending values
+	DeserializationContext context;
+	std::vector<SaxFrame> stack;
+
+	StaticDeserializationParser(SaxFrame root)
+		: context()
+		, stack()
+	{
+		stack.reserve(32);
+		if (root.context == nullptr) root.context = &context;
+		stack.push_back(root);
+	}
+
+	bool null()
+	{
+		Error("json null not implemented").Log();
+		return false;
+	}
+
+	bool boolean(bool val)
+	{
+		if (!UpkeepForValueStart()) { return false; }
+		auto pAssign = stack.back().handlers->pBool;
+		bool success = pAssign != nullptr && pAssign(stack.back(), val);
+		if (!success) { Error("Assign bool failed " + ToString(val)).Log(); }
+		stack.pop_back();
+		return success;
+	}
+
+	bool number_integer(number_integer_t val)
+	{
+		if (!UpkeepForValueStart()) { return false; }
+		auto pAssign = stack.back().handlers->pInt;
+		bool success = pAssign != nullptr && pAssign(stack.back(), val);
+		if (!success) { Error("Assign int failed " + ToString((int)val)).Log(); }
+		stack.pop_back();
+		return success;
+	}
+
+	bool number_unsigned(number_unsigned_t val)
+	{
+		if (!UpkeepForValueStart()) { return false; }
+		auto pAssign = stack.back().handlers->pUInt;
+		bool success = pAssign != nullptr && pAssign(stack.back(), val);
+		if (!success) { Error("Assign uint failed " + ToString((uint)val)).Log(); }
+		stack.pop_back();
+		return success;
+	}
+
+	bool number_float(number_float_t val, const string_t& s)
+	{
+		if (!UpkeepForValueStart()) { return false; }
+		auto pAssign = stack.back().handlers->pFloat;
+		bool success = pAssign != nullptr && pAssign(stack.back(), val);
+		if (!success) { Error("Assign float failed " + s).Log(); }
+		stack.pop_back();
+		return success;
+	}
+
+	bool string(string_t& val)
+	{
+		if (!UpkeepForValueStart()) { return false; }
+		auto pAssign = stack.back().handlers->pString;
+		bool success = pAssign != nullptr && pAssign(stack.back(), val);
+		if (!success) { Error("Assign string failed " + val).Log(); }
+		stack.pop_back();
+		return success;
+	}
+
+	bool start_object(std::size_t elements)
+	{
+		if (!UpkeepForValueStart()) { return false; }
+		stack.back().inObject = true;
+		return true;
+	}
+
+	bool end_object()
+	{
+		if (stack.empty()) { return false; }
+		if (!stack.back().inObject) { return false; }
+		stack.back().inObject = false;
+		auto pObjectEnd = stack.back().handlers->pObjectEnd;
+		if (pObjectEnd != nullptr && !pObjectEnd(stack.back())) { return false; }
+		stack.pop_back();
+		return true;
+	}
+
+	bool start_array(std::size_t elements)
+	{
+		if (!UpkeepForValueStart()) { return false; }
+		stack.back().inArray = true;
+		return true;
+	}
+
+	bool end_array()
+	{
+		if (stack.empty()) { return false; }
+		stack.back().inArray = false;
+		auto pArrayEnd = stack.back().handlers->pArrayEnd;
+		if (pArrayEnd != nullptr && !pArrayEnd(stack.back())) { return false; }
+		stack.pop_back();
+		return true;
+	}
+
+	bool key(string_t& val)
+	{
+		if (stack.empty()) { return false; }
+		if (!stack.back().inObject) { return false; }
+		auto pKey = stack.back().handlers->pKey;
+		if (pKey == nullptr)
+		{
+			Error("Value of this type can't be deserialized from an object, key " + val).Log();
+			return false;
+		}
+		SaxFrame child;
+		if (!pKey(stack.back(), val, child)) { return false; }
+		child.context = stack.back().context;
+		stack.push_back(child);
+		return true;
+	}
+
+	bool parse_error(
+		std::size_t position,
+		const std::string& last_token,
+		const nlohmann::detail::exception& ex)
+	{
+		Error(
+			"Parse Error during static deserialization"
+			"\n last token was: "
+			+ last_token
+			+ "\n at: "
+			+ std::to_string(position)
+			+ "\n exception: "
+			+ ex.what()).Log();
+		return false;
+	}
+
+protected:
+	bool UpkeepForValueStart()
+	{
+		if (stack.empty())
+		{
+			Error("Stack is empty").Log();
+			return false;
+		}
+		if (!stack.back().inArray)
+		{
+			return true;
+		}
+		auto pNextElement = stack.back().handlers->pNextElement;
+		SaxFrame child;
+		if (pNextElement == nullptr || !pNextElement(stack.back(), child))
+		{
+			Error("Array setup failed").Log();
+			return false;
+		}
+		child.context = stack.back().context;
+		stack.push_back(child);
+		return true;
+	}
+}; // class StaticDeserializationParser
+
+} // namespace
+
+const SaxHandlers* GetDynamicSaxHandlers()
+{
+	static const SaxHandlers handlers {
+		DynamicBool,
+		DynamicUInt,
+		DynamicInt,
+		DynamicFloat,
+		DynamicString,
+		DynamicKey,
+		DynamicNextElement,
+		DynamicObjectEnd,
+		DynamicArrayEnd
+	};
+	return &handlers;
+}
+
+bool DeserializeStringStatic(const std::string& input, SaxFrame root)
+{
+	StaticDeserializationParser parser(root);
+	return json::sax_parse(input, &parser);
+}
+
+bool DeserializeFileStatic(const std::string& filePath, SaxFrame root)
+{
+	MappedFile file;
+	if (!file.Open(filePath)) return false;
+	StaticDeserializationParser parser(root);
+	return json::sax_parse(nlohmann::detail::input_adapter(file.Data(), file.Size()), &parser);
+}
+
+} // namespace Farb
@@ -0,0 +1,314 @@
+#ifndef FARB_STATIC_DESERIALIZATION_H
+#define FARB_STATIC_DESERIALIZATION_H
+
+#include <limits.h>
+#include <string>
+#include <vector>
+
+#include "../reflection/ReflectionDeclare.h"
+#include "../reflection/ReflectionStatic.hpp"
+#include "../utils/TypeInspection.hpp"
+
+namespace Farb
+{
+
+// Deserialization for types that declare GetStaticMembers
+// every JSON value is handled by a function generated for the C++ type it is
+// written into, so members, std::vector elements and primitives are assigned
+// directly instead of through TypeInfo virtuals and ReflectionObjects.
+// Values of any other type fall back to the dynamic TypeInfo interface.
+
+struct SaxHandlers;
+
+struct SaxFrame
+{
+	byte* location;
+	const SaxHandlers* handlers;
+	// only used by the dynamic fallback handlers
+	Reflection::TypeInfo* typeInfo;
+	int arrayIndex;
+	bool inObject;
+	bool inArray;
+	// set by the parser for every frame it pushes
+	Reflection::DeserializationContext* context;
+};
+
+// nullptr means values of that kind are not accepted
+struct SaxHandlers
+{
+	bool (*pBool)(SaxFrame& frame, bool value);
+	bool (*pUInt)(SaxFrame& frame, uint value);
+	bool (*pInt)(SaxFrame& frame, int value);
+	bool (*pFloat)(SaxFrame& frame, float value);
+	bool (*pString)(SaxFrame& frame, std::string& value);
+	// sets up child to point at the member named key
+	bool (*pKey)(SaxFrame& frame, std::string& key, SaxFrame& child);
+	// sets up child to point at the next array element
+	bool (*pNextElement)(SaxFrame& frame, SaxFrame& child);
+	bool (*pObjectEnd)(SaxFrame& frame);
+	bool (*pArrayEnd)(SaxFrame& frame);
+};
+
+// handlers that forward to frame.typeInfo
+const SaxHandlers* GetDynamicSaxHandlers();
+
+bool DeserializeStringStatic(const std::string& input, SaxFrame root);
+bool DeserializeFileStatic(const std::string& filePath, SaxFrame root);
+
+template<typename T>
+const SaxHandlers* GetSaxHandlers();
+
+template<typename T>
+SaxFrame MakeSaxFrame(T& object)
+{
+	const SaxHandlers* handlers = GetSaxHandlers<T>();
+	return SaxFrame{
+		reinterpret_cast<byte*>(&object),
+		handlers,
+		handlers == GetDynamicSaxHandlers() ? Reflection::GetTypeInfo(object) : nullptr,
+		-1,
+		false,
+		false,
+		nullptr
+	};
+}
+
+template<typename T>
+bool DeserializeStringStatic(const std::string& input, T& object)
+{
+	return DeserializeStringStatic(input, MakeSaxFrame(object));
+}
+
+template<typename T>
+bool DeserializeFileStatic(const std::string& filePath, T& object)
+{
+	return DeserializeFileStatic(filePath, MakeSaxFrame(object));
+}
+
+namespace StaticDeserialization
+{
+
+template<typename T>
+struct IsLeaf
+{
+	static constexpr bool value = std::is_same<T, bool>::value
+		|| std::is_same<T, uint>::value
+		|| std::is_same<T, int>::value
+		|| std::is_same<T, float>::value
+		|| std::is_same<T, std::string>::value
+		|| std::is_same<T, HString>::value;
+};
+
+// the same conversions that ReflectionBasics registers for these types
+template<typename T, typename TArg>
+bool AssignLeaf(T& object, TArg value)
+{
+	if constexpr (std::is_same<T, TArg>::value)
+	{
+		object = std::move(value);
+		return true;
+	}
+	else if constexpr (std::is_same<T, bool>::value && std::is_integral<TArg>::value)
+	{
+		if (value != 0 && value != 1) return false;
+		object = value == 1;
+		return true;
+	}
+	else if constexpr (std::is_same<T, uint>::value && std::is_same<TArg, int>::value)
+	{
+		if (value < 0) return false;
+		object = static_cast<uint>(value);
+		return true;
+	}
+	else if constexpr (std::is_same<T, int>::value && std::is_same<TArg, uint>::value)
+	{
+		if (value > INT_MAX) return false;
+		object = static_cast<int>(value);
+		return true;
+	}
+	else if constexpr (std::is_same<T, float>::value && !std::is_same<TArg, std::string>::value
+		&& !std::is_same<TArg, bool>::value)
+	{
+		object = static_cast<float>(value);
+		return true;
+	}
+	else if constexpr (std::is_same<T, HString>::value && std::is_same<TArg, std::string>::value)
+	{
+		object = HString(value);
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+template<typename T, typename TArg>
+bool LeafHandler(SaxFrame& frame, TArg value)
+{
+	return AssignLeaf(*reinterpret_cast<T*>(frame.location), value);
+}
+
+template<typename T>
+bool LeafStringHandler(SaxFrame& frame, std::string& value)
+{
+	return AssignLeaf(*reinterpret_cast<T*>(frame.location), std::move(value));
+}
+
+template<typename T>
+bool StructKeyHandler(SaxFrame& frame, std::string& key, SaxFrame& child)
+{
+	T* t = reinterpret_cast<T*>(frame.location);
+	bool found = Reflection::VisitStaticMember<T>(std::string_view(key), [&](const auto& member)
+	{
+		child = MakeSaxFrame(t->*(member.location));
+	});
+	if (!found)
+	{
+		Error(std::string("static struct has no member named ") + key).Log();
+	}
+	return found;
+}
+
+// arrays can be deserialized into structs, one member per element
+template<typename T>
+bool StructNextElementHandler(SaxFrame& frame, SaxFrame& child)
+{
+	T* t = reinterpret_cast<T*>(frame.location);
+	frame.arrayIndex++;
+	return Reflection::VisitStaticMember<T>(frame.arrayIndex, [&](const auto& member)
+	{
+		child = MakeSaxFrame(t->*(member.location));
+	});
+}
+
+template<typename T>
+bool StructEndHandler(SaxFrame& frame)
+{
+	if constexpr (Reflection::has_PostLoad<T>::value)
+	{
+		return T::PostLoad(*reinterpret_cast<T*>(frame.location));
+	}
+	else
+	{
+		return true;
+	}
+}
+
+template<typename T>
+bool VectorNextElementHandler(SaxFrame& frame, SaxFrame& child)
+{
+	T* t = reinterpret_cast<T*>(frame.location);
+	t->emplace_back();
+	frame.arrayIndex++;
+	child = MakeSaxFrame(t->back());
+	return true;
+}
+
+template<typename T>
+bool FixedArrayNextElementHandler(SaxFrame& frame, SaxFrame& child)
+{
+	T* t = reinterpret_cast<T*>(frame.location);
+	if (frame.arrayIndex + 1 >= static_cast<int>(std::extent<T>::value))
+	{
+		Error("fixed array was given more than " + std::to_string(std::extent<T>::value) + " elements").Log();
+		return false;
+	}
+	frame.arrayIndex++;
+	child = MakeSaxFrame((*t)[frame.arrayIndex]);
+	return true;
+}
+
+template<typename T>
+bool FixedArrayEndHandler(SaxFrame& frame)
+{
+	if (frame.arrayIndex + 1 != static_cast<int>(std::extent<T>::value))
+	{
+		Error("fixed array expects " + std::to_string(std::extent<T>::value)
+			+ " elements but was given " + std::to_string(frame.arrayIndex + 1)).Log();
+		return false;
+	}
+	return true;
+}
+
+inline bool ContainerEndHandler(SaxFrame& frame)
+{
+	return true;
+}
+
+} // namespace StaticDeserialization
+
+template<typename T>
+const SaxHandlers* GetSaxHandlers()
+{
+	using namespace StaticDeserialization;
+	if constexpr (Reflection::has_GetStaticMembers<T>::value)
+	{
+		static const SaxHandlers handlers {
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			StructKeyHandler<T>,
+			StructNextElementHandler<T>,
+			StructEndHandler<T>,
+			ContainerEndHandler
+		};
+		return &handlers;
+	}
+	else if constexpr (IsLeaf<T>::value)
+	{
+		static const SaxHandlers handlers {
+			LeafHandler<T, bool>,
+			LeafHandler<T, uint>,
+			LeafHandler<T, int>,
+			LeafHandler<T, float>,
+			LeafStringHandler<T>,
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr
+		};
+		return &handlers;
+	}
+	else if constexpr (IsSpecialization<T, std::vector>::value
+		&& !std::is_same<T, std::vector<bool> >::value)
+	{
+		static const SaxHandlers handlers {
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			VectorNextElementHandler<T>,
+			nullptr,
+			ContainerEndHandler
+		};
+		return &handlers;
+	}
+	else if constexpr (std::is_array<T>::value)
+	{
+		static const SaxHandlers handlers {
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			nullptr,
+			FixedArrayNextElementHandler<T>,
+			nullptr,
+			FixedArrayEndHandler<T>
+		};
+		return &handlers;
+	}
+	else
+	{
+		return GetDynamicSaxHandlers();
+	}
+}
+
+} // namespace Farb
+
+#endif // FARB_STATIC_DESERIALIZATION_H
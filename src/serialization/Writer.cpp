@@ -0,0 +1,223 @@
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+#include "Writer.h"
+
+namespace Farb
+{
+
+namespace
+{
+
+// streams are written to once this much output is buffered
+constexpr std::size_t StreamFlushThreshold = 64 * 1024;
+
+template<typename T>
+void AppendInteger(std::string& output, T value)
+{
+	char digits[24];
+	auto result = std::to_chars(digits, digits + sizeof(digits), value);
+	output.append(digits, result.ptr - digits);
+}
+
+} // namespace
+
+JsonWriter::JsonWriter(std::string& buffer, Mode mode /* = Mode::Compact */)
+	: output(buffer)
+	, ownedBuffer()
+	, stream(nullptr)
+	, mode(mode)
+	, scopes()
+	, afterKey(false)
+	, wroteRoot(false)
+{ }
+
+JsonWriter::JsonWriter(std::ostream& stream, Mode mode /* = Mode::Compact */)
+	: output(ownedBuffer)
+	, ownedBuffer()
+	, stream(&stream)
+	, mode(mode)
+	, scopes()
+	, afterKey(false)
+	, wroteRoot(false)
+{
+	ownedBuffer.reserve(StreamFlushThreshold * 2);
+}
+
+JsonWriter::~JsonWriter()
+{
+	Flush();
+}
+
+void JsonWriter::Flush()
+{
+	if (stream == nullptr) return;
+	stream->write(output.data(), output.size());
+	output.clear();
+}
+
+void JsonWriter::FlushIfFull()
+{
+	if (stream != nullptr && output.size() >= StreamFlushThreshold)
+	{
+		Flush();
+	}
+}
+
+void JsonWriter::NewLine()
+{
+	output += '\n';
+	output.append(scopes.size(), '\t');
+}
+
+// handles separators so each value function only writes its own contents
+void JsonWriter::BeforeValue()
+{
+	if (afterKey)
+	{
+		afterKey = false;
+		return;
+	}
+	if (scopes.empty())
+	{
+		// a new document after a complete one, i.e. a reused buffer
+		if (wroteRoot && mode == Mode::Pretty) output += '\n';
+		wroteRoot = true;
+		return;
+	}
+	Scope& scope = scopes.back();
+	assert(!scope.isObject && "values inside of an object must follow a key");
+	if (!scope.empty) output += ',';
+	scope.empty = false;
+	if (mode == Mode::Pretty) NewLine();
+}
+
+void JsonWriter::Open(char bracket, bool isObject)
+{
+	BeforeValue();
+	output += bracket;
+	scopes.push_back(Scope{isObject, true});
+}
+
+void JsonWriter::Close(char bracket)
+{
+	assert(!scopes.empty() && !afterKey);
+	bool empty = scopes.back().empty;
+	scopes.pop_back();
+	if (mode == Mode::Pretty && !empty) NewLine();
+	output += bracket;
+	FlushIfFull();
+}
+
+void JsonWriter::BeginObject()
+{
+	Open('{', true);
+}
+
+void JsonWriter::Key(std::string_view key)
+{
+	assert(!scopes.empty() && scopes.back().isObject && !afterKey);
+	Scope& scope = scopes.back();
+	if (!scope.empty) output += ',';
+	scope.empty = false;
+	if (mode == Mode::Pretty) NewLine();
+	AppendEscaped(key);
+	output += ':';
+	if (mode == Mode::Pretty) output += ' ';
+	afterKey = true;
+}
+
+void JsonWriter::EndObject()
+{
+	assert(scopes.back().isObject);
+	Close('}');
+}
+
+void JsonWriter::BeginArray(std::size_t size)
+{
+	Open('[', false);
+}
+
+void JsonWriter::EndArray()
+{
+	assert(!scopes.back().isObject);
+	Close(']');
+}
+
+void JsonWriter::Bool(bool value)
+{
+	BeforeValue();
+	output += value ? "true" : "false";
+}
+
+void JsonWriter::UInt(uint value)
+{
+	BeforeValue();
+	AppendInteger(output, value);
+}
+
+void JsonWriter::Int(int value)
+{
+	BeforeValue();
+	AppendInteger(output, value);
+}
+
+void JsonWriter::Float(float value)
+{
+	BeforeValue();
+	if (!std::isfinite(value))
+	{
+		output += "null";
+		return;
+	}
+	// 9 significant digits is enough for any float to read back exactly
+	char digits[32];
+	int length = std::snprintf(digits, sizeof(digits), "%.9g", value);
+	output.append(digits, length);
+}
+
+void JsonWriter::String(std::string_view value)
+{
+	BeforeValue();
+	AppendEscaped(value);
+	FlushIfFull();
+}
+
+void JsonWriter::AppendEscaped(std::string_view value)
+{
+	static const char hexDigits[] = "0123456789abcdef";
+	output += '"';
+	std::size_t runStart = 0;
+	for (std::size_t i = 0; i < value.size(); ++i)
+	{
+		unsigned char c = static_cast<unsigned char>(value[i]);
+		if (c >= 0x20 && c != '"' && c != '\\')
+		{
+			continue;
+		}
+		// copy everything that didn't need escaping in one go
+		output.append(value.data() + runStart, i - runStart);
+		runStart = i + 1;
+		switch (c)
+		{
+		case '"': output += "\\\""; break;
+		case '\\': output += "\\\\"; break;
+		case '\n': output += "\\n"; break;
+		case '\r': output += "\\r"; break;
+		case '\t': output += "\\t"; break;
+		case '\b': output += "\\b"; break;
+		case '\f': output += "\\f"; break;
+		default:
+			output += "\\u00";
+			output += hexDigits[c >> 4];
+			output += hexDigits[c & 0xF];
+			break;
+		}
+	}
+	output.append(value.data() + runStart, value.size() - runStart);
+	output += '"';
+}
+
+} // namespace Farb
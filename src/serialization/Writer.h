@@ -0,0 +1,120 @@
+#ifndef FARB_WRITER_H
+#define FARB_WRITER_H
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../core/BuiltinTypedefs.h"
+
+namespace Farb
+{
+
+// receives values in document order, the inverse of the deserialization parser
+// keys are only valid directly inside of an object, and every key is
+// followed by exactly one value, object, or array
+class Writer
+{
+public:
+	virtual ~Writer() { }
+
+	virtual void BeginObject() = 0;
+	virtual void Key(std::string_view key) = 0;
+	virtual void EndObject() = 0;
+
+	// size is the number of values that will be written before EndArray
+	virtual void BeginArray(std::size_t size) = 0;
+	virtual void EndArray() = 0;
+
+	virtual void Bool(bool value) = 0;
+	virtual void UInt(uint value) = 0;
+	virtual void Int(int value) = 0;
+	virtual void Float(float value) = 0;
+	virtual void String(std::string_view value) = 0;
+
+	// member names are interned, writers that index keys can use the precomputed hash
+	virtual void Key(const HString& key) { Key(key.View()); }
+	// a named enum value, either form can be assigned back to the enum
+	virtual void Enum(const HString& name, int value) { String(name.View()); }
+	void String(const HString& value) { String(value.View()); }
+	// without these string literals would be ambiguous between the overloads above
+	void Key(const char* key) { Key(std::string_view(key)); }
+	void String(const char* value) { String(std::string_view(value)); }
+	void Key(const std::string& key) { Key(std::string_view(key)); }
+	void String(const std::string& value) { String(std::string_view(value)); }
+};
+
+// writes JSON that DeserializeString reads back
+// output is appended to a caller owned buffer, which is never cleared
+// so the same buffer can be reused across frames without reallocating,
+// or to a stream, which is written to in large chunks
+class JsonWriter : public Writer
+{
+public:
+	enum class Mode
+	{
+		// no whitespace at all
+		Compact,
+		// one value per line, indented with tabs
+		Pretty
+	};
+
+	JsonWriter(std::string& buffer, Mode mode = Mode::Compact);
+	JsonWriter(std::ostream& stream, Mode mode = Mode::Compact);
+	virtual ~JsonWriter();
+
+	JsonWriter(const JsonWriter& other) = delete;
+	JsonWriter& operator=(const JsonWriter& other) = delete;
+
+	virtual void BeginObject() override;
+	virtual void Key(std::string_view key) override;
+	virtual void EndObject() override;
+
+	virtual void BeginArray(std::size_t size) override;
+	virtual void EndArray() override;
+
+	virtual void Bool(bool value) override;
+	virtual void UInt(uint value) override;
+	virtual void Int(int value) override;
+	// non finite values have no JSON representation and are written as null
+	virtual void Float(float value) override;
+	virtual void String(std::string_view value) override;
+
+	using Writer::Key;
+	using Writer::String;
+
+	// only needed for streams, writes everything buffered so far
+	void Flush();
+
+	// true once every object and array that was begun has ended
+	bool Complete() const { return scopes.empty() && wroteRoot; }
+
+private:
+	struct Scope
+	{
+		bool isObject;
+		bool empty;
+	};
+
+	// the buffer we append to, either the caller's or ownedBuffer for streams
+	std::string& output;
+	std::string ownedBuffer;
+	std::ostream* stream;
+	Mode mode;
+	// one per open object or array, reused between documents
+	std::vector<Scope> scopes;
+	bool afterKey;
+	bool wroteRoot;
+
+	void BeforeValue();
+	void Open(char bracket, bool isObject);
+	void Close(char bracket);
+	void NewLine();
+	void AppendEscaped(std::string_view value);
+	void FlushIfFull();
+};
+
+} // namespace Farb
+
+#endif // FARB_WRITER_H
@@ -0,0 +1,59 @@
+#ifndef FARB_COUNT_ALLOCATIONS_HPP
+#define FARB_COUNT_ALLOCATIONS_HPP
+
+#include <cstdlib>
+#include <new>
+
+// counts calls to the global operator new, for tests and benchmarks of paths that
+// shouldn't allocate
+// this replaces the global allocation functions for the whole binary, so it must only
+// end up in the translation unit with main, RunTests.cpp or RunBenchmarks.cpp,
+// and never in the engine
+
+// kept out of line, otherwise the compiler sees free called on memory from a new expression
+#if defined(_MSC_VER)
+#define FARB_ALLOCATION_FUNCTION __declspec(noinline)
+#else
+#define FARB_ALLOCATION_FUNCTION __attribute__((noinline))
+#endif
+
+namespace Farb
+{
+
+// only allocations made by the counting thread are counted, tests run threads of their own
+inline thread_local bool countAllocations = false;
+inline thread_local std::size_t allocationCount = 0;
+
+template<typename TFunc>
+std::size_t CountAllocations(TFunc&& func)
+{
+	allocationCount = 0;
+	countAllocations = true;
+	func();
+	countAllocations = false;
+	return allocationCount;
+}
+
+} // namespace Farb
+
+FARB_ALLOCATION_FUNCTION void* operator new(std::size_t size)
+{
+	if (Farb::countAllocations) ++Farb::allocationCount;
+	void* memory = std::malloc(size == 0 ? 1 : size);
+	if (memory == nullptr) throw std::bad_alloc();
+	return memory;
+}
+
+FARB_ALLOCATION_FUNCTION void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+FARB_ALLOCATION_FUNCTION void operator delete(void* memory, std::size_t) noexcept
+{
+	::operator delete(memory);
+}
+
+#undef FARB_ALLOCATION_FUNCTION
+
+#endif // FARB_COUNT_ALLOCATIONS_HPP
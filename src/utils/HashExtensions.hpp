@@ -0,0 +1,130 @@
+#ifndef FARB_HASH_EXTENSIONS_HPP
+#define FARB_HASH_EXTENSIONS_HPP
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Farb
+{
+
+// fast non-cryptographic hashing for in memory cache keys
+// the results may change between versions, so they shouldn't be stored
+
+constexpr std::uint64_t HashSeed = 0x9E3779B97F4A7C15ull;
+constexpr std::uint64_t HashPrimes[] = {
+	0xA0761D6478BD642Full,
+	0xE7037ED1A0B428DBull,
+	0x8EBC6AF09C88C6E3ull,
+	0x589965CC75374CC3ull
+};
+
+// folds the 128 bit product, like wyhash
+inline std::uint64_t HashMix(std::uint64_t a, std::uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+	// __int128 is a gcc and clang extension, __extension__ keeps -pedantic quiet
+	__extension__ typedef unsigned __int128 uint128;
+	uint128 product = static_cast<uint128>(a) * b;
+	return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+	// the same product from 32 bit halves
+	std::uint64_t aLow = a & 0xFFFFFFFFull;
+	std::uint64_t aHigh = a >> 32;
+	std::uint64_t bLow = b & 0xFFFFFFFFull;
+	std::uint64_t bHigh = b >> 32;
+	std::uint64_t lowLow = aLow * bLow;
+	std::uint64_t highLow = aHigh * bLow;
+	std::uint64_t lowHigh = aLow * bHigh;
+	std::uint64_t highHigh = aHigh * bHigh;
+	std::uint64_t middle = (lowLow >> 32) + (highLow & 0xFFFFFFFFull) + lowHigh;
+	std::uint64_t low = (middle << 32) | (lowLow & 0xFFFFFFFFull);
+	std::uint64_t high = highHigh + (highLow >> 32) + (middle >> 32);
+	return low ^ high;
+#endif
+}
+
+inline std::uint64_t HashInt(std::uint64_t value)
+{
+	return HashMix(value ^ HashPrimes[0], HashPrimes[1]);
+}
+
+// order dependent, HashCombine(a, b) != HashCombine(b, a)
+inline std::uint64_t HashCombine(std::uint64_t hash, std::uint64_t value)
+{
+	return HashMix(hash ^ HashPrimes[2], value ^ HashPrimes[3]);
+}
+
+inline std::uint64_t HashBytes(const void* data, std::size_t size)
+{
+	const unsigned char* current = static_cast<const unsigned char*>(data);
+	std::uint64_t hash = HashInt(size);
+
+	// four lanes accumulate 32 bytes at a time, like xxh3
+	// each lane adds its neighbour's input and the product of its own halves
+	// so the SSE2 path and the portable path produce the same result
+	if (size >= 32)
+	{
+		alignas(16) std::uint64_t lanes[4] = {
+			HashPrimes[0], HashPrimes[1], HashPrimes[2], HashPrimes[3]
+		};
+		const unsigned char* stripesEnd = current + (size & ~std::size_t(31));
+#if defined(__SSE2__)
+		const __m128i secret01 = _mm_set_epi64x(HashPrimes[1], HashPrimes[0]);
+		const __m128i secret23 = _mm_set_epi64x(HashPrimes[3], HashPrimes[2]);
+		__m128i lanes01 = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes));
+		__m128i lanes23 = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes + 2));
+		for (; current < stripesEnd; current += 32)
+		{
+			__m128i data01 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+			__m128i data23 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + 16));
+			__m128i keyed01 = _mm_xor_si128(data01, secret01);
+			__m128i keyed23 = _mm_xor_si128(data23, secret23);
+			lanes01 = _mm_add_epi64(lanes01, _mm_mul_epu32(keyed01, _mm_srli_epi64(keyed01, 32)));
+			lanes23 = _mm_add_epi64(lanes23, _mm_mul_epu32(keyed23, _mm_srli_epi64(keyed23, 32)));
+			lanes01 = _mm_add_epi64(lanes01, _mm_shuffle_epi32(data01, _MM_SHUFFLE(1, 0, 3, 2)));
+			lanes23 = _mm_add_epi64(lanes23, _mm_shuffle_epi32(data23, _MM_SHUFFLE(1, 0, 3, 2)));
+		}
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), lanes01);
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes + 2), lanes23);
+#else
+		for (; current < stripesEnd; current += 32)
+		{
+			for (int lane = 0; lane < 4; ++lane)
+			{
+				std::uint64_t value;
+				std::memcpy(&value, current + lane * 8, 8);
+				std::uint64_t keyed = value ^ HashPrimes[lane];
+				lanes[lane] += (keyed & 0xFFFFFFFFull) * (keyed >> 32);
+				lanes[lane ^ 1] += value;
+			}
+		}
+#endif
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			hash = HashCombine(hash, lanes[lane]);
+		}
+		size &= 31;
+	}
+
+	for (; size >= 8; size -= 8, current += 8)
+	{
+		std::uint64_t value;
+		std::memcpy(&value, current, 8);
+		hash = HashCombine(hash, value);
+	}
+	if (size > 0)
+	{
+		std::uint64_t value = 0;
+		std::memcpy(&value, current, size);
+		hash = HashCombine(hash, value);
+	}
+	return hash;
+}
+
+} // namespace Farb
+
+#endif // FARB_HASH_EXTENSIONS_HPP
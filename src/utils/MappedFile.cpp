@@ -0,0 +1,146 @@
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FARB_HAS_MMAP 1
+#endif
+
+#include "../core/Error.hpp"
+#include "MappedFile.h"
+
+namespace Farb
+{
+
+// an empty file has no pages to map, but is still open
+static const char EmptyFile[1] = { '\0' };
+
+MappedFile::MappedFile()
+	: data(nullptr)
+	, size(0)
+	, fallback()
+	, mapped(false)
+{ }
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other)
+	: MappedFile()
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other)
+{
+	if (this == &other) return *this;
+	Close();
+	fallback = std::move(other.fallback);
+	mapped = other.mapped;
+	size = other.size;
+	// the fallback buffer moved, so the data pointer has to follow it
+	data = mapped || other.data == EmptyFile ? other.data : fallback.data();
+	other.data = nullptr;
+	other.size = 0;
+	other.mapped = false;
+	return *this;
+}
+
+bool MappedFile::Open(const std::string& filePath)
+{
+	Close();
+#ifdef FARB_HAS_MMAP
+	int fd = ::open(filePath.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		Error("Couldn't open filePath: " + filePath).Log();
+		return false;
+	}
+	struct stat status;
+	if (::fstat(fd, &status) != 0)
+	{
+		::close(fd);
+		Error("Couldn't read the size of filePath: " + filePath).Log();
+		return false;
+	}
+	// pipes and devices report no size and can't be mapped, so they are read until they end
+	if (S_ISREG(status.st_mode))
+	{
+		size = static_cast<std::size_t>(status.st_size);
+		if (size == 0)
+		{
+			::close(fd);
+			data = EmptyFile;
+			return true;
+		}
+		void* pages = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+		if (pages != MAP_FAILED)
+		{
+			// the mapping keeps its own reference to the file
+			::close(fd);
+			data = static_cast<const char*>(pages);
+			mapped = true;
+			return true;
+		}
+		size = 0;
+		fallback.reserve(static_cast<std::size_t>(status.st_size));
+	}
+	bool success = true;
+	char chunk[64 * 1024];
+	while (true)
+	{
+		ssize_t count = ::read(fd, chunk, sizeof(chunk));
+		if (count == 0) break;
+		if (count < 0)
+		{
+			if (errno == EINTR) continue;
+			success = false;
+			break;
+		}
+		fallback.append(chunk, static_cast<std::size_t>(count));
+	}
+	::close(fd);
+#else
+	std::ifstream inputFile(filePath, std::ios::binary);
+	if (inputFile.fail())
+	{
+		Error("Couldn't open filePath: " + filePath).Log();
+		return false;
+	}
+	fallback.assign(std::istreambuf_iterator<char>(inputFile), std::istreambuf_iterator<char>());
+	bool success = !inputFile.bad();
+#endif
+	if (!success)
+	{
+		fallback.clear();
+		Error("Couldn't read filePath: " + filePath).Log();
+		return false;
+	}
+	size = fallback.size();
+	data = size == 0 ? EmptyFile : fallback.data();
+	return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef FARB_HAS_MMAP
+	if (mapped)
+	{
+		::munmap(const_cast<char*>(data), size);
+	}
+#endif
+	data = nullptr;
+	size = 0;
+	mapped = false;
+	fallback.clear();
+	fallback.shrink_to_fit();
+}
+
+} // namespace Farb
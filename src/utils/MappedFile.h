@@ -0,0 +1,49 @@
+#ifndef FARB_MAPPED_FILE_H
+#define FARB_MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+
+namespace Farb
+{
+
+// a read only view of a whole file
+// the pages are mapped rather than read, so they are loaded on first use
+// and shared between every process that maps the same file
+// where mapping isn't available, or the file isn't a regular file like a pipe,
+// it is read into an owned buffer instead
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(const MappedFile& other) = delete;
+	MappedFile& operator=(const MappedFile& other) = delete;
+
+	MappedFile(MappedFile&& other);
+	MappedFile& operator=(MappedFile&& other);
+
+	// logs and returns false if the file couldn't be opened
+	// any previously opened file is closed first
+	bool Open(const std::string& filePath);
+	void Close();
+
+	bool IsOpen() const { return data != nullptr; }
+
+	// the start is page aligned when mapped
+	const char* Data() const { return data; }
+	std::size_t Size() const { return size; }
+	std::string_view View() const { return std::string_view(data, size); }
+
+private:
+	const char* data;
+	std::size_t size;
+	// only used when the file couldn't be mapped
+	std::string fallback;
+	bool mapped;
+};
+
+} // namespace Farb
+
+#endif // FARB_MAPPED_FILE_H
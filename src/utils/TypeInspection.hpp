@@ -170,7 +170,7 @@ T ValueOrDefault(ErrorOr<T> result, T default_value)
 	{
 		return default_value;
 	}
-	return result.GetValue();
+	return std::move(result).GetValue();
 }
 
 template<int N, typename... Ts> using NthTypeOf =
@@ -5,10 +5,25 @@
 #include "./reflection/TestReflectStruct.hpp"
 #include "./reflection/TestReflectContainers.hpp"
 #include "./reflection/TestReflectWrappers.hpp"
+#include "./reflection/TestReflectStatic.hpp"
+#include "./reflection/TestReflectDiff.hpp"
+#include "./reflection/TestReflectHash.hpp"
+#include "./reflection/TestReflectPath.hpp"
 #include "./serialization/TestDeserialize.hpp"
+#include "./serialization/TestSerialize.hpp"
+#include "./serialization/TestBinary.hpp"
+#include "./serialization/TestFrozenImage.hpp"
+#include "./serialization/TestConcurrentDeserialize.hpp"
+#include "./serialization/TestLoadBatch.hpp"
+#include "./serialization/TestDeserializationSession.hpp"
+#include "./serialization/TestDataFormats.hpp"
+#include "./serialization/TestDeserializationPlan.hpp"
+#include "./serialization/TestDeserializeAllocations.hpp"
 #include "./interface/TestUITree.hpp"
 //#include "./utils/TestMapReduce.hpp"
+#include "./core/TestError.hpp"
 #include "./core/TestErrorOr.hpp"
+#include "./core/TestHString.hpp"
 /*
 g++ -std=c++17 -Wfatal-errors RunTests.cpp -g && ./a.out;
 */
@@ -24,10 +39,25 @@ int main(void)
 		TestReflectStruct,
 		TestReflectContainers,
 		TestReflectWrappers,
+		TestReflectStatic,
+		TestReflectDiff,
+		TestReflectHash,
+		TestReflectPath,
 		TestDeserialize,
+		TestSerialize,
+		TestBinary,
+		TestFrozenImage,
+		TestConcurrentDeserialize,
+		TestLoadBatch,
+		TestDeserializationSession,
+		TestDataFormats,
+		TestDeserializationPlan,
+		TestDeserializeAllocations,
 		TestUITree,
 		//TestMapReduce,
-		TestErrorOr>();
+		TestError,
+		TestErrorOr,
+		TestHString>();
 	
 	std::cout << "All Tests Passed" << std::endl;
 	if (success) return 0;
@@ -0,0 +1,91 @@
+#ifndef FARB_TEST_ERROR_HPP
+#define FARB_TEST_ERROR_HPP
+
+#include <assert.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Error.hpp"
+#include "../RegisterTest.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionContainers.hpp"
+#include "../../src/utils/CountAllocations.hpp"
+#include "../reflection/TestReflectDefinitions.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Tests
+{
+
+class TestError : public ITest
+{
+public:
+	virtual bool RunTests() const override
+	{
+		std::cout << "Error" << std::endl;
+
+		std::vector<int> ints{1, 2, 3};
+		ExampleBaseStruct base;
+		// warms up the type infos and member tables
+		bool success = Reflect(base).GetAtKey(HString("i2")).GetValue().location != nullptr;
+		std::size_t allocations = CountAllocations([&]()
+		{
+			for (int i = 0; i < 100; ++i)
+			{
+				success &= Reflect(ints).GetAtIndex(3 + i).IsError();
+				success &= Reflect(base).GetAtKey(HString("missing")).IsError();
+				success &= !Reflect(base).InsertKey(HString("missing"));
+			}
+		});
+		success = success && allocations == 0;
+		farb_print(success, "probing for missing members and indexes allocates "
+			+ std::to_string(allocations) + " times");
+		assert(success);
+
+		Error outOfBounds = Reflect(ints).GetAtIndex(7).GetError();
+		Error missing = Reflect(base).GetAtKey(HString("missing")).GetError();
+		success = outOfBounds.Code() == ErrorCode::IndexOutOfBounds
+			&& outOfBounds.Message() == "std::vector<int> array GetAtIndex 7 is out of bounds, 3."
+			&& missing.Code() == ErrorCode::NoMember
+			&& missing.Message() == "ExampleBaseStruct struct GetAtKey missing failed. No member exists with that name."
+			&& Error("built by the caller").Message() == "built by the caller"
+			&& Error(ErrorCode::NotImplemented, HString("Type"), "Serialize").Message() == "Type Serialize not implemented.";
+		farb_print(success, "error messages are formatted when read");
+		assert(success);
+
+		Error cause = Error(ErrorCode::NoEntry, HString("table"), HString("key"));
+		Error wrapped = Error("couldn't load").SetParent(cause);
+		Error copied = wrapped;
+		// other errors chaining causes, here or on other threads, don't touch this chain
+		std::thread other([&]()
+		{
+			for (int i = 0; i < 1000; ++i)
+			{
+				Error(ErrorCode::NoPendingElement, HString("set"), i).SetParent(cause);
+			}
+		});
+		for (int i = 0; i < 1000; ++i)
+		{
+			Error(ErrorCode::NoPendingElement, HString("set"), i).SetParent(wrapped);
+		}
+		other.join();
+		success = copied.Parent() != nullptr
+			&& copied.Parent()->Message() == cause.Message()
+			&& wrapped.Parent() != nullptr
+			&& wrapped.Parent()->Code() == ErrorCode::NoEntry
+			&& cause.Parent() == nullptr;
+		farb_print(success, "chained causes are owned by the errors that chain them");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // FARB_TEST_ERROR_HPP
@@ -1,7 +1,12 @@
 #ifndef FARB_TEST_ERROR_OR_HPP
 #define FARB_TEST_ERROR_OR_HPP
 
+#include <assert.h>
+#include <memory>
+#include <vector>
+
 #include "ErrorOr.hpp"
+#include "../RegisterTest.hpp"
 
 namespace Farb
 {
@@ -19,6 +24,72 @@ ErrorOr<Obj> TryGet()
 	return b.GetError();
 }
 
+// counts how it was constructed, to check ErrorOr never copies what it's given to move
+struct CopyCounted
+{
+	static inline int copies = 0;
+	static inline int moves = 0;
+
+	std::vector<int> payload;
+
+	CopyCounted()
+		: payload(1000, 1)
+	{ }
+
+	CopyCounted(const CopyCounted& other)
+		: payload(other.payload)
+	{
+		++copies;
+	}
+
+	CopyCounted(CopyCounted&& other)
+		: payload(std::move(other.payload))
+	{
+		++moves;
+	}
+
+	CopyCounted& operator=(const CopyCounted& other)
+	{
+		payload = other.payload;
+		++copies;
+		return *this;
+	}
+
+	CopyCounted& operator=(CopyCounted&& other)
+	{
+		payload = std::move(other.payload);
+		++moves;
+		return *this;
+	}
+};
+
+inline ErrorOr<CopyCounted> MakeCounted(bool fail)
+{
+	if (fail) return Error("make failed");
+	CopyCounted counted;
+	return counted;
+}
+
+inline ErrorOr<CopyCounted> PassCounted(int depth, bool fail)
+{
+	if (depth == 0) return MakeCounted(fail);
+	CopyCounted counted = CHECK_RETURN(PassCounted(depth - 1, fail));
+	return counted;
+}
+
+inline ErrorOr<std::unique_ptr<int> > MakeUnique(int value)
+{
+	if (value < 0) return Error("negative");
+	return std::make_unique<int>(value);
+}
+
+inline ErrorOr<std::unique_ptr<int> > PassUnique(int value)
+{
+	std::unique_ptr<int> result = CHECK_RETURN(MakeUnique(value));
+	*result += 1;
+	return result;
+}
+
 namespace Tests
 {
 
@@ -38,8 +109,41 @@ public:
 
 		b.Log();
 		b2.GetError().Log();
-		
 
+		CopyCounted::copies = 0;
+		CopyCounted::moves = 0;
+		auto passed = PassCounted(5, false);
+		CopyCounted taken = std::move(passed).GetValue();
+		bool success = !passed.IsError()
+			&& taken.payload.size() == 1000
+			&& CopyCounted::copies == 0
+			&& CopyCounted::moves > 0;
+		success = success && PassCounted(5, true).IsError() && CopyCounted::copies == 0;
+		farb_print(success, "CHECK_RETURN moves values through 5 levels without copying");
+		assert(success);
+
+		auto unique = PassUnique(41);
+		success = !unique.IsError() && *unique.GetValue() == 42
+			&& PassUnique(-1).IsError()
+			&& PassUnique(-1).GetError().Message() == "negative";
+		ErrorOr<std::unique_ptr<int> > reassigned = Error("not yet");
+		reassigned = std::move(unique);
+		success = success && !reassigned.IsError() && *reassigned.GetValue() == 42;
+		farb_print(success, "move only values");
+		assert(success);
+
+		auto shared = std::make_shared<int>(1);
+		ErrorOr<Obj> holder = Obj{shared};
+		success = shared.use_count() == 2;
+		holder = Error("replaced");
+		success = success && shared.use_count() == 1 && holder.IsError();
+		holder = Obj{shared};
+		success = success && shared.use_count() == 2 && !holder.IsError();
+		ErrorOr<Obj> moved = std::move(holder);
+		holder = std::move(moved);
+		success = success && shared.use_count() == 2 && holder.GetValue().a == shared;
+		farb_print(success, "assignment between errors and values destroys the old one");
+		assert(success);
 
 		return true;
 	}
@@ -0,0 +1,90 @@
+#ifndef FARB_TEST_HSTRING_HPP
+#define FARB_TEST_HSTRING_HPP
+
+#include <assert.h>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "../RegisterTest.hpp"
+#include "../../src/core/HString.h"
+
+namespace Farb
+{
+
+namespace Tests
+{
+
+class TestHString : public ITest
+{
+public:
+	virtual bool RunTests() const override
+	{
+		std::cout << "HString" << std::endl;
+
+		constexpr HString literal = "HStringLiteral";
+		static_assert(literal.Size() == 14, "HString literal length is computed at compile time");
+		static_assert(!std::is_convertible<const char*, HString>::value,
+			"only literals become HStrings without being interned");
+		farb_print(!literal.IsInterned(), "hstring literal is not interned");
+		assert(!literal.IsInterned());
+
+		HString fromRuntime = HString(std::string("HString") + "Literal");
+		bool success = fromRuntime.IsInterned()
+			&& fromRuntime == literal
+			&& fromRuntime.GetHash() == literal.GetHash();
+		farb_print(success, "hstring runtime string equals literal with the same contents");
+		assert(success);
+
+		HString interned = literal.Interned();
+		success = interned.Data() == fromRuntime.Data();
+		farb_print(success, "hstring interning the same contents returns the same handle");
+		assert(success);
+
+		success = HString(std::string("Other")) != interned && HString("Other") != literal;
+		farb_print(success, "hstring different contents are not equal");
+		assert(success);
+
+		success = HString::Find("HStringNeverInterned").Empty()
+			&& HString::Find("HStringLiteral") == literal;
+		farb_print(success, "hstring find does not insert into the pool");
+		assert(success && HString::Find("HStringNeverInterned").Empty());
+
+		std::string concatenated = "<" + literal + ">";
+		farb_print(concatenated == "<HStringLiteral>", "hstring concatenation " + concatenated);
+		assert(concatenated == "<HStringLiteral>");
+
+		std::vector<std::thread> threads;
+		std::vector<const char*> handles(8, nullptr);
+		for (int i = 0; i < 8; ++i)
+		{
+			threads.emplace_back([i, &handles]()
+			{
+				for (int j = 0; j < 1000; ++j)
+				{
+					HString(std::to_string(j) + "_concurrent");
+				}
+				handles[i] = HString(std::string("shared_concurrent")).Data();
+			});
+		}
+		for (auto & thread : threads)
+		{
+			thread.join();
+		}
+		success = true;
+		for (auto handle : handles)
+		{
+			success = success && handle == handles[0];
+		}
+		farb_print(success, "hstring concurrent interning returns a single handle");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // FARB_TEST_HSTRING_HPP
@@ -5,6 +5,7 @@
 
 #include "../RegisterTest.hpp"
 #include "../../src/reflection/ReflectionDefine.hpp"
+#include "../../src/serialization/Deserialization.h"
 #include "TestReflectDefinitions.hpp"
 
 
@@ -80,6 +81,45 @@ public:
 		farb_print(success && mapTest["One"] == 1, "reflect std::unordered_map<std::string, int> assign to value int");
 		assert(success && mapTest["One"] == 1);
 
+		int fixedTest[3] = {0, 0, 0};
+		DeserializationContext context;
+		ReflectionObject fixedReflect = Reflect(fixedTest, context);
+		PrintTestName(fixedReflect);
+
+		nameMatches = fixedReflect.typeInfo->GetName() == "int[3]";
+		farb_print(nameMatches, "int[3] name is " + fixedReflect.typeInfo->GetName());
+		assert(nameMatches);
+
+		success = fixedReflect.PushBackDefault();
+		iReflect = FARB_CHECK(
+			fixedReflect.GetAtIndex(0),
+			"reflect int[3] GetAtIndex");
+		success = success && iReflect.location == reinterpret_cast<byte*>(&fixedTest[0])
+			&& iReflect.AssignInt(4) && fixedTest[0] == 4;
+		farb_print(success, "reflect int[3] assigns in place");
+		assert(success);
+		FARB_ASSERT_ERROR(
+			fixedReflect.GetAtIndex(3),
+			"reflect int[3] GetAtIndex past the end");
+		FARB_ASSERT_ERROR(
+			fixedReflect.GetAtIndex(-1),
+			"reflect int[3] GetAtIndex negative");
+
+		success = !fixedReflect.ArrayEnd() && context.PendingCount() == 0;
+		farb_print(success, "reflect int[3] rejects too few elements");
+		assert(success);
+
+		success = DeserializeString("[1, 2, 3]", Reflect(fixedTest))
+			&& fixedTest[0] == 1 && fixedTest[1] == 2 && fixedTest[2] == 3
+			&& ToString(fixedTest) == ToString(std::vector<int>{1, 2, 3});
+		farb_print(success, "int[3] round trip");
+		assert(success);
+
+		success = !DeserializeString("[1, 2, 3, 4]", Reflect(fixedTest))
+			&& !DeserializeString("[1, 2]", Reflect(fixedTest));
+		farb_print(success, "int[3] rejects the wrong number of elements");
+		assert(success);
+
 		return true;
 	}
 };
@@ -5,6 +5,7 @@
 #include "../../src/reflection/ReflectionDefine.hpp"
 #include "../../src/reflection/ReflectionBasics.h"
 #include "../../src/reflection/ReflectionContainers.hpp"
+#include "../../src/reflection/ReflectionStatic.hpp"
 #include "../../src/core/NamedType.hpp"
 #include "../../src/core/ValueCheckedType.hpp"
 
@@ -55,7 +56,7 @@ TypeInfo* Reflection::GetTypeInfo<ExampleEnum>()
 {
 	static TypeInfoEnum<ExampleEnum> exampleEnumTypeInfo {
 		"ExampleEnum",
-		std::vector<std::pair <std::string, int> >{
+		std::vector<std::pair <HString, int> >{
 			{"NegativeTwo", -2},
 			{"Zero", 0},
 			{"One", 1},
@@ -134,8 +135,223 @@ struct ExampleDerivedStruct : public ExampleBaseStruct
 	virtual TypeInfo* GetInstanceTypeInfo() const override { return GetStaticTypeInfo(); }
 };
 
+struct ExampleStaticStruct
+{
+	ExampleEnum e1;
+	int i2;
+	std::string s3;
+	std::vector<int> v4;
+	std::vector<ExampleBaseStruct> v5;
+
+	ExampleStaticStruct()
+		: e1(ExampleEnum::Zero)
+		, i2(0)
+		, s3()
+		, v4()
+		, v5()
+	{ }
+
+	bool operator ==(const ExampleStaticStruct& other) const
+	{
+		if (v5.size() != other.v5.size()) return false;
+		for (int i = 0; i < v5.size(); ++i)
+		{
+			if (v5[i].e1 != other.v5[i].e1 || v5[i].i2 != other.v5[i].i2) return false;
+		}
+		return e1 == other.e1 && i2 == other.i2 && s3 == other.s3 && v4 == other.v4;
+	}
+
+	static constexpr auto GetStaticMembers()
+	{
+		return std::make_tuple(
+			MakeStaticMember("e1", &ExampleStaticStruct::e1),
+			MakeStaticMember("i2", &ExampleStaticStruct::i2),
+			MakeStaticMember("s3", &ExampleStaticStruct::s3),
+			MakeStaticMember("v4", &ExampleStaticStruct::v4),
+			MakeStaticMember("v5", &ExampleStaticStruct::v5));
+	}
+
+	static TypeInfo* GetStaticTypeInfo()
+	{
+		static auto typeInfo = MakeStaticTypeInfoStruct<ExampleStaticStruct>("ExampleStaticStruct");
+		return &typeInfo;
+	}
+
+	static bool PostLoad(ExampleStaticStruct& object)
+	{
+		return object.i2 >= 0;
+	}
+};
+
+// deserialized from [begin, end] through TypeInfoAs
+struct ExampleRange
+{
+	int begin = 0;
+	int end = 0;
+
+	bool operator ==(const ExampleRange& other) const
+	{
+		return begin == other.begin && end == other.end;
+	}
+
+	struct Converter : public Functor<ErrorOr<ExampleRange>, const std::vector<int> & >
+	{
+		virtual ErrorOr<ExampleRange> operator()(const std::vector<int> & in) override
+		{
+			if (in.size() != 2 || in[0] > in[1])
+			{
+				return Error("ExampleRange expects [begin, end]");
+			}
+			ExampleRange range;
+			range.begin = in[0];
+			range.end = in[1];
+			return range;
+		}
+
+		virtual Converter * clone() const override
+		{
+			return new Converter(*this);
+		}
+
+		static ErrorOr<std::vector<int> > ConvertBack(const ExampleRange& in)
+		{
+			return std::vector<int>{in.begin, in.end};
+		}
+	};
+
+	static TypeInfo* GetStaticTypeInfo()
+	{
+		static Converter converter;
+		static TypeInfoAs<ExampleRange, std::vector<int> > typeInfo(
+			"ExampleRange",
+			converter,
+			Converter::ConvertBack);
+		return &typeInfo;
+	}
+};
+
+inline bool SkipIfNegative(const int& value)
+{
+	return value < 0;
+}
+
+// hidden isn't serialized while it's negative
+struct ExampleSkippingBase
+{
+	int hidden;
+	int shown;
+
+	ExampleSkippingBase()
+		: hidden(-1)
+		, shown(0)
+	{ }
+
+	static constexpr auto GetStaticMembers()
+	{
+		return std::make_tuple(
+			MakeStaticMember("hidden", &ExampleSkippingBase::hidden, &SkipIfNegative),
+			MakeStaticMember("shown", &ExampleSkippingBase::shown));
+	}
+
+	static TypeInfo* GetStaticTypeInfo()
+	{
+		static auto typeInfo = MakeStaticTypeInfoStruct<ExampleSkippingBase>("ExampleSkippingBase");
+		return &typeInfo;
+	}
+};
+
+struct ExampleSkippingDerived : public ExampleSkippingBase
+{
+	int own;
+
+	ExampleSkippingDerived()
+		: ExampleSkippingBase()
+		, own(0)
+	{ }
+
+	static constexpr auto GetStaticMembers()
+	{
+		return std::make_tuple(
+			MakeStaticMember("own", &ExampleSkippingDerived::own));
+	}
+
+	static TypeInfo* GetStaticTypeInfo()
+	{
+		static auto typeInfo = MakeStaticTypeInfoStruct<ExampleSkippingDerived>(
+			"ExampleSkippingDerived",
+			Reflection::GetTypeInfo<ExampleSkippingBase>());
+		return &typeInfo;
+	}
+};
+
+// every member is deserialized through a value pending in the DeserializationContext
+struct ExamplePendingStruct
+{
+	ExampleRange range;
+	std::unordered_set<int> ids;
+	std::vector<std::unordered_set<std::string> > tags;
+	std::vector<ExampleRange> ranges;
+
+	bool operator ==(const ExamplePendingStruct& other) const
+	{
+		return range == other.range
+			&& ids == other.ids
+			&& tags == other.tags
+			&& ranges == other.ranges;
+	}
+
+	static constexpr auto GetStaticMembers()
+	{
+		return std::make_tuple(
+			MakeStaticMember("range", &ExamplePendingStruct::range),
+			MakeStaticMember("ids", &ExamplePendingStruct::ids),
+			MakeStaticMember("tags", &ExamplePendingStruct::tags),
+			MakeStaticMember("ranges", &ExamplePendingStruct::ranges));
+	}
+
+	static TypeInfo* GetStaticTypeInfo()
+	{
+		static auto typeInfo = MakeStaticTypeInfoStruct<ExamplePendingStruct>("ExamplePendingStruct");
+		return &typeInfo;
+	}
+};
+
+// sets compare these by id, but reflection compares every member
+struct ExampleKeyedById
+{
+	int id;
+	int payload;
+
+	bool operator ==(const ExampleKeyedById& other) const
+	{
+		return id == other.id;
+	}
+
+	static constexpr auto GetStaticMembers()
+	{
+		return std::make_tuple(
+			MakeStaticMember("id", &ExampleKeyedById::id),
+			MakeStaticMember("payload", &ExampleKeyedById::payload));
+	}
+
+	static TypeInfo* GetStaticTypeInfo()
+	{
+		static auto typeInfo = MakeStaticTypeInfoStruct<ExampleKeyedById>("ExampleKeyedById");
+		return &typeInfo;
+	}
+};
+
 } // namespace Tests
 
 } // namespace Farb
 
+template<>
+struct std::hash<Farb::Tests::ExampleKeyedById>
+{
+	std::size_t operator()(const Farb::Tests::ExampleKeyedById& value) const
+	{
+		return std::hash<int>()(value.id);
+	}
+};
+
 #endif // TEST_REFLECTION_DEFINITIONS_H
\ No newline at end of file
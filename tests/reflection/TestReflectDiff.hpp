@@ -0,0 +1,159 @@
+#ifndef TEST_REFLECT_DIFF_HPP
+#define TEST_REFLECT_DIFF_HPP
+
+#include <assert.h>
+#include <unordered_map>
+
+#include "../RegisterTest.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionContainers.hpp"
+#include "../../src/reflection/ReflectionDiff.h"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/Deserialization.h"
+#include "TestReflectDefinitions.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Tests
+{
+
+class TestReflectDiff : public ITest
+{
+public:
+	virtual bool RunTests() const override
+	{
+		std::cout << "Reflect Diff" << std::endl;
+
+		ExampleStaticStruct before;
+		before.i2 = 1;
+		before.s3 = "before";
+		before.v4 = {1, 2, 3};
+		before.v5 = {ExampleBaseStruct(ExampleEnum::One, 1)};
+		ExampleStaticStruct after;
+		after.i2 = 1;
+		after.s3 = "before";
+		after.v4 = {1, 2, 3};
+		after.v5 = {ExampleBaseStruct(ExampleEnum::One, 1)};
+
+		Patch patch;
+		FARB_CHECK(Diff(before, after, patch), "diff of equal objects");
+		bool success = patch.Empty();
+		farb_print(success, "equal objects have an empty patch");
+		assert(success);
+
+		after.s3 = "after";
+		after.v4[1] = 5;
+		after.v5[0].i2 = 7;
+		FARB_CHECK(Diff(before, after, patch), "diff of changed members");
+		success = patch.changes.size() == 3
+			&& patch.PathString(patch.changes[0]) == "s3"
+			&& patch.PathString(patch.changes[1]) == "v4[1]"
+			&& patch.PathString(patch.changes[2]) == "v5[0].i2";
+		farb_print(success, "patch has a path for each changed member");
+		assert(success);
+
+		ExampleStaticStruct patched = before;
+		FARB_CHECK(Apply(patched, patch), "apply patch");
+		success = patched == after;
+		farb_print(success, "applied patch matches the diffed object");
+		assert(success);
+
+		patch.Clear();
+		after.v4.push_back(4);
+		after.v5.clear();
+		FARB_CHECK(Diff(before, after, patch), "diff of resized arrays");
+		success = patch.changes.size() == 3
+			&& patch.PathString(patch.changes[1]) == "v4"
+			&& patch.PathString(patch.changes[2]) == "v5";
+		farb_print(success, "resized arrays are replaced whole");
+		assert(success);
+		patched = before;
+		FARB_CHECK(Apply(patched, patch), "apply resized arrays");
+		success = patched == after && patched.v4.size() == 4;
+		farb_print(success, "replaced arrays are cleared first");
+		assert(success);
+
+		patch.Clear();
+		ExampleDerivedStruct derivedBefore;
+		derivedBefore.e3 = ExampleEnum::Zero;
+		derivedBefore.i4 = 0;
+		ExampleDerivedStruct derivedAfter;
+		derivedAfter.e3 = ExampleEnum::Zero;
+		derivedAfter.i2 = 9;
+		derivedAfter.i4 = 10;
+		FARB_CHECK(Diff(derivedBefore, derivedAfter, patch), "diff derived struct");
+		ExampleDerivedStruct derivedPatched;
+		derivedPatched.e3 = ExampleEnum::Zero;
+		derivedPatched.i4 = 0;
+		FARB_CHECK(Apply(derivedPatched, patch), "apply derived struct");
+		success = patch.changes.size() == 2 && derivedPatched.i2 == 9 && derivedPatched.i4 == 10;
+		farb_print(success, "derived struct patch includes inherited members");
+		assert(success);
+
+		patch.Clear();
+		ExampleSkippingDerived skippingBefore;
+		ExampleSkippingDerived skippingAfter;
+		skippingAfter.hidden = -2;
+		skippingAfter.shown = 3;
+		FARB_CHECK(Diff(skippingBefore, skippingAfter, patch), "diff struct with skipped inherited member");
+		success = patch.changes.size() == 1 && patch.PathString(patch.changes[0]) == "shown";
+		farb_print(success, "inherited members skipped by serialization aren't diffed");
+		assert(success);
+
+		FARB_ASSERT_ERROR(Apply(before, patch), "patch can't be applied to another type");
+
+		patch.Clear();
+		std::unordered_map<std::string, int> mapBefore{{"One", 1}, {"Two", 2}};
+		std::unordered_map<std::string, int> mapAfter{{"One", 1}, {"Two", 3}};
+		FARB_CHECK(Diff(mapBefore, mapAfter, patch), "diff table");
+		success = patch.changes.size() == 1 && patch.PathString(patch.changes[0]) == "Two";
+		farb_print(success, "table entries are diffed by key");
+		assert(success);
+		std::unordered_map<std::string, int> mapPatched{{"One", 4}};
+		FARB_CHECK(Apply(mapPatched, patch), "apply table patch to a different table");
+		success = mapPatched.size() == 2 && mapPatched["One"] == 4 && mapPatched["Two"] == 3;
+		farb_print(success, "table patch inserts missing keys");
+		assert(success);
+
+		patch.Clear();
+		std::size_t poolSize = HString::PoolSize();
+		std::unordered_map<std::string, int> unpooledBefore{{"a key only a diff has seen", 1}, {"and another", 2}};
+		std::unordered_map<std::string, int> unpooledAfter{{"a key only a diff has seen", 5}, {"and another", 2}};
+		FARB_CHECK(Diff(unpooledBefore, unpooledAfter, patch), "diff table with unpooled keys");
+		std::unordered_map<std::string, int> unpooledPatched;
+		FARB_CHECK(Apply(unpooledPatched, patch), "apply table patch with unpooled keys");
+		success = patch.changes.size() == 1
+			&& patch.PathString(patch.changes[0]) == "a key only a diff has seen"
+			&& unpooledPatched.size() == 1
+			&& unpooledPatched["a key only a diff has seen"] == 5
+			&& HString::PoolSize() == poolSize;
+		farb_print(success, "table keys that aren't HStrings aren't interned by diff or apply");
+		assert(success);
+
+		patch.Clear();
+		UI::Node live;
+		UI::Node edited;
+		success = DeserializeFile("./tests/files/input/TestUITree.json", Reflect(live))
+			&& DeserializeFile("./tests/files/input/TestUITree.json", Reflect(edited));
+		edited.children[0].text.unparsedText = "Edited";
+		edited.left.amount = 30;
+		FARB_CHECK(Diff(live, edited, patch), "diff UI tree");
+		FARB_CHECK(Apply(live, patch), "apply UI tree patch");
+		success = success
+			&& patch.changes.size() == 2
+			&& ToString(live) == ToString(edited)
+			&& live.children[0].text.cachedParsedText == "Edited";
+		farb_print(success, "UI tree patch runs PostLoad on modified objects");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // TEST_REFLECT_DIFF_HPP
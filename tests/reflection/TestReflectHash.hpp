@@ -0,0 +1,137 @@
+#ifndef TEST_REFLECT_HASH_HPP
+#define TEST_REFLECT_HASH_HPP
+
+#include <assert.h>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../RegisterTest.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionContainers.hpp"
+#include "../../src/reflection/ReflectionWrappers.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/Deserialization.h"
+#include "../../src/utils/HashExtensions.hpp"
+#include "TestReflectDefinitions.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Tests
+{
+
+class TestReflectHash : public ITest
+{
+public:
+	template<typename T>
+	static bool SameHashAndEqual(const T& a, const T& b)
+	{
+		return Equal(a, b) && Hash(a) == Hash(b);
+	}
+
+	virtual bool RunTests() const override
+	{
+		std::cout << "Reflect Hash" << std::endl;
+
+		std::vector<int> vectorA{1, 2, 3};
+		std::vector<int> vectorB{1, 2, 3};
+		bool success = SameHashAndEqual(vectorA, vectorB);
+		vectorB[2] = 4;
+		success = success && !Equal(vectorA, vectorB) && Hash(vectorA) != Hash(vectorB);
+		farb_print(success, "int vector hash and equal");
+		assert(success);
+
+		std::string bytes(100, 'a');
+		std::string changedBytes = bytes;
+		changedBytes[40] = 'b';
+		success = HashBytes(bytes.data(), bytes.size()) != HashBytes(changedBytes.data(), changedBytes.size())
+			&& HashBytes(bytes.data(), 99) != HashBytes(bytes.data(), 100);
+		farb_print(success, "hash bytes covers stripes and tail");
+		assert(success);
+
+		std::vector<float> zero{0.0f, 1.5f};
+		std::vector<float> negativeZero{-0.0f, 1.5f};
+		success = SameHashAndEqual(zero, negativeZero);
+		farb_print(success, "0 and -0 are equal with the same hash");
+		assert(success);
+
+		std::unordered_map<std::string, int> mapA;
+		std::unordered_map<std::string, int> mapB;
+		std::unordered_set<int> setA;
+		std::unordered_set<int> setB;
+		for (int i = 0; i < 20; ++i)
+		{
+			mapA[std::to_string(i)] = i;
+			mapB[std::to_string(19 - i)] = 19 - i;
+			setA.insert(i);
+			setB.insert(19 - i);
+		}
+		success = SameHashAndEqual(mapA, mapB) && SameHashAndEqual(setA, setB);
+		mapB["3"] = 4;
+		setB.erase(3);
+		success = success && !Equal(mapA, mapB) && !Equal(setA, setB);
+		farb_print(success, "map and set hash doesn't depend on order");
+		assert(success);
+
+		std::unordered_set<ExampleKeyedById> keyedA{{1, 10}, {2, 20}};
+		std::unordered_set<ExampleKeyedById> keyedB{{2, 20}, {1, 10}};
+		success = SameHashAndEqual(keyedA, keyedB);
+		std::unordered_set<ExampleKeyedById> keyedChanged{{1, 10}, {2, 21}};
+		success = success
+			&& keyedA == keyedChanged
+			&& !Equal(keyedA, keyedChanged)
+			&& Hash(keyedA) != Hash(keyedChanged);
+		farb_print(success, "set equal compares reflected elements, like set hash");
+		assert(success);
+
+		Tree<int> treeA{1, {Tree<int>{2, {}}, Tree<int>{3, {}}}};
+		Tree<int> treeB = treeA;
+		success = SameHashAndEqual(treeA, treeB);
+		treeB.children[1].value = 4;
+		success = success && !Equal(treeA, treeB) && Hash(treeA) != Hash(treeB);
+		farb_print(success, "tree hash and equal");
+		assert(success);
+
+		ExampleNamedTypeInt namedA(3);
+		ExampleNamedTypeInt namedB(3);
+		auto checkedA = ExampleValueCheckedTypeEvenInt::TryCreate(2).GetValue();
+		auto checkedB = ExampleValueCheckedTypeEvenInt::TryCreate(2).GetValue();
+		success = SameHashAndEqual(namedA, namedB)
+			&& SameHashAndEqual(checkedA, checkedB)
+			&& Hash(namedA) == Hash(3);
+		namedB.value = 5;
+		checkedB = ExampleValueCheckedTypeEvenInt::TryCreate(4).GetValue();
+		success = success && !Equal(namedA, namedB) && !Equal(checkedA, checkedB);
+		farb_print(success, "named and value checked types hash their value");
+		assert(success);
+
+		ExampleDerivedStruct derivedA;
+		derivedA.e3 = ExampleEnum::One;
+		derivedA.i4 = 4;
+		ExampleDerivedStruct derivedB = derivedA;
+		success = SameHashAndEqual(derivedA, derivedB);
+		derivedB.i2 = derivedA.i2 + 1;
+		success = success && !Equal(derivedA, derivedB) && Hash(derivedA) != Hash(derivedB);
+		farb_print(success, "derived struct hash includes inherited members");
+		assert(success);
+
+		UI::Node loadedA;
+		UI::Node loadedB;
+		success = DeserializeFile("./tests/files/input/TestUITree.json", Reflect(loadedA))
+			&& DeserializeFile("./tests/files/input/TestUITree.json", Reflect(loadedB))
+			&& SameHashAndEqual(loadedA, loadedB);
+		loadedB.children[0].text.unparsedText = "Edited";
+		success = success && !Equal(loadedA, loadedB) && Hash(loadedA) != Hash(loadedB);
+		farb_print(success, "UI tree loaded twice is equal until edited");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // TEST_REFLECT_HASH_HPP
@@ -0,0 +1,93 @@
+#ifndef TEST_REFLECT_PATH_HPP
+#define TEST_REFLECT_PATH_HPP
+
+#include <assert.h>
+#include <unordered_map>
+
+#include "../RegisterTest.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionContainers.hpp"
+#include "../../src/reflection/ReflectionPath.h"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/Deserialization.h"
+#include "TestReflectDefinitions.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Tests
+{
+
+class TestReflectPath : public ITest
+{
+public:
+	virtual bool RunTests() const override
+	{
+		std::cout << "Reflect Path" << std::endl;
+
+		UI::Node root;
+		bool success = DeserializeFile("./tests/files/input/TestUITree.json", Reflect(root));
+		Path path;
+		FARB_CHECK(Path::Compile<UI::Node>("children[0].text.contents", path), "compile UI tree path");
+		std::string* contents = path.Get<std::string>(root);
+		success = success
+			&& contents == &root.children[0].text.unparsedText
+			&& path.GetLeafTypeInfo() == GetTypeInfo<std::string>();
+		farb_print(success, "path resolves members and indexes to an address");
+		assert(success);
+
+		*contents = "Edited";
+		ReflectionObject resolved = FARB_CHECK(path.Resolve(Reflect(root)), "resolve UI tree path");
+		success = resolved.AssignString("Resolved")
+			&& root.children[0].text.unparsedText == "Resolved";
+		farb_print(success, "resolved path can be assigned through reflection");
+		assert(success);
+
+		Path outOfRange;
+		std::string text = "children[" + std::to_string(root.children.size()) + "].text.contents";
+		FARB_CHECK(Path::Compile<UI::Node>(text, outOfRange), "compile out of range path");
+		success = outOfRange.Get<std::string>(root) == nullptr
+			&& path.Get<int>(root) == nullptr;
+		farb_print(success, "missing indexes and mismatched types find nothing");
+		assert(success);
+		FARB_ASSERT_ERROR(outOfRange.Resolve(Reflect(root)), "resolve out of range path");
+		ExampleBaseStruct other;
+		FARB_ASSERT_ERROR(path.Resolve(Reflect(other)), "resolve path from another type");
+
+		FARB_ASSERT_ERROR(Path::Compile<UI::Node>("children[0].missing", path), "compile missing member");
+		FARB_ASSERT_ERROR(Path::Compile<UI::Node>("text[0]", path), "compile index of a struct");
+		FARB_ASSERT_ERROR(Path::Compile<UI::Node>("children[x]", path), "compile non numeric index");
+		FARB_ASSERT_ERROR(Path::Compile<UI::Node>("children[0", path), "compile unterminated index");
+		FARB_ASSERT_ERROR(Path::Compile<UI::Node>("children[2147483648]", path), "compile index above INT_MAX");
+		FARB_ASSERT_ERROR(Path::Compile<UI::Node>("children[0]text", path), "compile name directly after an index");
+		success = !path.IsValid();
+		farb_print(success, "failed compile leaves an invalid path");
+		assert(success);
+		FARB_CHECK(Path::Compile<UI::Node>("children[2147483647].text", path), "compile index of INT_MAX");
+
+		ExampleDerivedStruct derived;
+		derived.i2 = 3;
+		FARB_CHECK(Path::Compile<ExampleDerivedStruct>("i2", path), "compile inherited member");
+		success = path.Get<int>(derived) == &derived.i2;
+		farb_print(success, "path resolves inherited members");
+		assert(success);
+
+		std::unordered_map<std::string, std::vector<int> > table{{"One", {1}}, {"Two", {2, 3}}};
+		FARB_CHECK((Path::Compile<std::unordered_map<std::string, std::vector<int> > >("Two[1]", path)),
+			"compile table path");
+		success = path.Get<int>(table) == &table["Two"][1];
+		table.erase("Two");
+		success = success && path.Get<int>(table) == nullptr;
+		farb_print(success, "path looks up table keys when followed");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // TEST_REFLECT_PATH_HPP
@@ -0,0 +1,115 @@
+#ifndef TEST_REFLECT_STATIC_HPP
+#define TEST_REFLECT_STATIC_HPP
+
+#include <assert.h> 
+
+#include "../RegisterTest.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionStatic.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/Deserialization.h"
+#include "../../src/serialization/StaticDeserialization.h"
+#include "TestReflectDefinitions.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Tests
+{
+
+class TestReflectStatic : public ITest
+{
+public:
+	virtual bool RunTests() const override
+	{
+		std::cout << "Reflect Static" << std::endl;
+
+		bool success = has_GetStaticMembers<ExampleStaticStruct>::value
+			&& !has_GetStaticMembers<ExampleBaseStruct>::value
+			&& StaticMemberCount<ExampleStaticStruct>() == 5;
+		farb_print(success, "static members declared");
+		assert(success);
+
+		ExampleStaticStruct example;
+		auto reflect = Reflect(example);
+		auto i2 = reflect.GetAtKey("i2");
+		success = !i2.IsError()
+			&& i2.GetValue().location == reinterpret_cast<byte*>(&example.i2);
+		farb_print(success, "static struct runtime TypeInfo GetAtKey");
+		assert(success);
+
+		std::string json =
+			"{"
+			"	\"e1\": \"Two\","
+			"	\"i2\": 12,"
+			"	\"s3\": \"static\","
+			"	\"v4\": [1, 2, 3],"
+			"	\"v5\": [{\"e1\": \"One\", \"i2\": 5}, {\"e1\": \"NegativeTwo\", \"i2\": 7}]"
+			"}";
+
+		ExampleStaticStruct dynamicResult;
+		success = DeserializeString(json, Reflect(dynamicResult));
+		ExampleStaticStruct staticResult;
+		success = success && DeserializeStringStatic(json, staticResult);
+		success = success
+			&& staticResult == dynamicResult
+			&& staticResult.e1 == ExampleEnum::Two
+			&& staticResult.v4.size() == 3
+			&& staticResult.v5.size() == 2
+			&& staticResult.v5[1].i2 == 7;
+		farb_print(success, "static deserialization matches dynamic");
+		assert(success);
+
+		success = DeserializeStringStatic("[\"One\", 3, \"array\"]", staticResult)
+			&& staticResult.e1 == ExampleEnum::One
+			&& staticResult.i2 == 3
+			&& staticResult.s3 == "array";
+		farb_print(success, "static deserialization from array");
+		assert(success);
+
+		success = !DeserializeStringStatic("{\"i2\": -1}", staticResult);
+		farb_print(success, "static deserialization runs PostLoad");
+		assert(success);
+
+		success = !DeserializeStringStatic("{\"missing\": 1}", staticResult);
+		farb_print(success, "static deserialization rejects unknown key");
+		assert(success);
+
+		// v5 holds dynamic structs, which the static parser falls back to reflection for
+		std::size_t poolSize = HString::PoolSize();
+		success = !DeserializeStringStatic("{\"v5\": [{\"not a member of anything\": 1}]}", staticResult)
+			&& HString::PoolSize() == poolSize;
+		farb_print(success, "static deserialization rejects unknown dynamic keys without interning them");
+		assert(success);
+
+		int fixed[3] = {0, 0, 0};
+		success = DeserializeStringStatic("[5, 6, 7]", fixed)
+			&& fixed[0] == 5 && fixed[1] == 6 && fixed[2] == 7
+			&& !DeserializeStringStatic("[5, 6]", fixed)
+			&& !DeserializeStringStatic("[5, 6, 7, 8]", fixed);
+		farb_print(success, "static deserialization of a fixed array checks its length");
+		assert(success);
+
+		success = ToStringStatic(dynamicResult) == ToString(dynamicResult);
+		farb_print(success, "static ToString matches dynamic");
+		assert(success);
+
+		UI::Node dynamicRoot;
+		success = DeserializeFile("./tests/files/input/TestUITree.json", Reflect(dynamicRoot));
+		UI::Node staticRoot;
+		success = success
+			&& DeserializeFileStatic("./tests/files/input/TestUITree.json", staticRoot);
+		success = success && ToStringStatic(staticRoot) == ToString(dynamicRoot);
+		farb_print(success, "static deserialization UI Tree matches dynamic");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // TEST_REFLECT_STATIC_HPP
@@ -58,6 +58,28 @@ public:
 		}
 		assert(!result.IsError());
 
+		ExampleDerivedStruct d;
+		ReflectionObject dReflect = Reflect(d);
+		PrintTestName(dReflect);
+
+		member = FARB_CHECK(
+			dReflect.GetAtKey("i4"),
+			"reflect derived struct get own member");
+		success = member.AssignInt(4);
+		farb_print(success && d.i4 == 4, "reflect derived struct assign to own member");
+		assert(success && d.i4 == 4);
+
+		member = FARB_CHECK(
+			dReflect.GetAtKey("i2"),
+			"reflect derived struct get inherited member");
+		success = member.AssignInt(3);
+		farb_print(success && d.i2 == 3, "reflect derived struct assign to inherited member");
+		assert(success && d.i2 == 3);
+
+		FARB_ASSERT_ERROR(
+			dReflect.GetAtKey("nonexistent member"),
+			"reflect derived struct get nonexistent member");
+
 		return true;
 	}
 };
@@ -0,0 +1,161 @@
+#ifndef TEST_BINARY_HPP
+#define TEST_BINARY_HPP
+
+#include <assert.h> 
+#include <cstdio>
+
+#include "../RegisterTest.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionWrappers.hpp"
+#include "../reflection/TestReflectDefinitions.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/Deserialization.h"
+#include "../../src/serialization/Serialization.h"
+#include "../../src/serialization/BinarySerialization.h"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Tests
+{
+
+// round trips through binary and compares the JSON of both values
+template<typename T>
+void TestBinaryRoundTrip(const T& value)
+{
+	T test = value;
+	std::string binary;
+	bool success = SerializeBinary(Reflect(test), binary);
+	T roundTrip{};
+	success = success && DeserializeBinary(binary, Reflect(roundTrip));
+	std::string expected;
+	std::string actual;
+	success = success
+		&& SerializeString(Reflect(test), expected)
+		&& SerializeString(Reflect(roundTrip), actual)
+		&& expected == actual;
+	farb_print(success, "binary round trip " + GetTypeInfo<T>()->GetName() + " " + actual);
+	assert(success);
+}
+
+class TestBinary : public ITest
+{
+public:
+	virtual bool RunTests() const override
+	{
+		std::cout << "Binary" << std::endl;
+
+		TestBinaryRoundTrip<bool>(true);
+		TestBinaryRoundTrip<uint>(300);
+		TestBinaryRoundTrip<int>(-2147483647 - 1);
+		TestBinaryRoundTrip<float>(-10.25);
+		TestBinaryRoundTrip<std::string>("binary \"string\"");
+		TestBinaryRoundTrip<ExampleEnum>(ExampleEnum::NegativeTwo);
+		TestBinaryRoundTrip<ExampleNamedTypeInt>(ExampleNamedTypeInt(7));
+		ExampleDerivedStruct derived;
+		derived.e3 = ExampleEnum::Two;
+		derived.i4 = -4;
+		TestBinaryRoundTrip<ExampleDerivedStruct>(derived);
+		TestBinaryRoundTrip<std::vector<int> >({0, 1, 128, 1 << 20});
+		TestBinaryRoundTrip<std::vector<ExampleBaseStruct> >(
+			{ExampleBaseStruct(ExampleEnum::One, 1), ExampleBaseStruct(ExampleEnum::Two, 2)});
+		TestBinaryRoundTrip<std::unordered_map<std::string, int> >({{"Zero", 0}});
+
+		bool success = GetSchemaHash(GetTypeInfo<ExampleBaseStruct>())
+				== GetSchemaHash(GetTypeInfo<ExampleBaseStruct>())
+			&& GetSchemaHash(GetTypeInfo<ExampleBaseStruct>())
+				!= GetSchemaHash(GetTypeInfo<ExampleDerivedStruct>())
+			&& GetSchemaHash(GetTypeInfo<std::vector<int> >())
+				!= GetSchemaHash(GetTypeInfo<std::vector<uint> >());
+		farb_print(success, "binary schema hash distinguishes types");
+		assert(success);
+
+		ExampleBaseStruct base(ExampleEnum::Zero, 3);
+		std::string binary;
+		success = SerializeBinary(Reflect(base), binary);
+		ExampleDerivedStruct wrongType;
+		wrongType.i4 = 9;
+		success = success
+			&& !DeserializeBinary(binary, Reflect(wrongType))
+			&& wrongType.i4 == 9;
+		farb_print(success, "binary rejects mismatched schema");
+		assert(success);
+
+		ExampleBaseStruct truncated;
+		success = !DeserializeBinary(
+			std::string_view(binary.data(), binary.size() - 1),
+			Reflect(truncated));
+		farb_print(success, "binary rejects truncated input");
+		assert(success);
+
+		// repeated keys are written once
+		std::vector<ExampleBaseStruct> many(16);
+		std::string manyBinary;
+		std::string manyJson;
+		success = SerializeBinary(Reflect(many), manyBinary)
+			&& SerializeString(Reflect(many), manyJson)
+			&& manyBinary.size() * 3 < manyJson.size() * 2;
+		farb_print(success, "binary is compact "
+			+ std::to_string(manyBinary.size()) + " vs json " + std::to_string(manyJson.size()));
+		assert(success);
+
+		std::unordered_map<std::string, int> textKeys{{"a key only the binary test writes", 1}};
+		std::size_t poolSize = HString::PoolSize();
+		std::string textKeysBinary;
+		std::unordered_map<std::string, int> textKeysRead;
+		success = SerializeBinary(Reflect(textKeys), textKeysBinary)
+			&& DeserializeBinary(textKeysBinary, Reflect(textKeysRead))
+			&& textKeysRead == textKeys
+			&& HString::PoolSize() == poolSize;
+		farb_print(success, "binary writes and reads std::string keys without interning them");
+		assert(success);
+
+		// a corrupt member name is rejected without adding it to the pool
+		std::string corrupt = binary;
+		std::size_t keyAt = corrupt.find("i2");
+		success = keyAt != std::string::npos;
+		if (success) corrupt.replace(keyAt, 2, "q7");
+		ExampleBaseStruct corrupted;
+		success = success
+			&& !DeserializeBinary(corrupt, Reflect(corrupted))
+			&& HString::PoolSize() == poolSize;
+		farb_print(success, "binary rejects unknown member names without interning them");
+		assert(success);
+
+		UI::Node root;
+		success = DeserializeFile("./tests/files/input/TestUITree.json", Reflect(root));
+		std::string uiBinary;
+		success = success && SerializeBinary(Reflect(root), uiBinary);
+		UI::Node roundTrip;
+		success = success && DeserializeBinary(uiBinary, Reflect(roundTrip));
+		std::string expected;
+		std::string actual;
+		success = success
+			&& SerializeString(Reflect(root), expected)
+			&& SerializeString(Reflect(roundTrip), actual)
+			&& expected == actual;
+		farb_print(success, "binary round trip UI Tree");
+		assert(success);
+
+		const std::string filePath = "./test_binary_file.bin";
+		UI::Node fromFile;
+		std::string fromFileString;
+		success = SerializeBinaryFile(Reflect(root), filePath)
+			&& DeserializeBinaryFile(filePath, Reflect(fromFile))
+			&& SerializeString(Reflect(fromFile), fromFileString)
+			&& expected == fromFileString;
+		std::remove(filePath.c_str());
+		success = success && !DeserializeBinaryFile(filePath, Reflect(fromFile));
+		farb_print(success, "binary round trip through a mapped file");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // TEST_BINARY_HPP
@@ -0,0 +1,148 @@
+#ifndef TEST_CONCURRENT_DESERIALIZE_HPP
+#define TEST_CONCURRENT_DESERIALIZE_HPP
+
+#include <assert.h> 
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../RegisterTest.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../reflection/TestReflectDefinitions.hpp"
+#include "../../src/serialization/Deserialization.h"
+#include "../../src/serialization/StaticDeserialization.h"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Tests
+{
+
+// distinct values per seed, so a pending value shared between parses
+// shows up as a mismatch rather than only as a crash
+inline ExamplePendingStruct MakePendingExpected(int seed)
+{
+	ExamplePendingStruct expected;
+	expected.range.begin = seed;
+	expected.range.end = seed + 10;
+	for (int i = 0; i < 16; ++i)
+	{
+		expected.ids.insert(seed * 100 + i);
+	}
+	expected.tags.resize(4);
+	expected.ranges.resize(4);
+	for (int i = 0; i < 4; ++i)
+	{
+		expected.tags[i].insert("tag" + std::to_string(seed));
+		expected.tags[i].insert("tag" + std::to_string(seed + i));
+		expected.ranges[i].begin = seed - i;
+		expected.ranges[i].end = seed + i;
+	}
+	return expected;
+}
+
+inline std::string MakePendingJson(const ExamplePendingStruct& value)
+{
+	std::string json = "{\"range\":["
+		+ std::to_string(value.range.begin) + ","
+		+ std::to_string(value.range.end) + "],\"ids\":[";
+	bool first = true;
+	for (int id : value.ids)
+	{
+		if (!first) json += ",";
+		first = false;
+		json += std::to_string(id);
+	}
+	json += "],\"tags\":[";
+	for (std::size_t i = 0; i < value.tags.size(); ++i)
+	{
+		if (i != 0) json += ",";
+		json += "[";
+		first = true;
+		for (const auto & tag : value.tags[i])
+		{
+			if (!first) json += ",";
+			first = false;
+			json += "\"" + tag + "\"";
+		}
+		json += "]";
+	}
+	json += "],\"ranges\":[";
+	for (std::size_t i = 0; i < value.ranges.size(); ++i)
+	{
+		if (i != 0) json += ",";
+		json += "[" + std::to_string(value.ranges[i].begin)
+			+ "," + std::to_string(value.ranges[i].end) + "]";
+	}
+	return json + "]}";
+}
+
+class TestConcurrentDeserialize : public ITest
+{
+public:
+	virtual bool RunTests() const override
+	{
+		std::cout << "Concurrent Deserialize" << std::endl;
+
+		ExamplePendingStruct expected = MakePendingExpected(7);
+		ExamplePendingStruct result;
+		DeserializationContext context;
+		bool success = DeserializeString(MakePendingJson(expected), Reflect(result, context))
+			&& result == expected
+			&& context.PendingCount() == 0;
+		farb_print(success, "pending values are completed and released with their context");
+		assert(success);
+
+		// a failed parse leaves its pending values in its own context, not in the next parse
+		ExamplePendingStruct failed;
+		success = !DeserializeString("{\"ids\":[1,2,\"three\"]}", Reflect(failed));
+		ExamplePendingStruct after;
+		success = success
+			&& DeserializeString(MakePendingJson(expected), Reflect(after))
+			&& after == expected;
+		farb_print(success, "failed parse doesn't leak pending values into the next");
+		assert(success);
+
+		constexpr int threadCount = 8;
+		constexpr int iterations = 200;
+		std::atomic<int> mismatches(0);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < threadCount; ++t)
+		{
+			threads.emplace_back([t, &mismatches]()
+			{
+				for (int i = 0; i < iterations; ++i)
+				{
+					int seed = t * iterations + i;
+					ExamplePendingStruct expected = MakePendingExpected(seed);
+					std::string json = MakePendingJson(expected);
+					ExamplePendingStruct dynamicResult;
+					ExamplePendingStruct staticResult;
+					bool success = DeserializeString(json, Reflect(dynamicResult))
+						&& DeserializeStringStatic(json, staticResult)
+						&& dynamicResult == expected
+						&& staticResult == expected;
+					if (!success) mismatches++;
+				}
+			});
+		}
+		for (auto & thread : threads)
+		{
+			thread.join();
+		}
+		success = mismatches == 0;
+		farb_print(success, "concurrent parses on " + std::to_string(threadCount)
+			+ " threads, " + std::to_string(mismatches) + " mismatches");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // TEST_CONCURRENT_DESERIALIZE_HPP
@@ -0,0 +1,183 @@
+#ifndef TEST_DATA_FORMATS_HPP
+#define TEST_DATA_FORMATS_HPP
+
+#include <assert.h>
+#include <climits>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../RegisterTest.hpp"
+#include "../../lib/json/json.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionContainers.hpp"
+#include "../../src/reflection/ReflectionWrappers.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/DataFormats.h"
+#include "../../src/serialization/Deserialization.h"
+#include "../../src/serialization/Serialization.h"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Tests
+{
+
+// decodes output with nlohmann's own reader for format, so our writers are checked
+// against an independent implementation rather than only against our own parser
+inline nlohmann::json DecodeWithNlohmann(std::string output, DataFormat format)
+{
+	using json = nlohmann::json;
+	switch (format)
+	{
+	case DataFormat::Cbor:
+		return json::from_cbor(output.substr(CborSelfDescribeTag.size()));
+	case DataFormat::MessagePack:
+		return json::from_msgpack(output);
+	case DataFormat::Ubjson:
+		return json::from_ubjson(output);
+	default:
+		return json::parse(output);
+	}
+}
+
+class TestDataFormats : public ITest
+{
+public:
+	virtual bool RunTests() const override
+	{
+		std::cout << "Data Formats" << std::endl;
+
+		const DataFormat formats[] = {
+			DataFormat::Json,
+			DataFormat::Cbor,
+			DataFormat::MessagePack,
+			DataFormat::Ubjson
+		};
+
+		// every integer and length boundary of the three formats
+		std::vector<int> ints{0, 23, 24, 127, 128, 255, 256, 32767, 32768, 65535, 65536,
+			-1, -24, -25, -32, -33, -128, -129, -32768, -32769, INT_MIN, INT_MAX};
+		std::vector<uint> uints{0, 200, 70000, UINT_MAX};
+		std::vector<float> floats{0.5f, -1.25f, 1e30f};
+		std::vector<std::string> strings;
+		for (std::size_t length : {0, 5, 23, 24, 31, 32, 255, 256, 70000})
+		{
+			strings.push_back(std::string(length, 'a' + length % 26));
+		}
+		std::vector<int> manyInts(70000, 3);
+		nlohmann::json expected = {ints, uints, floats, strings};
+
+		bool success = true;
+		for (DataFormat format : formats)
+		{
+			std::string output;
+			std::vector<int> readInts;
+			std::vector<uint> readUInts;
+			std::vector<float> readFloats;
+			std::vector<std::string> readStrings;
+			std::vector<int> readManyInts;
+			bool formatSuccess = SerializeFormat(Reflect(ints), format, output)
+				&& DeserializeFormat(output, Reflect(readInts), format)
+				&& readInts == ints
+				&& DecodeWithNlohmann(output, format) == expected[0];
+			output.clear();
+			formatSuccess = formatSuccess
+				&& SerializeFormat(Reflect(uints), format, output)
+				&& DeserializeFormat(output, Reflect(readUInts), format)
+				&& readUInts == uints
+				&& DecodeWithNlohmann(output, format) == expected[1];
+			output.clear();
+			formatSuccess = formatSuccess
+				&& SerializeFormat(Reflect(floats), format, output)
+				&& DeserializeFormat(output, Reflect(readFloats), format)
+				&& readFloats == floats;
+			output.clear();
+			formatSuccess = formatSuccess
+				&& SerializeFormat(Reflect(strings), format, output)
+				&& DeserializeFormat(output, Reflect(readStrings), format)
+				&& readStrings == strings
+				&& DecodeWithNlohmann(output, format) == expected[3];
+			output.clear();
+			formatSuccess = formatSuccess
+				&& SerializeFormat(Reflect(manyInts), format, output)
+				&& DeserializeFormat(output, Reflect(readManyInts), format)
+				&& readManyInts == manyInts;
+			farb_print(formatSuccess, std::string("round trip boundary values through ") + DataFormatName(format));
+			success = success && formatSuccess;
+		}
+		assert(success);
+
+		std::unordered_map<std::string, int> wideTable;
+		for (int i = 0; i < 70000; ++i)
+		{
+			wideTable["key" + std::to_string(i)] = i;
+		}
+		std::string wideOutput;
+		std::unordered_map<std::string, int> wideRead;
+		success = SerializeFormat(Reflect(wideTable), DataFormat::MessagePack, wideOutput)
+			&& static_cast<unsigned char>(wideOutput[0]) == 0xDF
+			&& DeserializeFormat(wideOutput, Reflect(wideRead))
+			&& wideRead == wideTable;
+		farb_print(success, "messagepack object with more than 65535 keys");
+		assert(success);
+
+		UI::Node root;
+		success = DeserializeFile("./tests/files/input/TestUITree.json", Reflect(root));
+		for (DataFormat format : formats)
+		{
+			std::string output;
+			UI::Node loaded;
+			bool formatSuccess = SerializeFormat(Reflect(root), format, output)
+				&& DetectDataFormat(output) == format
+				&& DeserializeFormat(output, Reflect(loaded))
+				&& ToString(loaded) == ToString(root)
+				&& loaded.children[0].text.cachedParsedText == root.children[0].text.cachedParsedText;
+			farb_print(formatSuccess, std::string("UI tree detected and loaded from ") + DataFormatName(format));
+			success = success && formatSuccess;
+		}
+		assert(success);
+
+		const std::string filePath = "./test_data_formats.mpk";
+		UI::Node fromFile;
+		success = SerializeFormatFile(Reflect(root), DataFormat::Unknown, filePath)
+			&& DeserializeFormatFile(filePath, Reflect(fromFile))
+			&& ToString(fromFile) == ToString(root);
+		std::remove(filePath.c_str());
+		farb_print(success, "format file by extension");
+		assert(success);
+
+		success = DataFormatFromExtension("a/b.json") == DataFormat::Json
+			&& DataFormatFromExtension("b.cbor") == DataFormat::Cbor
+			&& DataFormatFromExtension("b.msgpack") == DataFormat::MessagePack
+			&& DataFormatFromExtension("b.ubj") == DataFormat::Ubjson
+			&& DataFormatFromExtension("b.txt") == DataFormat::Unknown
+			&& DetectDataFormat(" {\"a\": 1}") == DataFormat::Json
+			&& DetectDataFormat("[[1]]") == DataFormat::Json
+			&& DetectDataFormat("{}") == DataFormat::Json
+			&& DetectDataFormat("[#U\x01U\x01") == DataFormat::Ubjson
+			&& DetectDataFormat("\xA1\x61" "a\x01") == DataFormat::Cbor
+			&& DetectDataFormat("\x81\xA1" "a\x01") == DataFormat::MessagePack
+			&& DetectDataFormat("") == DataFormat::Unknown
+			&& DetectDataFormat("\x01") == DataFormat::Unknown;
+		farb_print(success, "detect format by extension and first bytes");
+		assert(success);
+
+		std::vector<int> invalid;
+		success = !DeserializeFormat("\xC1", Reflect(invalid), DataFormat::MessagePack)
+			&& !DeserializeFormat("\x01", Reflect(invalid))
+			&& !DeserializeFormat("\x93\x01\x02", Reflect(invalid), DataFormat::MessagePack);
+		farb_print(success, "invalid and truncated binary input fails");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // TEST_DATA_FORMATS_HPP
@@ -0,0 +1,160 @@
+#ifndef TEST_DESERIALIZATION_PLAN_HPP
+#define TEST_DESERIALIZATION_PLAN_HPP
+
+#include <assert.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../RegisterTest.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionContainers.hpp"
+#include "../../src/reflection/ReflectionWrappers.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/Deserialization.h"
+#include "../../src/serialization/DeserializationPlan.h"
+#include "../reflection/TestReflectDefinitions.hpp"
+#include "TestConcurrentDeserialize.hpp"
+#include "TestLoadBatch.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Tests
+{
+
+class TestDeserializationPlan : public ITest
+{
+public:
+	virtual bool RunTests() const override
+	{
+		std::cout << "Deserialization Plan" << std::endl;
+
+		const DeserializationPlan& plan = CompilePlan<UI::Node>();
+		bool success = &plan == &CompilePlan(GetTypeInfo<UI::Node>())
+			&& plan.GetRootTypeInfo() == GetTypeInfo<UI::Node>()
+			&& plan.Root().kind == PlanKind::Struct
+			&& plan.Node(plan.Root().members[0].node) != nullptr;
+		// children refers back to the root, which must share its node
+		for (const auto & member : plan.Root().members)
+		{
+			if (member.name != HString("children")) continue;
+			const PlanNode* children = plan.Node(member.node);
+			success = success
+				&& children != nullptr
+				&& children->kind == PlanKind::Array
+				&& plan.Node(children->child) == &plan.Root();
+		}
+		farb_print(success, "compile plan once per root type");
+		assert(success);
+
+		UI::Node expected;
+		UI::Node root;
+		success = DeserializeFile("./tests/files/input/TestUITree.json", Reflect(expected))
+			&& DeserializeFile("./tests/files/input/TestUITree.json", Reflect(root), plan)
+			&& ToString(root) == ToString(expected)
+			&& root.children[0].text.cachedParsedText == expected.children[0].text.cachedParsedText;
+		farb_print(success, "plan loads UI tree with PostLoad like the dynamic path");
+		assert(success);
+
+		std::vector<ExampleDerivedStruct> reordered;
+		success = DeserializeString(
+			"[{\"e1\": \"Two\", \"i2\": 1, \"e3\": \"One\", \"i4\": 2},"
+			" {\"i4\": 4, \"i2\": 3},"
+			" {\"e3\": \"Two\", \"i2\": 5, \"e1\": \"One\"}]",
+			Reflect(reordered),
+			CompilePlan<std::vector<ExampleDerivedStruct> >());
+		success = success
+			&& reordered.size() == 3
+			&& reordered[0].e1 == ExampleEnum::Two && reordered[0].i2 == 1
+			&& reordered[0].e3 == ExampleEnum::One && reordered[0].i4 == 2
+			&& reordered[1].i2 == 3 && reordered[1].i4 == 4
+			&& reordered[2].e1 == ExampleEnum::One && reordered[2].i2 == 5
+			&& reordered[2].e3 == ExampleEnum::Two
+			&& !DeserializeString("[{\"i2\": 1}, {\"i2\": 2, \"i3\": 3}]",
+				Reflect(reordered), CompilePlan<std::vector<ExampleDerivedStruct> >());
+		farb_print(success, "plan finds struct keys in any order, including inherited members");
+		assert(success);
+
+		std::unordered_map<std::string, std::vector<float> > table;
+		std::vector<uint> uints;
+		success = DeserializeString("{\"a\": [1, 2.5], \"b\": []}", Reflect(table),
+				CompilePlan<std::unordered_map<std::string, std::vector<float> > >())
+			&& table.size() == 2 && table["a"] == std::vector<float>{1.0f, 2.5f} && table["b"].empty()
+			&& DeserializeString("[0, 4000000000]", Reflect(uints), CompilePlan<std::vector<uint> >())
+			&& uints == std::vector<uint>{0, 4000000000u}
+			&& !DeserializeString("[-1]", Reflect(uints), CompilePlan<std::vector<uint> >());
+		int number = 0;
+		bool flag = false;
+		success = success
+			&& DeserializeString("1", Reflect(flag), CompilePlan<bool>()) && flag
+			&& !DeserializeString("2", Reflect(flag), CompilePlan<bool>())
+			&& !DeserializeString("4000000000", Reflect(number), CompilePlan<int>())
+			&& !DeserializeString("\"one\"", Reflect(number), CompilePlan<int>())
+			&& !DeserializeString("1.5", Reflect(number), CompilePlan<int>());
+		farb_print(success, "plan converts leaves like their TypeInfo");
+		assert(success);
+
+		// sets, converted types and enums are left to their TypeInfo
+		ExamplePendingStruct pendingExpected = MakePendingExpected(3);
+		ExamplePendingStruct pending;
+		success = DeserializeString(MakePendingJson(pendingExpected), Reflect(pending),
+				CompilePlan<ExamplePendingStruct>())
+			&& pending == pendingExpected;
+		farb_print(success, "plan falls back to TypeInfo for pending values");
+		assert(success);
+
+		std::string deep;
+		for (int i = 0; i < 100; ++i) deep += "{\"name\": \"n\", \"children\": [";
+		for (int i = 0; i < 100; ++i) deep += "]}";
+		ExampleLoadedNode::postLoadOrder.clear();
+		ExampleLoadedNode loaded;
+		success = DeserializeString(deep, Reflect(loaded), CompilePlan<ExampleLoadedNode>())
+			&& ExampleLoadedNode::postLoadOrder.size() == 100;
+		ExampleLoadedNode unnamed;
+		success = success && !DeserializeString("{}", Reflect(unnamed), CompilePlan<ExampleLoadedNode>());
+		ExampleLoadedNode::postLoadOrder.clear();
+		ExampleLoadedNode::postLoadThreads.clear();
+		farb_print(success, "plan runs PostLoad hooks and their failures");
+		assert(success);
+
+		success = !DeserializeString("{}", Reflect(root), CompilePlan<ExampleLoadedNode>());
+		farb_print(success, "plan for another type fails");
+		assert(success);
+
+		ReflectionStats stats;
+		std::vector<ExampleBaseStruct> statsTest;
+		ExampleStaticStruct statsString;
+		{
+			ReflectionStats::Scope scope(stats);
+			success = DeserializeString(
+					"[{\"e1\": \"One\", \"i2\": 1}, {\"i2\": 2, \"e1\": \"Two\"}]",
+					Reflect(statsTest),
+					CompilePlan<std::vector<ExampleBaseStruct> >())
+				&& DeserializeString("{\"s3\": \"hello\"}", Reflect(statsString), CompilePlan<ExampleStaticStruct>());
+		}
+		if constexpr (ReflectionStats::Enabled)
+		{
+			const TypeStats& structStats = stats.For(GetTypeInfo<ExampleBaseStruct>());
+			success = success
+				&& structStats.keyCacheHits == 2
+				&& structStats.keyLookups == 2
+				&& stats.For(GetTypeInfo<std::string>()).stringBytes == 5;
+		}
+		else
+		{
+			success = success && stats.Types().empty();
+		}
+		farb_print(success, "plan records key lookups and string bytes like the dynamic path");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // TEST_DESERIALIZATION_PLAN_HPP
@@ -0,0 +1,130 @@
+#ifndef TEST_DESERIALIZATION_SESSION_HPP
+#define TEST_DESERIALIZATION_SESSION_HPP
+
+#include <assert.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../RegisterTest.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionWrappers.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/Deserialization.h"
+#include "../reflection/TestReflectDefinitions.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Tests
+{
+
+// feeds input chunkSize bytes at a time, so every token gets split somewhere
+template<typename T>
+bool DeserializeInChunks(std::string_view input, T& value, std::size_t chunkSize)
+{
+	DeserializationSession session(Reflect(value));
+	for (std::size_t i = 0; i < input.size(); i += chunkSize)
+	{
+		if (!session.Feed(input.substr(i, chunkSize))) return false;
+	}
+	return session.Finish();
+}
+
+// the session has to match sax_parse for every chunk size
+template<typename T>
+bool MatchesDeserializeString(const std::string& input)
+{
+	T expected;
+	if (!DeserializeString(input, Reflect(expected))) return false;
+	for (std::size_t chunkSize : {std::size_t(1), std::size_t(3), input.size()})
+	{
+		T value;
+		if (!DeserializeInChunks(input, value, chunkSize) || !(value == expected)) return false;
+	}
+	return true;
+}
+
+class TestDeserializationSession : public ITest
+{
+public:
+	virtual bool RunTests() const override
+	{
+		std::cout << "Deserialization Session" << std::endl;
+
+		bool success = MatchesDeserializeString<ExampleBaseStruct>("{\"e1\": \"Two\", \"i2\": -12}")
+			&& MatchesDeserializeString<std::vector<int> >(" [ 1,-2 ,30 ] ")
+			&& MatchesDeserializeString<std::vector<uint> >("[0, 4000000000]")
+			&& MatchesDeserializeString<std::vector<float> >("[1.5e2, -0.25, 3, 2E-3, 0.5]")
+			&& MatchesDeserializeString<bool>("true")
+			&& MatchesDeserializeString<bool>(" false ")
+			&& MatchesDeserializeString<std::vector<std::vector<int> > >("[[], [1], [2, 3]]");
+		farb_print(success, "session matches DeserializeString split anywhere");
+		assert(success);
+
+		success = MatchesDeserializeString<std::string>("\"tab\\t quote\\\" slash\\/ \\u00e9 \\ud83d\\ude00 \\\\\"")
+			&& MatchesDeserializeString<std::vector<std::string> >("[\"\", \"a\", \"\\u0041\\n\"]");
+		farb_print(success, "session unescapes strings split anywhere");
+		assert(success);
+
+		int topLevel = 0;
+		DeserializationSession numberSession(Reflect(topLevel));
+		success = numberSession.Feed("4") && numberSession.Feed("2") && topLevel == 0
+			&& numberSession.Finish() && topLevel == 42 && numberSession.BytesFed() == 2;
+		farb_print(success, "top level number ends at Finish");
+		assert(success);
+
+		std::ifstream inputFile("./tests/files/input/TestUITree.json", std::ios::binary);
+		std::string tree((std::istreambuf_iterator<char>(inputFile)), std::istreambuf_iterator<char>());
+		UI::Node expected;
+		success = DeserializeString(tree, Reflect(expected));
+		for (std::size_t chunkSize : {std::size_t(1), std::size_t(7), std::size_t(4096)})
+		{
+			UI::Node root;
+			success = success
+				&& DeserializeInChunks(tree, root, chunkSize)
+				&& ToString(root) == ToString(expected)
+				&& root.children[0].text.cachedParsedText == expected.children[0].text.cachedParsedText;
+		}
+		farb_print(success, "session loads UI tree with PostLoad in chunks");
+		assert(success);
+
+		std::vector<int> ints;
+		success = !DeserializeInChunks("[1, 2", ints, 2)
+			&& !DeserializeInChunks("[1, 2,]", ints, 2)
+			&& !DeserializeInChunks("[1 2]", ints, 2)
+			&& !DeserializeInChunks("[01]", ints, 2)
+			&& !DeserializeInChunks("[1] [2]", ints, 2)
+			&& !DeserializeInChunks("[tru]", ints, 2)
+			&& !DeserializeInChunks("[\"one\"]", ints, 2)
+			&& !DeserializeInChunks("", ints, 2);
+		farb_print(success, "session rejects invalid or incomplete input");
+		assert(success);
+
+		std::string text;
+		success = !DeserializeInChunks("\"\\x\"", text, 1)
+			&& !DeserializeInChunks("\"\\ud83d\"", text, 1)
+			&& !DeserializeInChunks("\"\\ude00\"", text, 1)
+			&& !DeserializeInChunks("\"a\nb\"", text, 1);
+		farb_print(success, "session rejects invalid strings");
+		assert(success);
+
+		ints.clear();
+		DeserializationSession failedSession(Reflect(ints));
+		success = !failedSession.Feed("[1, }") && failedSession.Failed()
+			&& !failedSession.Feed("]") && !failedSession.Finish();
+		farb_print(success, "session stays failed");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // TEST_DESERIALIZATION_SESSION_HPP
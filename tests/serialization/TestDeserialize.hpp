@@ -2,6 +2,13 @@
 #define TEST_DESERIALIZE_HPP
 
 #include <assert.h> 
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#endif
 
 #include "../RegisterTest.hpp"
 #include "../../src/reflection/ReflectionDeclare.h"
@@ -84,12 +91,136 @@ public:
 			{0, ExampleBaseStruct(ExampleEnum::One, 1)},
 			{1, ExampleBaseStruct(ExampleEnum::Two, 2)});
 
+		std::vector<float> floats;
+		bool success = DeserializeString("[1, -2, 2.5]", Reflect(floats))
+			&& floats == std::vector<float>{1.0f, -2.0f, 2.5f};
+		farb_print(success, "deserialize primitive array converts each value like assign");
+		assert(success);
+
+		std::vector<uint> uints;
+		success = !DeserializeString("[1, -2]", Reflect(uints));
+		farb_print(success, "deserialize primitive array rejects values assign rejects");
+		assert(success);
+
+		std::vector<std::vector<std::string> > nested;
+		success = DeserializeString("[[\"a\", \"b\"], [], [\"c\"]]", Reflect(nested))
+			&& nested.size() == 3
+			&& nested[0] == std::vector<std::string>{"a", "b"}
+			&& nested[1].empty()
+			&& nested[2] == std::vector<std::string>{"c"};
+		farb_print(success, "deserialize nested primitive arrays");
+		assert(success);
+
+		std::vector<int> mixed;
+		success = !DeserializeString("[1, {\"a\": 1}]", Reflect(mixed))
+			&& !DeserializeString("[1, [2]]", Reflect(mixed));
+		farb_print(success, "deserialize primitive array rejects objects and arrays");
+		assert(success);
+
 		ExampleBaseStruct testStructFromFile;
-		bool success = DeserializeFile("./tests/files/input/TestExampleBaseStruct.json", Reflect(testStructFromFile));
+		success = DeserializeFile("./tests/files/input/TestExampleBaseStruct.json", Reflect(testStructFromFile));
 		success = success && testStructFromFile == ExampleBaseStruct(ExampleEnum::One, 1);
 		farb_print(success, "deserialize from file value " + GetTypeInfo<ExampleBaseStruct>()->GetName());
 		assert(success);
 
+		success = !DeserializeFile("./tests/files/input/Missing.json", Reflect(testStructFromFile));
+		farb_print(success, "deserialize from missing file fails");
+		assert(success);
+
+		// mapped files have no terminator, the parser has to stop at the end of the range
+		const std::string filePath = "./test_deserialize_file.json";
+		std::vector<int> fromFile;
+		{
+			std::ofstream output(filePath, std::ios::binary);
+			output << "[1, 2, 30]";
+		}
+		success = DeserializeFile(filePath, Reflect(fromFile))
+			&& fromFile == std::vector<int>{1, 2, 30};
+		{
+			std::ofstream output(filePath, std::ios::binary);
+			output << "[1, 2, 3";
+		}
+		success = success && !DeserializeFile(filePath, Reflect(fromFile));
+		{
+			std::ofstream output(filePath, std::ios::binary);
+		}
+		success = success && !DeserializeFile(filePath, Reflect(fromFile));
+		std::remove(filePath.c_str());
+		farb_print(success, "deserialize from file stops at the end of the file");
+		assert(success);
+
+#if defined(__unix__) || defined(__APPLE__)
+		// a pipe can't be mapped and has no size up front, so it's read until the writer closes it
+		const std::string pipePath = "./test_deserialize_pipe";
+		std::remove(pipePath.c_str());
+		success = ::mkfifo(pipePath.c_str(), 0600) == 0;
+		if (success)
+		{
+			std::thread writer([&]()
+			{
+				std::ofstream output(pipePath, std::ios::binary);
+				output << "[4, 5, 6]";
+			});
+			fromFile.clear();
+			success = DeserializeFile(pipePath, Reflect(fromFile))
+				&& fromFile == std::vector<int>{4, 5, 6};
+			writer.join();
+			std::remove(pipePath.c_str());
+		}
+		farb_print(success, "deserialize from a pipe");
+		assert(success);
+#endif
+
+		// the parser caches the member each key resolved to, in the order keys arrived
+		std::vector<ExampleDerivedStruct> reordered;
+		success = DeserializeString(
+			"[{\"e1\": \"Two\", \"i2\": 1, \"e3\": \"One\", \"i4\": 2},"
+			" {\"i4\": 4, \"i2\": 3},"
+			" {\"e3\": \"Two\", \"i2\": 5, \"e1\": \"One\"}]",
+			Reflect(reordered));
+		success = success
+			&& reordered.size() == 3
+			&& reordered[0].e1 == ExampleEnum::Two && reordered[0].i2 == 1
+			&& reordered[0].e3 == ExampleEnum::One && reordered[0].i4 == 2
+			&& reordered[1].i2 == 3 && reordered[1].i4 == 4
+			&& reordered[2].e1 == ExampleEnum::One && reordered[2].i2 == 5
+			&& reordered[2].e3 == ExampleEnum::Two
+			&& !DeserializeString("[{\"i2\": 1}, {\"i2\": 2, \"i3\": 3}]", Reflect(reordered));
+		farb_print(success, "deserialize struct keys in any order, including inherited members");
+		assert(success);
+
+		std::size_t poolSize = HString::PoolSize();
+		success = !DeserializeString("[{\"i2\": 1, \"never a member of anything\": 2}]", Reflect(reordered))
+			&& HString::PoolSize() == poolSize;
+		farb_print(success, "unknown struct keys aren't interned");
+		assert(success);
+
+		ReflectionStats stats;
+		std::vector<ExampleBaseStruct> statsTest;
+		success = DeserializeString(
+			"[{\"e1\": \"One\", \"i2\": 1 }, {\"e1\": \"Two\", \"i2\": 2 }]",
+			Reflect(statsTest),
+			stats);
+		success = success && !DeserializeString("{\"missing\": 1}", Reflect(testStructFromFile), stats);
+		if constexpr (ReflectionStats::Enabled)
+		{
+			const TypeStats& structStats = stats.For(GetTypeInfo<ExampleBaseStruct>());
+			success = success
+				&& structStats.keyLookups == 3
+				&& structStats.keyCacheHits == 2
+				&& structStats.failedLookups == 1
+				&& structStats.contextPushes == 3
+				&& stats.For(GetTypeInfo<ExampleEnum>()).assigns == 2
+				&& stats.For(GetTypeInfo<ExampleEnum>()).stringBytes == 6
+				&& stats.Report().find("ExampleBaseStruct") != std::string::npos;
+		}
+		else
+		{
+			success = success && stats.Types().empty();
+		}
+		farb_print(success, "deserialize records stats per type when enabled");
+		assert(success);
+
 		return true;
 	}
 };
@@ -0,0 +1,116 @@
+#ifndef TEST_DESERIALIZE_ALLOCATIONS_HPP
+#define TEST_DESERIALIZE_ALLOCATIONS_HPP
+
+#include <assert.h>
+#include <string>
+#include <vector>
+
+#include "../RegisterTest.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionWrappers.hpp"
+#include "../../src/serialization/Deserialization.h"
+#include "../../src/utils/CountAllocations.hpp"
+#include "../reflection/TestReflectDefinitions.hpp"
+#include "TestLoadBatch.hpp"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Tests
+{
+
+inline std::string MakeStructArrayJson(int count)
+{
+	std::string json = "[";
+	for (int i = 0; i < count; ++i)
+	{
+		if (i != 0) json += ", ";
+		json += "{\"e1\": \"Two\", \"i2\": " + std::to_string(i) + "}";
+	}
+	return json + "]";
+}
+
+inline std::string MakeStringArrayJson(int count)
+{
+	std::string json = "[";
+	for (int i = 0; i < count; ++i)
+	{
+		if (i != 0) json += ", ";
+		json += "\"a string that is too long for the small string buffer\"";
+	}
+	return json + "]";
+}
+
+class TestDeserializeAllocations : public ITest
+{
+public:
+	virtual bool RunTests() const override
+	{
+		std::cout << "Deserialize Allocations" << std::endl;
+
+		// the difference between parsing 100 and 1100 values is the cost of 1000 values
+		// the vector growing and the lexer's buffer are the only allocations that should scale,
+		// and those only logarithmically
+		const std::string fewStructs = MakeStructArrayJson(100);
+		const std::string manyStructs = MakeStructArrayJson(1100);
+		std::vector<ExampleBaseStruct> structs;
+		// the first parse interns the keys and enum names and caches the type infos
+		bool success = DeserializeString(fewStructs, Reflect(structs));
+		std::size_t few = CountAllocations([&]()
+		{
+			std::vector<ExampleBaseStruct> loaded;
+			success &= DeserializeString(fewStructs, Reflect(loaded));
+		});
+		std::size_t many = CountAllocations([&]()
+		{
+			std::vector<ExampleBaseStruct> loaded;
+			success &= DeserializeString(manyStructs, Reflect(loaded));
+		});
+		success = success && many - few <= 8;
+		farb_print(success, "deserialize 1000 more structs allocates "
+			+ std::to_string(many - few) + " more times, not per value");
+		assert(success);
+
+		const std::string fewStrings = MakeStringArrayJson(100);
+		const std::string manyStrings = MakeStringArrayJson(1100);
+		few = CountAllocations([&]()
+		{
+			std::vector<std::string> loaded;
+			success &= DeserializeString(fewStrings, Reflect(loaded));
+		});
+		many = CountAllocations([&]()
+		{
+			std::vector<std::string> loaded;
+			success &= DeserializeString(manyStrings, Reflect(loaded));
+		});
+		// one allocation for each string's own buffer, none for copies of it
+		success = success && many - few >= 1000 && many - few <= 1008;
+		farb_print(success, "deserialize 1000 more long strings allocates "
+			+ std::to_string(many - few) + " more times, once per string");
+		assert(success);
+
+		// deeper than the stack keeps inline
+		std::string deep;
+		for (int i = 0; i < 100; ++i) deep += "{\"name\": \"n\", \"children\": [";
+		for (int i = 0; i < 100; ++i) deep += "]}";
+		ExampleLoadedNode::postLoadOrder.clear();
+		ExampleLoadedNode root;
+		success = DeserializeString(deep, Reflect(root));
+		int depth = 0;
+		for (ExampleLoadedNode* node = &root; !node->children.empty(); node = &node->children[0]) ++depth;
+		success = success && depth == 99 && ExampleLoadedNode::postLoadOrder.size() == 100;
+		ExampleLoadedNode::postLoadOrder.clear();
+		ExampleLoadedNode::postLoadThreads.clear();
+		farb_print(success, "deserialize nesting deeper than the inline stack");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // TEST_DESERIALIZE_ALLOCATIONS_HPP
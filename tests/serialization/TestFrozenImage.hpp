@@ -0,0 +1,219 @@
+#ifndef TEST_FROZEN_IMAGE_HPP
+#define TEST_FROZEN_IMAGE_HPP
+
+#include <assert.h> 
+#include <cstdio>
+
+#include "../RegisterTest.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/interface/TigrExtensions.h"
+#include "../../src/serialization/FrozenImage.h"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Tests
+{
+
+struct ExampleSpriteSheet
+{
+	std::string filePath;
+	std::vector<UI::Dimensions> sprites;
+	std::vector<std::vector<UI::Dimensions> > nineSlices;
+	std::vector<std::string> names;
+	int scale = 1;
+
+	static constexpr auto GetStaticMembers()
+	{
+		return std::make_tuple(
+			MakeStaticMember("filePath", &ExampleSpriteSheet::filePath),
+			MakeStaticMember("sprites", &ExampleSpriteSheet::sprites),
+			MakeStaticMember("nineSlices", &ExampleSpriteSheet::nineSlices),
+			MakeStaticMember("names", &ExampleSpriteSheet::names),
+			MakeStaticMember("scale", &ExampleSpriteSheet::scale));
+	}
+};
+
+struct FrozenSpriteSheet
+{
+	FrozenString filePath;
+	FrozenVector<UI::Dimensions> sprites;
+	FrozenVector<FrozenVector<UI::Dimensions> > nineSlices;
+	FrozenVector<FrozenString> names;
+	int scale;
+
+	static constexpr auto GetStaticMembers()
+	{
+		return std::make_tuple(
+			MakeStaticMember("filePath", &FrozenSpriteSheet::filePath),
+			MakeStaticMember("sprites", &FrozenSpriteSheet::sprites),
+			MakeStaticMember("nineSlices", &FrozenSpriteSheet::nineSlices),
+			MakeStaticMember("names", &FrozenSpriteSheet::names),
+			MakeStaticMember("scale", &FrozenSpriteSheet::scale));
+	}
+};
+
+// the same layout as FrozenSpriteSheet but with a renamed member
+struct FrozenSpriteSheetRenamed
+{
+	FrozenString path;
+	FrozenVector<UI::Dimensions> sprites;
+	FrozenVector<FrozenVector<UI::Dimensions> > nineSlices;
+	FrozenVector<FrozenString> names;
+	int scale;
+
+	static constexpr auto GetStaticMembers()
+	{
+		return std::make_tuple(
+			MakeStaticMember("path", &FrozenSpriteSheetRenamed::path),
+			MakeStaticMember("sprites", &FrozenSpriteSheetRenamed::sprites),
+			MakeStaticMember("nineSlices", &FrozenSpriteSheetRenamed::nineSlices),
+			MakeStaticMember("names", &FrozenSpriteSheetRenamed::names),
+			MakeStaticMember("scale", &FrozenSpriteSheetRenamed::scale));
+	}
+};
+
+inline bool SameDimensions(const UI::Dimensions& a, const UI::Dimensions& b)
+{
+	return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+inline bool MatchesSource(const FrozenSpriteSheet& frozen, const ExampleSpriteSheet& source)
+{
+	if (frozen.filePath.View() != source.filePath
+		|| frozen.scale != source.scale
+		|| frozen.sprites.size() != source.sprites.size()
+		|| frozen.nineSlices.size() != source.nineSlices.size()
+		|| frozen.names.size() != source.names.size())
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < source.sprites.size(); ++i)
+	{
+		if (!SameDimensions(frozen.sprites[i], source.sprites[i])) return false;
+	}
+	for (std::size_t i = 0; i < source.nineSlices.size(); ++i)
+	{
+		if (frozen.nineSlices[i].size() != source.nineSlices[i].size()) return false;
+		for (std::size_t j = 0; j < source.nineSlices[i].size(); ++j)
+		{
+			if (!SameDimensions(frozen.nineSlices[i][j], source.nineSlices[i][j])) return false;
+		}
+	}
+	for (std::size_t i = 0; i < source.names.size(); ++i)
+	{
+		if (frozen.names[i].View() != source.names[i]) return false;
+		if (frozen.names[i].c_str()[source.names[i].size()] != '\0') return false;
+	}
+	return true;
+}
+
+class TestFrozenImage : public ITest
+{
+public:
+	virtual bool RunTests() const override
+	{
+		std::cout << "Frozen Image" << std::endl;
+
+		ExampleSpriteSheet source;
+		source.filePath = "./assets/sprites.png";
+		source.scale = 3;
+		for (int i = 0; i < 100; ++i)
+		{
+			source.sprites.emplace_back(i, i * 2, 16, 16);
+		}
+		source.nineSlices.resize(3);
+		for (int i = 0; i < 9; ++i)
+		{
+			source.nineSlices[0].emplace_back(i, 0, 4, 4);
+			source.nineSlices[2].emplace_back(0, i, 8, 8);
+		}
+		source.names = { "grass", "", "a longer name than the small string buffer" };
+
+		std::string image;
+		FreezeImage<FrozenSpriteSheet>(source, image);
+
+		FrozenImage<FrozenSpriteSheet> opened;
+		bool success = opened.Open(image) && MatchesSource(opened.Root(), source);
+		farb_print(success, "frozen image opened from a buffer, " + std::to_string(image.size()) + " bytes");
+		assert(success);
+
+		// relocatable, a copy anywhere else in memory reads the same
+		std::string moved = image;
+		success = opened.Open(moved) && MatchesSource(opened.Root(), source)
+			&& opened->sprites.data() > reinterpret_cast<const UI::Dimensions*>(moved.data())
+			&& opened->sprites.data() < reinterpret_cast<const UI::Dimensions*>(moved.data() + moved.size());
+		farb_print(success, "frozen image is relocatable");
+		assert(success);
+
+		ExampleSpriteSheet empty;
+		std::string emptyImage;
+		FreezeImage<FrozenSpriteSheet>(empty, emptyImage);
+		success = opened.Open(emptyImage) && MatchesSource(opened.Root(), empty)
+			&& opened->filePath.c_str()[0] == '\0';
+		farb_print(success, "empty frozen image");
+		assert(success);
+
+		const std::string filePath = "./test_sprites.frzn";
+		success = FreezeImageFile<FrozenSpriteSheet>(source, filePath);
+		{
+			FrozenImage<FrozenSpriteSheet> mapped;
+			success = success && mapped.OpenFile(filePath) && MatchesSource(mapped.Root(), source);
+		}
+		std::remove(filePath.c_str());
+		farb_print(success, "frozen image mapped from a file");
+		assert(success);
+
+		success = GetFrozenLayoutHash<FrozenSpriteSheet>() != GetFrozenLayoutHash<FrozenSpriteSheetRenamed>();
+		FrozenImage<FrozenSpriteSheetRenamed> renamed;
+		success = success && !renamed.Open(image) && !renamed.IsOpen();
+		farb_print(success, "frozen image rejects a different layout");
+		assert(success);
+
+		success = !opened.Open(std::string_view(image.data(), image.size() - 16)) && !opened.IsOpen();
+		farb_print(success, "frozen image rejects a truncated image");
+		assert(success);
+
+		// point the sprites somewhere past the end of the image
+		std::string corrupt = image;
+		std::size_t rootOffset = ReadFrozenImageHeader(
+			image, GetFrozenLayoutHash<FrozenSpriteSheet>(), sizeof(FrozenSpriteSheet), alignof(FrozenSpriteSheet));
+		std::size_t spritesOffset = rootOffset + MemberOffset(&FrozenSpriteSheet::sprites);
+		std::int64_t outside = static_cast<std::int64_t>(image.size());
+		std::memcpy(&corrupt[spritesOffset], &outside, sizeof(outside));
+		success = !opened.Open(corrupt);
+		farb_print(success, "frozen image rejects an offset outside the image");
+		assert(success);
+
+		// point the names back at the root, which could otherwise loop forever
+		corrupt = image;
+		std::size_t namesOffset = rootOffset + MemberOffset(&FrozenSpriteSheet::names);
+		std::int64_t backwards = -static_cast<std::int64_t>(namesOffset - rootOffset);
+		std::memcpy(&corrupt[namesOffset], &backwards, sizeof(backwards));
+		success = !opened.Open(corrupt);
+		farb_print(success, "frozen image rejects an offset pointing backwards");
+		assert(success);
+
+		// point the last nine slice at the first one's elements, forward but shared
+		corrupt = image;
+		success = opened.Open(image);
+		const FrozenVector<UI::Dimensions>& firstSlice = opened.Root().nineSlices[0];
+		const FrozenVector<UI::Dimensions>& lastSlice = opened.Root().nineSlices[2];
+		std::size_t lastSliceOffset = reinterpret_cast<const char*>(&lastSlice) - image.data();
+		std::int64_t aliased = reinterpret_cast<const char*>(firstSlice.data())
+			- reinterpret_cast<const char*>(&lastSlice);
+		std::memcpy(&corrupt[lastSliceOffset], &aliased, sizeof(aliased));
+		success = success && aliased > 0 && !opened.Open(corrupt);
+		farb_print(success, "frozen image rejects ranges that overlap");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // TEST_FROZEN_IMAGE_HPP
@@ -0,0 +1,177 @@
+#ifndef TEST_LOAD_BATCH_HPP
+#define TEST_LOAD_BATCH_HPP
+
+#include <assert.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../RegisterTest.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionStatic.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/Deserialization.h"
+#include "../../src/serialization/LoadBatch.h"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Tests
+{
+
+// records which thread ran PostLoad for each node, and in what order
+struct ExampleLoadedNode
+{
+	std::string name;
+	std::vector<ExampleLoadedNode> children;
+
+	static inline std::vector<std::string> postLoadOrder;
+	static inline std::vector<std::thread::id> postLoadThreads;
+
+	static constexpr auto GetStaticMembers()
+	{
+		return std::make_tuple(
+			MakeStaticMember("name", &ExampleLoadedNode::name),
+			MakeStaticMember("children", &ExampleLoadedNode::children));
+	}
+
+	static TypeInfo* GetStaticTypeInfo()
+	{
+		static auto typeInfo = MakeStaticTypeInfoStruct<ExampleLoadedNode>("ExampleLoadedNode");
+		return &typeInfo;
+	}
+
+	static bool PostLoad(ExampleLoadedNode& node)
+	{
+		postLoadOrder.push_back(node.name);
+		postLoadThreads.push_back(std::this_thread::get_id());
+		return !node.name.empty();
+	}
+};
+
+// the fixed array keeps its element count in the DeserializationContext while it's parsed
+struct ExampleLoadedPair
+{
+	ExampleLoadedNode pair[2];
+
+	static constexpr auto GetStaticMembers()
+	{
+		return std::make_tuple(
+			MakeStaticMember("pair", &ExampleLoadedPair::pair));
+	}
+
+	static TypeInfo* GetStaticTypeInfo()
+	{
+		static auto typeInfo = MakeStaticTypeInfoStruct<ExampleLoadedPair>("ExampleLoadedPair");
+		return &typeInfo;
+	}
+};
+
+class TestLoadBatch : public ITest
+{
+public:
+	virtual bool RunTests() const override
+	{
+		std::cout << "Load Batch" << std::endl;
+
+		std::vector<ExampleLoadedNode> trees(3);
+		std::vector<UI::Node> nodes(2);
+		std::vector<LoadJob> jobs;
+		for (auto & tree : trees)
+		{
+			jobs.push_back(LoadJob{"./tests/files/input/TestLoadBatchTree.json", Reflect(tree)});
+		}
+		for (auto & node : nodes)
+		{
+			jobs.push_back(LoadJob{"./tests/files/input/TestUITree.json", Reflect(node)});
+		}
+		ExampleLoadedNode missing;
+		jobs.push_back(LoadJob{"./tests/files/input/Missing.json", Reflect(missing)});
+
+		std::vector<LoadResult> results;
+		bool success = !LoadBatch(jobs, results, 4)
+			&& results.size() == jobs.size()
+			&& !results.back().success
+			&& !results.back().error.empty();
+		for (std::size_t i = 0; i + 1 < results.size(); ++i)
+		{
+			success = success && results[i].success && results[i].error.empty();
+		}
+		farb_print(success, "load batch reports a result per file");
+		assert(success);
+
+		std::vector<std::string> expectedOrder;
+		for (int i = 0; i < 3; ++i)
+		{
+			expectedOrder.insert(expectedOrder.end(), {"a0", "a1", "a", "b", "root"});
+		}
+		success = ExampleLoadedNode::postLoadOrder == expectedOrder
+			&& trees[2].children[0].children[1].name == "a1";
+		for (const auto & id : ExampleLoadedNode::postLoadThreads)
+		{
+			success = success && id == std::this_thread::get_id();
+		}
+		farb_print(success, "load batch runs PostLoad on the calling thread in file order");
+		assert(success);
+
+		UI::Node serial;
+		success = DeserializeFile("./tests/files/input/TestUITree.json", Reflect(serial));
+		for (const auto & node : nodes)
+		{
+			success = success
+				&& ToString(node) == ToString(serial)
+				&& node.spec == serial.spec
+				&& node.children[0].spec == serial.children[0].spec
+				&& node.children[0].text.cachedParsedText == serial.children[0].text.cachedParsedText;
+		}
+		farb_print(success, "load batch matches loading each file serially");
+		assert(success);
+
+		success = LoadReport(results).find("Missing.json") != std::string::npos;
+		farb_print(success, "load batch report lists every file");
+		assert(success);
+
+		// the calling thread parses jobs too, so the hooks have to be queued rather than run
+		ExampleLoadedNode::postLoadOrder.clear();
+		ExampleLoadedPair queued;
+		PostLoadQueue queue;
+		success = DeserializeString("{\"pair\": [{\"name\": \"x\"}, {\"name\": \"y\"}]}", Reflect(queued), queue)
+			&& ExampleLoadedNode::postLoadOrder.empty()
+			&& !queue.Run(Reflect(queued)).IsError()
+			&& ExampleLoadedNode::postLoadOrder == std::vector<std::string>{"x", "y"};
+		farb_print(success, "PostLoad of fixed array elements is queued");
+		assert(success);
+
+		ExampleLoadedNode::postLoadOrder.clear();
+		ExampleLoadedNode::postLoadThreads.clear();
+		std::vector<ExampleLoadedPair> pairs(2);
+		jobs.clear();
+		for (auto & pair : pairs)
+		{
+			jobs.push_back(LoadJob{"./tests/files/input/TestLoadBatchPair.json", Reflect(pair)});
+		}
+		success = LoadBatch(jobs, results, 2)
+			&& pairs[1].pair[1].children[0].name == "second child";
+		expectedOrder.clear();
+		for (int i = 0; i < 2; ++i)
+		{
+			expectedOrder.insert(expectedOrder.end(), {"first", "second child", "second"});
+		}
+		success = success && ExampleLoadedNode::postLoadOrder == expectedOrder;
+		for (const auto & id : ExampleLoadedNode::postLoadThreads)
+		{
+			success = success && id == std::this_thread::get_id();
+		}
+		farb_print(success, "load batch runs PostLoad of fixed array elements on the calling thread");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // TEST_LOAD_BATCH_HPP
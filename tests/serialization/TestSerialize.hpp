@@ -0,0 +1,152 @@
+#ifndef TEST_SERIALIZE_HPP
+#define TEST_SERIALIZE_HPP
+
+#include <assert.h> 
+#include <sstream>
+
+#include "../RegisterTest.hpp"
+#include "../../src/reflection/ReflectionDeclare.h"
+#include "../../src/reflection/ReflectionWrappers.hpp"
+#include "../../src/reflection/ReflectionStatic.hpp"
+#include "../reflection/TestReflectDefinitions.hpp"
+#include "../../src/interface/UINode.h"
+#include "../../src/serialization/Deserialization.h"
+#include "../../src/serialization/Serialization.h"
+
+namespace Farb
+{
+using namespace Reflection;
+
+namespace Tests
+{
+
+template<typename T>
+void TestSerializeValue(const T& value, std::string expected)
+{
+	T test = value;
+	std::string output;
+	bool success = SerializeString(Reflect(test), output);
+	farb_print(success && output == expected,
+		"serialize value " + GetTypeInfo<T>()->GetName() + " " + output);
+	assert(success && output == expected);
+}
+
+// serializes, deserializes into a default value, and serializes again
+template<typename T>
+void TestSerializeRoundTrip(const T& value, JsonWriter::Mode mode)
+{
+	T test = value;
+	std::string output;
+	bool success = SerializeString(Reflect(test), output, mode);
+	T roundTrip{};
+	success = success && DeserializeString(output, Reflect(roundTrip));
+	std::string roundTripOutput;
+	success = success && SerializeString(Reflect(roundTrip), roundTripOutput, mode);
+	success = success && output == roundTripOutput;
+	farb_print(success, std::string("serialize round trip ")
+		+ (mode == JsonWriter::Mode::Pretty ? "pretty " : "compact ")
+		+ GetTypeInfo<T>()->GetName());
+	assert(success);
+}
+
+class TestSerialize : public ITest
+{
+public:
+	virtual bool RunTests() const override
+	{
+		std::cout << "Serialize" << std::endl;
+
+		TestSerializeValue<bool>(true, "true");
+		TestSerializeValue<uint>(1, "1");
+		TestSerializeValue<int>(-1, "-1");
+		TestSerializeValue<float>(10.5, "10.5");
+		TestSerializeValue<std::string>("A\"B\\C\n", "\"A\\\"B\\\\C\\n\"");
+		TestSerializeValue<ExampleEnum>(ExampleEnum::NegativeTwo, "\"NegativeTwo\"");
+		TestSerializeValue<ExampleNamedTypeInt>(ExampleNamedTypeInt(3), "3");
+		TestSerializeValue<ExampleBaseStruct>(
+			ExampleBaseStruct(ExampleEnum::One, 1),
+			"{\"e1\":\"One\",\"i2\":1}");
+		ExampleDerivedStruct derived;
+		derived.e3 = ExampleEnum::Zero;
+		derived.i4 = 4;
+		TestSerializeValue<ExampleDerivedStruct>(
+			derived,
+			"{\"e1\":\"One\",\"i2\":2,\"e3\":\"Zero\",\"i4\":4}");
+		TestSerializeValue<std::vector<int> >({0, 1, 2}, "[0,1,2]");
+		TestSerializeValue<std::vector<int> >({}, "[]");
+		TestSerializeValue<std::unordered_set<int> >({7}, "[7]");
+		TestSerializeValue<std::unordered_map<std::string, int> >({{"One", 1}}, "{\"One\":1}");
+
+		for (auto mode : {JsonWriter::Mode::Compact, JsonWriter::Mode::Pretty})
+		{
+			TestSerializeRoundTrip<std::string>("tab\tquote\"control\x01", mode);
+			TestSerializeRoundTrip<float>(0.1f, mode);
+			TestSerializeRoundTrip<ExampleDerivedStruct>(derived, mode);
+			TestSerializeRoundTrip<std::vector<ExampleBaseStruct> >(
+				{ExampleBaseStruct(ExampleEnum::One, 1), ExampleBaseStruct(ExampleEnum::Two, 2)},
+				mode);
+		}
+
+		// iteration order isn't preserved, so compare the tables rather than the output
+		std::unordered_map<std::string, int> table{{"Zero", 0}, {"One", 1}, {"Two", 2}};
+		std::string tableOutput;
+		std::unordered_map<std::string, int> tableRoundTrip;
+		bool success = SerializeString(Reflect(table), tableOutput)
+			&& DeserializeString(tableOutput, Reflect(tableRoundTrip))
+			&& table == tableRoundTrip;
+		farb_print(success, "serialize round trip " + GetTypeInfo<decltype(table)>()->GetName());
+		assert(success);
+
+		ExampleBaseStruct example(ExampleEnum::Two, 2);
+		std::string pretty;
+		success = SerializeString(Reflect(example), pretty, JsonWriter::Mode::Pretty);
+		success = success && pretty == "{\n\t\"e1\": \"Two\",\n\t\"i2\": 2\n}";
+		farb_print(success, "serialize pretty");
+		assert(success);
+
+		// the buffer is appended to, not cleared, so it can be reused
+		std::string buffer;
+		buffer.reserve(64);
+		const char* bufferData = buffer.data();
+		success = SerializeString(Reflect(example), buffer)
+			&& SerializeString(Reflect(example), buffer)
+			&& buffer == "{\"e1\":\"Two\",\"i2\":2}{\"e1\":\"Two\",\"i2\":2}";
+		buffer.clear();
+		success = success && SerializeString(Reflect(example), buffer)
+			&& buffer.data() == bufferData;
+		farb_print(success, "serialize into reused buffer");
+		assert(success);
+
+		std::ostringstream stream;
+		success = SerializeStream(Reflect(example), stream)
+			&& stream.str() == "{\"e1\":\"Two\",\"i2\":2}";
+		farb_print(success, "serialize to stream");
+		assert(success);
+
+		UI::Node root;
+		success = DeserializeFile("./tests/files/input/TestUITree.json", Reflect(root));
+		std::string uiOutput;
+		success = success && SerializeString(Reflect(root), uiOutput);
+		UI::Node roundTrip;
+		success = success && DeserializeString(uiOutput, Reflect(roundTrip));
+		std::string roundTripOutput;
+		success = success && SerializeString(Reflect(roundTrip), roundTripOutput);
+		success = success && uiOutput == roundTripOutput;
+		farb_print(success, "serialize round trip UI Tree");
+		assert(success);
+
+		std::string staticOutput;
+		JsonWriter writer(staticOutput);
+		success = !SerializeStatic(root, writer).IsError() && staticOutput == uiOutput;
+		farb_print(success, "serialize static matches dynamic");
+		assert(success);
+
+		return true;
+	}
+};
+
+} // namespace Tests
+
+} // namespace Farb
+
+#endif // TEST_SERIALIZE_HPP
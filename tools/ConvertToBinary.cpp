@@ -0,0 +1,69 @@
+#include <iostream>
+#include <string>
+
+#include "../src/interface/UINode.h"
+#include "../src/reflection/ReflectionBasics.h"
+#include "../src/serialization/BinarySerialization.h"
+#include "../src/serialization/Deserialization.h"
+
+// converts an existing json asset to the binary format
+// usage: converttobinary <type> <input.json> <output>
+
+using namespace Farb;
+using namespace Reflection;
+
+namespace
+{
+
+template<typename T>
+bool Convert(const std::string& inputPath, const std::string& outputPath)
+{
+	T value;
+	if (!DeserializeFile(inputPath, Reflect(value)))
+	{
+		std::cerr << "Couldn't load " << inputPath << std::endl;
+		return false;
+	}
+	if (!SerializeBinaryFile(Reflect(value), outputPath))
+	{
+		std::cerr << "Couldn't write " << outputPath << std::endl;
+		return false;
+	}
+	return true;
+}
+
+struct Converter
+{
+	const char* typeName;
+	bool (*pConvert)(const std::string&, const std::string&);
+};
+
+// rmf note: add a line here for each root asset type
+const Converter converters[] = {
+	{ "UI::Node", Convert<UI::Node> },
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	if (argc != 4)
+	{
+		std::cerr << "usage: converttobinary <type> <input.json> <output>" << std::endl;
+		return 1;
+	}
+	std::string typeName = argv[1];
+	for (const Converter& converter : converters)
+	{
+		if (typeName == converter.typeName)
+		{
+			return converter.pConvert(argv[2], argv[3]) ? 0 : 1;
+		}
+	}
+	std::cerr << "Unknown type " << typeName << ", known types are:" << std::endl;
+	for (const Converter& converter : converters)
+	{
+		std::cerr << "    " << converter.typeName << std::endl;
+	}
+	return 1;
+}